@@ -6,7 +6,7 @@
  * Fő komponensek:
  * - AM/MW/LW/SW frekvencia hangolás és megjelenítés
  * - S-Meter (jelerősség) valós idejű frissítés
- * - Közös függőleges gombsor (8 funkcionális gomb) - FMScreen-nel megegyező
+ * - Közös függőleges gombsor (9 funkcionális gomb) - FMScreen-nel megegyező
  * - Vízszintes gombsor (3 navigációs gomb) - FM gombbal
  * - Event-driven architektúra (nincs folyamatos polling)
  *
@@ -17,9 +17,14 @@
 #ifndef __AM_SCREEN_H
 #define __AM_SCREEN_H
 #include "CommonVerticalButtons.h"
+#include "CwDecoder.h"
+#include "DecodedTextBox.h"
+#include "MiniAudioFft.h"
+#include "RttyDecoder.h"
 #include "RadioScreen.h"
 #include "UIButton.h"
 #include "UIHorizontalButtonBar.h"
+#include "ZeroBeatDetector.h"
 
 /**
  * @class AMScreen
@@ -34,7 +39,7 @@
  * **UI komponensek:**
  * - Frekvencia kijelző (közép)
  * - S-Meter jelerősség mérő (alul)
- * - 8 funkcionális gomb (jobb oldal) - Közös FMScreen-nel
+ * - 9 funkcionális gomb (jobb oldal) - Közös FMScreen-nel
  * - 3 navigációs gomb (alsó sor) - FM gombot tartalmaz
  *
  * **Támogatott band-ek:**
@@ -222,6 +227,76 @@ class AMScreen : public RadioScreen, public CommonVerticalButtons::Mixin<AMScree
      * @details AM specifikus funkcionalitás
      */
     void handleStepButton(const UIButton::ButtonEvent &event);
+
+    // ===================================================================
+    // Szöveg dekóderek (CW, RTTY)
+    // ===================================================================
+
+    /**
+     * @brief A core1-en futó szöveg dekóder
+     */
+    enum class TextDecoder : uint8_t { None, Cw, Rtty };
+
+    /**
+     * @brief Dekóder váltás a demodulációs mód szerint, a dekódolt szöveg és az állapot átvétele
+     */
+    void updateTextDecoder();
+
+    /**
+     * @brief Az aktuális módhoz tartozó dekóder (CW: CW, LSB/USB: RTTY, ha be van kapcsolva)
+     */
+    TextDecoder selectTextDecoder();
+
+    void switchTextDecoder(TextDecoder decoder);
+
+    void updateTextDecoderStatus();
+
+    /**
+     * @brief Szöveg doboz érintés: SSB módban az RTTY sebesség léptetése (ki -> 45.45 -> 50 -> 75 -> ki)
+     */
+    void handleTextBoxClick();
+
+    // ===================================================================
+    // Zero-beat jelző (SSB/CW)
+    // ===================================================================
+
+    /**
+     * @brief SSB/CW módban a domináns hang mérése és az eltérés kijelzése a frekvencia kijelzőn
+     * @details A detektor csak SSB/CW módban létezik (a pufferei ~11 kB-ot foglalnak).
+     */
+    void updateZeroBeat();
+
+    /**
+     * @brief A mért eltérés korrekciója a kézi BFO eltolásban (a zero-beat jelző érintésére)
+     */
+    void applyZeroBeatCorrection();
+
+    /**
+     * @brief A BFO beállítása a chipen (CW alap eltolás + finomhangolás + kézi BFO)
+     */
+    void applySsbBfo();
+
+    // ===================================================================
+    // UI komponens objektumok
+    // ===================================================================
+
+    /**
+     * @brief Mini audio spektrum / oszcilloszkóp komponens
+     */
+    std::shared_ptr<MiniAudioFft> miniAudioFft;
+    std::shared_ptr<DecodedTextBox> decodedTextBox; // Csak SSB/CW módban van a gyerekek között
+
+    // A dekóderek a core1-en futnak, az AudioCapture blokk feldolgozójaként
+    CwDecoder cwDecoder;
+    RttyDecoder rttyDecoder;
+    TextDecoder activeDecoder = TextDecoder::None;
+    bool textBoxShown = false;
+    bool textDecoderStatusDirty = true;
+    uint8_t lastCwWpm = 0;
+    bool lastRttySignal = false;
+
+    std::unique_ptr<ZeroBeatDetector> zeroBeat; // Csak SSB/CW módban van
+    bool zeroBeatUnavailable = false;           // Sikertelen létrehozás után nem próbáljuk újra, amíg SSB/CW módban vagyunk
 };
 
 #endif // __AM_SCREEN_H
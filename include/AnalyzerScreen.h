@@ -0,0 +1,150 @@
+/**
+ * @file AnalyzerScreen.h
+ * @brief Teljes képernyős audio analizátor: nagy felbontású spektrum csúcstartással és audio waterfall
+ * @details A mintákat saját AudioCapture blokk fogyasztóként veszi (másolás nélkül, a pool blokkjaiból).
+ * Az FFT méret a Config_t::audioFftSize, az erősítés a Config_t::miniAudioFftConfigAnalyzer
+ * (0.0f: auto - a blokkokkal érkező AudioAgc erősítés, >0.0f: kézi szorzó). A képkockák rögzített
+ * ütemben (FRAME_INTERVAL_MS) készülnek, a késést nem halmozva.
+ *
+ * Előfeldolgozás (AudioDspStages): a szűk sávokhoz a mintavételezés gyorsabb, és egy polifázisú decimátor
+ * ritkít a megjelenített sáv kétszeresére (alias mentesen); az FFT keretek 50%-ban átlapoltak (új spektrum
+ * és waterfall sor csak akkor készül, ha a keret legalább fele új), az ablak Hann vagy Blackman-Harris.
+ *
+ * Rajzolás:
+ * - Spektrum: 8 bites sprite, képkockánként egyszer kitolva (dB skála, csúcstartó vonallal)
+ * - Waterfall: gördülő sor pozíció (mint a ScanScreen waterfall-ja), képkockánként csak az új sor kerül ki
+ *   egy egysoros 16 bites sprite-ból; a legújabb sort a bal oldali jelölő mutatja
+ */
+
+#ifndef __ANALYZER_SCREEN_H
+#define __ANALYZER_SCREEN_H
+
+#include "AudioDspStages.h"
+#include "AudioFft.h"
+#include "UIButton.h"
+#include "UIScreen.h"
+
+/**
+ * @brief Audio analizátor képernyő
+ */
+class AnalyzerScreen : public UIScreen {
+  public:
+    /**
+     * @brief Konstruktor
+     * @param tft TFT display referencia
+     * @param si4735Manager Si4735Manager (az alapértelmezett sávszélességhez: FM vagy AM audio)
+     */
+    AnalyzerScreen(TFT_eSPI &tft, Si4735Manager *si4735Manager);
+
+    /**
+     * @brief Destruktor - a mintavételezés leállítása, a sprite-ok és pufferek felszabadítása
+     */
+    virtual ~AnalyzerScreen();
+
+    // UIScreen interface implementáció
+    virtual void drawContent() override;
+    virtual void handleOwnLoop() override;
+    virtual bool handleRotary(const RotaryEvent &event) override;
+
+  private:
+    // Button IDs
+    static constexpr uint8_t BACK_BUTTON_ID = 40;
+    static constexpr uint8_t SIZE_BUTTON_ID = 41;
+    static constexpr uint8_t SPAN_BUTTON_ID = 42;
+    static constexpr uint8_t HOLD_BUTTON_ID = 43;
+    static constexpr uint8_t WINDOW_BUTTON_ID = 44;
+
+    // Screen layout constants (480x320 display)
+    static constexpr uint16_t AREA_X = 10;               // Spektrum és waterfall X pozíciója
+    static constexpr uint16_t AREA_WIDTH = 460;          // Spektrum és waterfall szélessége
+    static constexpr uint16_t SPECTRUM_Y = 26;           // Spektrum Y pozíciója
+    static constexpr uint16_t SPECTRUM_HEIGHT = 100;     // Spektrum magassága
+    static constexpr uint16_t SCALE_Y = 128;             // Frekvencia címkék Y pozíciója
+    static constexpr uint16_t WATERFALL_Y = 140;         // Waterfall Y pozíciója
+    static constexpr uint16_t WATERFALL_HEIGHT = 132;    // Waterfall magassága (sorok száma)
+    static constexpr uint16_t INFO_Y = 8;                // Információs sor Y pozíciója
+    static constexpr uint8_t WATERFALL_MARKER_WIDTH = 4; // A legújabb sor jelölője a waterfall bal oldalán
+
+    // Feldolgozás
+    static constexpr uint32_t FRAME_INTERVAL_MS = 50; // Képkocka időköz (20 fps)
+    static constexpr uint16_t MAX_FFT_SIZE = 2048;    // Legnagyobb választható FFT méret (egyben a mintapuffer mérete)
+    static constexpr uint8_t DISPLAY_RANGE_DB = 60;   // A spektrum és a waterfall dinamika tartománya
+    static constexpr uint8_t PEAK_HOLD_DECAY = 1;     // Csúcstartás lecsengése képkockánként (pixel)
+    static constexpr float MANUAL_GAIN_STEP = 0.5f;   // Kézi erősítés lépés (rotary)
+    static constexpr float MANUAL_GAIN_MAX = 20.0f;   // Legnagyobb kézi erősítés
+    static constexpr uint8_t WATERFALL_COLORS = 64;   // Waterfall paletta mérete
+
+    /**
+     * @brief Választható megjelenített sávszélességek
+     */
+    struct SpanOption {
+        uint16_t maxFrequencyHz; // A megjelenített legnagyobb hangfrekvencia (a decimált mintavételi frekvencia ennek kétszerese)
+        uint16_t labelStepHz;    // A frekvencia címkék távolsága
+        uint8_t decimation;      // A mintavételezés ennyiszer gyorsabb, a decimátor ennyivel ritkít (1, 2, 4, 8)
+    };
+    static const SpanOption SPAN_OPTIONS[];
+    static const uint8_t SPAN_OPTION_COUNT;
+
+    std::shared_ptr<UIButton> backButton;
+    std::shared_ptr<UIButton> sizeButton;
+    std::shared_ptr<UIButton> spanButton;
+    std::shared_ptr<UIButton> holdButton;
+    std::shared_ptr<UIButton> windowButton;
+
+    // Rajzolás
+    TFT_eSprite *spectrumSprite;  // A teljes spektrum terület (8 bit)
+    TFT_eSprite *waterfallSprite; // Egy waterfall sor (16 bit)
+    bool spritesCreated;
+    bool buffersAvailable; // Minden puffer és a blokk fogyasztó rendben (különben a képernyő inaktív)
+    uint16_t waterfallPalette[WATERFALL_COLORS];
+    uint16_t waterfallRow; // A következő írandó waterfall sor
+
+    // Előfeldolgozás és FFT
+    AudioDecimator decimator;
+    AudioOverlapBuffer frames; // Átlapolt FFT keretek (a decimált mintákból)
+    AudioWindow window;
+    AudioFft fft;
+    int16_t decimated[AUDIO_CAPTURE_BLOCK_SIZE]; // Egy decimált blokk
+
+    int16_t *fftInput;     // Ablakozott FFT bemenet
+    uint16_t *magnitudes;  // FFT kimenet (fftSize/2 bin)
+    uint8_t *levels;       // Oszloponkénti szint az aktuális képkockában (0..255 a dinamika tartományon belül)
+    uint8_t *peakHold;     // Oszloponkénti csúcstartott magasság (pixel)
+    uint16_t fftSize;      // Az aktuális FFT méret
+    uint32_t lastSequence; // Az utolsó feldolgozott blokk sorszáma
+    uint8_t spanIndex;     // SPAN_OPTIONS index
+    AudioWindow::Type windowType;
+    bool peakHoldEnabled;
+    uint16_t agcGainQ8;    // Az utolsó átvett blokk AGC erősítése (auto gain)
+    uint8_t blockConsumer; // AudioCapture blokk fogyasztó azonosító
+
+    // Időzítés és mérés
+    uint32_t nextFrameTime;
+    uint32_t fpsWindowStart;
+    uint8_t framesInWindow;
+    uint8_t framesPerSecond;
+    uint32_t averageFrameMicros;
+    bool infoDirty;
+
+    inline uint32_t getSampleRate() const { return static_cast<uint32_t>(SPAN_OPTIONS[spanIndex].maxFrequencyHz) * 2; }
+    inline uint32_t getCaptureRate() const { return getSampleRate() * SPAN_OPTIONS[spanIndex].decimation; }
+
+    void layoutComponents();
+    bool allocateBuffers();
+    void releaseBuffers();
+    void buildWaterfallPalette();
+    void restartCapture();
+    void consumeBlocks();
+    void processFrame();
+    float computeReference() const;
+    void renderSpectrum();
+    void pushWaterfallLine();
+    void drawFrequencyScale();
+    void drawInfo();
+    void cycleFftSize();
+    void cycleSpan();
+    void setPeakHold(bool enabled);
+    void cycleWindow();
+};
+
+#endif // __ANALYZER_SCREEN_H
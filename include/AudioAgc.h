@@ -0,0 +1,93 @@
+/**
+ * @file AudioAgc.h
+ * @brief Blokk alapú, fixpontos automatikus erősítés szabályozás az audio elemző lánchoz
+ * @details A core1 minden mintavételi blokk után egyszer frissíti a burkolót (a blokk abszolút csúcsa,
+ * gyors felfutás, lassú lecsengés), és ebből az erősítést, ami a burkolót TARGET_LEVEL-re hozza.
+ * A fogyasztók (MiniAudioFft, analizátor, CW és RTTY dekóder) csak a közzétett Q8 erősítést olvassák,
+ * a burkolót nem számolják újra. A konfigurációs gain érték (0.0f: auto, >0.0f: kézi szorzó) és az
+ * AGC erősítés összevonása a getEffectiveGain() / getEffectiveGainQ8() feladata.
+ *
+ * Időállandók blokkokban értendők (AUDIO_CAPTURE_BLOCK_SIZE = 256 minta), így az időbeli hosszuk a mintavételi
+ * frekvenciától függ: az alapértelmezett 20 kS/s-nél (AUDIO_CAPTURE_SAMPLE_RATE_DEFAULT) egy blokk ~12.8 ms,
+ * 12 kS/s-nél ~21 ms, 30 kS/s-nél ~8.5 ms.
+ */
+
+#ifndef __AUDIO_AGC_H
+#define __AUDIO_AGC_H
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief Audio AGC
+ */
+class AudioAgc {
+  public:
+    static constexpr uint8_t GAIN_SHIFT = 8;                    // Erősítés Q8 fixpontban
+    static constexpr uint16_t UNITY_GAIN_Q8 = 1 << GAIN_SHIFT;  // 1x
+    static constexpr uint16_t MIN_GAIN_Q8 = UNITY_GAIN_Q8 / 4;  // Legkisebb erősítés (túlvezérelt bemenet)
+    static constexpr uint16_t MAX_GAIN_Q8 = 32 * UNITY_GAIN_Q8; // Legnagyobb erősítés (csendben ne a zajt húzza fel végtelenre)
+    static constexpr int32_t TARGET_LEVEL = 16384;              // A burkoló célértéke (fél kivezérlés, fejtér a csúcsoknak)
+    static constexpr uint8_t ATTACK_SHIFT = 1;                  // Felfutás: blokkonként a különbség 1/2-e
+    static constexpr uint8_t DECAY_SHIFT = 5;                   // Lecsengés: blokkonként a burkoló 1/32-e (~32 blokk időállandó)
+
+    AudioAgc();
+
+    // ===================================================================
+    // Core1 oldal
+    // ===================================================================
+
+    /**
+     * @brief Alapállapot (1x erősítés), a mintavételezés indításakor
+     */
+    void reset();
+
+    /**
+     * @brief Burkoló és erősítés frissítése egy blokk alapján
+     * @param samples Előjeles minták
+     * @param count Minták száma
+     */
+    void processBlock(const int16_t *samples, uint16_t count);
+
+    // ===================================================================
+    // Bármelyik mag
+    // ===================================================================
+
+    /**
+     * @brief Az AGC által számolt erősítés (Q8)
+     */
+    inline uint16_t getGainQ8() const { return gainQ8.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief A követett burkoló (minta amplitúdó)
+     */
+    inline uint16_t getEnvelope() const { return envelope.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Konfigurációs gain érték Q8 erősítéssé alakítása
+     * @param gainConfig 0.0f (vagy negatív): auto, >0.0f: kézi szorzó
+     * @return 0: auto, egyébként a kézi erősítés Q8-ban (MIN_GAIN_Q8..MAX_GAIN_Q8 közé korlátozva)
+     */
+    static uint16_t toManualGainQ8(float gainConfig);
+
+    /**
+     * @brief Effektív erősítés Q8-ban: kézi érték, ha van, különben az AGC erősítése
+     */
+    static inline uint16_t getEffectiveGainQ8(uint16_t manualGainQ8, uint16_t agcGainQ8) { return manualGainQ8 != 0 ? manualGainQ8 : agcGainQ8; }
+
+    /**
+     * @brief Effektív erősítés szorzóként (kijelzők skálázásához)
+     * @param gainConfig 0.0f (vagy negatív): auto, >0.0f: kézi szorzó
+     * @param agcGainQ8 Az AGC erősítése (Q8)
+     */
+    static inline float getEffectiveGain(float gainConfig, uint16_t agcGainQ8) {
+        return gainConfig > 0.0f ? gainConfig : static_cast<float>(agcGainQ8) / UNITY_GAIN_Q8;
+    }
+
+  private:
+    int32_t envelopeQ8; // Burkoló (<< 8), csak a core1 használja
+    std::atomic<uint16_t> gainQ8;
+    std::atomic<uint16_t> envelope;
+};
+
+#endif // __AUDIO_AGC_H
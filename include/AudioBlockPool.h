@@ -0,0 +1,151 @@
+/**
+ * @file AudioBlockPool.h
+ * @brief Közös, referencia számlált audio blokk pool több fogyasztóhoz (másolás nélküli szétosztás)
+ * @details A core1 (író) a pool egy szabad blokkjába konvertálja a mintákat, majd a blokk indexét minden
+ * regisztrált fogyasztó saját SPSC sorába beteszi. A fogyasztók ugyanazt a blokkot csak olvassák, és a
+ * feldolgozás után release()-szel engedik el; a blokk akkor lesz újra szabad, ha az utolsó fogyasztó is elengedte.
+ *
+ * A referencia számláló fogyasztónként egy-egy jelző (held), amit mindig csak egy oldal ír: az író állítja be,
+ * mielőtt a blokkot a fogyasztónak átadja, a fogyasztó törli az elengedéskor. Így nincs szükség atomi
+ * read-modify-write műveletre, ami az M0+ magon nincs.
+ *
+ * Visszanyomás: egy fogyasztó legfeljebb AUDIO_CAPTURE_CONSUMER_DEPTH blokkot tarthat vissza; ha a sora tele van,
+ * csak ő veszít blokkot (a saját eldobás számlálója nő), a többi fogyasztó és a pool nem telik be miatta.
+ * Ha mégsincs szabad blokk (túl sok lassú fogyasztó), a teljes blokk elveszik (kimerülés számláló).
+ *
+ * Fogyasztó fel- és leiratkozás a core0-n: a kérést az író blokkhatáron veszi át (syncConsumers()), a leiratkozó
+ * fogyasztó ezt megvárja (lásd AudioCapture::unregisterConsumer()), és csak utána üríti a sorát.
+ */
+
+#ifndef __AUDIO_BLOCK_POOL_H
+#define __AUDIO_BLOCK_POOL_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "SpscQueue.h"
+#include "defines.h"
+
+static_assert(AUDIO_CAPTURE_MAX_CONSUMERS <= 8, "The consumer mask is 8 bits wide");
+static_assert(AUDIO_CAPTURE_POOL_BLOCKS < 0xFF, "Block indices are 8 bits wide");
+
+/**
+ * @brief Egy mintavételi blokk
+ */
+struct AudioBlock {
+    int16_t samples[AUDIO_CAPTURE_BLOCK_SIZE]; ///< Előjeles minták (12 bites ADC érték középre igazítva, << 4)
+    uint32_t sequence;                         ///< Blokk sorszám (kimaradás felismeréséhez)
+    uint32_t sampleRate;                       ///< A blokk mintavételi frekvenciája (Hz)
+    uint16_t agcGainQ8;                        ///< Az AGC erősítése a blokk után (Q8, lásd AudioAgc)
+};
+
+/**
+ * @brief Audio blokk pool
+ */
+class AudioBlockPool {
+  public:
+    static constexpr uint8_t INVALID_CONSUMER = 0xFF; // Sikertelen regisztráció
+
+    AudioBlockPool();
+
+    // ===================================================================
+    // Core0 (fogyasztó) oldal
+    // ===================================================================
+
+    /**
+     * @brief Új fogyasztó regisztrálása (az író a következő blokkhatáron veszi át)
+     * @return A fogyasztó azonosítója, vagy INVALID_CONSUMER, ha nincs szabad hely
+     */
+    uint8_t registerConsumer();
+
+    /**
+     * @brief Fogyasztó leiratkozásának kérése
+     * @details Az író az átvételig (isConsumerAttached() false) még adhat neki blokkot; utána flush().
+     */
+    void unregisterConsumer(uint8_t consumer);
+
+    /**
+     * @brief Kap-e még blokkokat a fogyasztó (az író szerint)
+     */
+    inline bool isConsumerAttached(uint8_t consumer) const { return activeMask.load(std::memory_order_acquire) & (1u << consumer); }
+
+    /**
+     * @brief Van-e regisztrált fogyasztó
+     */
+    inline bool hasConsumers() const { return requestedMask.load(std::memory_order_acquire) != 0; }
+
+    /**
+     * @brief A fogyasztó legrégebbi blokkja (nullptr, ha nincs); feldolgozás után release()
+     */
+    inline const AudioBlock *peek(uint8_t consumer) const {
+        const uint8_t *slot = queues[consumer].peek();
+        return slot ? &blocks[*slot] : nullptr;
+    }
+
+    /**
+     * @brief A peek()-kel kapott blokk elengedése (az utolsó elengedés után a blokk újra szabad)
+     */
+    void release(uint8_t consumer);
+
+    /**
+     * @brief A fogyasztó minden várakozó blokkjának elengedése
+     */
+    void flush(uint8_t consumer);
+
+    /**
+     * @brief A fogyasztótól teli sor miatt elvett blokkok száma (a regisztráció óta)
+     */
+    inline uint32_t getDropCount(uint8_t consumer) const { return dropCounts[consumer].load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Szabad blokk hiányában teljesen elveszett blokkok száma
+     */
+    inline uint32_t getExhaustedCount() const { return exhaustedCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Legalább egy fogyasztó által tartott blokkok száma (tájékoztató jellegű)
+     */
+    uint8_t getBlocksInUse() const;
+
+    // ===================================================================
+    // Író (core1) oldal
+    // ===================================================================
+
+    /**
+     * @brief A fogyasztó kérések átvétele (blokkhatáron, vagy leállított írónál bárhonnan)
+     */
+    inline void syncConsumers() { activeMask.store(requestedMask.load(std::memory_order_acquire), std::memory_order_release); }
+
+    /**
+     * @brief Egy szabad blokk kérése írásra
+     * @return nullptr, ha minden blokkot tart valamelyik fogyasztó (a kimerülés számláló nő)
+     */
+    AudioBlock *acquire();
+
+    /**
+     * @brief Az acquire()-rel kapott, kitöltött blokk átadása minden aktív fogyasztónak
+     * @details Ha egyik fogyasztó sem vette át, a blokk azonnal szabad (de az író a hívás után még olvashatja,
+     * mert csak ő foglalhatja újra).
+     */
+    void publish(const AudioBlock *block);
+
+  private:
+    using SlotQueue = SpscQueue<uint8_t, AUDIO_CAPTURE_CONSUMER_DEPTH>;
+
+    AudioBlock blocks[AUDIO_CAPTURE_POOL_BLOCKS];
+    std::atomic<bool> held[AUDIO_CAPTURE_POOL_BLOCKS][AUDIO_CAPTURE_MAX_CONSUMERS]; // Az író állítja be, a fogyasztó törli
+    SlotQueue queues[AUDIO_CAPTURE_MAX_CONSUMERS];                                  // Fogyasztónkénti blokk index sor
+
+    std::atomic<uint8_t> requestedMask; // Regisztrált fogyasztók (a core0 írja)
+    std::atomic<uint8_t> activeMask;    // Az író által átvett fogyasztók
+
+    // Statisztika (az író írja; a regisztráció csak inaktív fogyasztónál nulláz)
+    std::atomic<uint32_t> dropCounts[AUDIO_CAPTURE_MAX_CONSUMERS];
+    std::atomic<uint32_t> exhaustedCount;
+
+    uint8_t nextSlot; // A szabad blokk keresés kezdete (csak az író használja)
+
+    bool isFree(uint8_t slot) const;
+};
+
+#endif // __AUDIO_BLOCK_POOL_H
@@ -0,0 +1,202 @@
+/**
+ * @file AudioCapture.h
+ * @brief Audio mintavételező motor: ADC -> DMA kettős puffer -> közös blokk pool (core1)
+ * @details Az ADC szabadon futó módban, a DMA két egymásba láncolt csatornával felváltva tölti a két
+ * mintavételi puffert. A kész puffert a core1-en futó DMA megszakítás előjeles, középre igazított
+ * mintákká alakítja a blokk pool egy szabad blokkjába, amit minden regisztrált core0 fogyasztó
+ * másolás nélkül, ugyanabból a példányból olvas (lásd AudioBlockPool).
+ * Az ADC/DMA konfigurálása mindig a core1-en történik (loopCore1()), a core0 csak kérést ad le.
+ * Egy blokk feldolgozó (pl. CW dekóder) közvetlenül a core1-en, a blokk elkészültekor is megkaphatja a mintákat.
+ */
+
+#ifndef __AUDIO_CAPTURE_H
+#define __AUDIO_CAPTURE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "AudioAgc.h"
+#include "AudioBlockPool.h"
+#include "defines.h"
+
+/**
+ * @brief A core1-en, minden kész blokkra meghívott feldolgozó
+ * @details A hívás a DMA megszakításból történik, ezért egy blokknyi időn belül vissza kell térnie,
+ * és nem foglalhat memóriát. Az eredményeket lock-free módon (atomikus változók, SPSC sor) adja át a core0-nak.
+ */
+class AudioBlockProcessor {
+  public:
+    virtual ~AudioBlockProcessor() = default;
+
+    /**
+     * @brief Egy blokk feldolgozása (core1)
+     * @param samples Előjeles minták (csak olvasható)
+     * @param count Minták száma
+     * @param sampleRate Mintavételi frekvencia (Hz)
+     * @param agcGainQ8 Az AGC erősítése a blokk után (Q8, lásd AudioAgc)
+     */
+    virtual void processBlock(const int16_t *samples, uint16_t count, uint32_t sampleRate, uint16_t agcGainQ8) = 0;
+};
+
+/**
+ * @brief Audio mintavételező motor
+ */
+class AudioCapture {
+  public:
+    static constexpr uint8_t INVALID_CONSUMER = AudioBlockPool::INVALID_CONSUMER;
+
+    AudioCapture();
+
+    // ===================================================================
+    // Core0 (fogyasztó) oldal
+    // ===================================================================
+
+    /**
+     * @brief Mintavételezés indításának kérése
+     * @param sampleRate Mintavételi frekvencia (Hz), AUDIO_CAPTURE_SAMPLE_RATE_MIN..MAX közé korlátozva
+     * @details Futó mintavételezés esetén az új frekvenciával újraindul. Az ADC-t a core1 konfigurálja.
+     */
+    void start(uint32_t sampleRate = AUDIO_CAPTURE_SAMPLE_RATE_DEFAULT);
+
+    /**
+     * @brief Mintavételezés leállításának kérése
+     */
+    void stop();
+
+    /**
+     * @brief Fut-e a mintavételezés (a core1 már alkalmazta a kérést)
+     */
+    inline bool isRunning() const { return activeSampleRate.load(std::memory_order_acquire) != 0; }
+
+    /**
+     * @brief Foglalja-e (vagy fogja-e hamarosan foglalni) a mintavételezés az ADC-t
+     * @details Ilyenkor a core0 nem hívhat analogRead()-et, mert átállítaná az ADC bemenetet.
+     */
+    inline bool isAdcBusy() const { return requestedSampleRate.load(std::memory_order_acquire) != 0 || isRunning(); }
+
+    /**
+     * @brief Blokk fogyasztó regisztrálása (a következő blokktól kapja a blokkokat)
+     * @return A fogyasztó azonosítója, vagy INVALID_CONSUMER, ha nincs szabad hely
+     */
+    uint8_t registerConsumer();
+
+    /**
+     * @brief Blokk fogyasztó leiratkozása
+     * @details Futó mintavételezésnél megvárja, amíg a core1 a következő blokknál átveszi, majd elengedi
+     * a fogyasztó várakozó blokkjait; visszatérés után az azonosító már nem használható.
+     */
+    void unregisterConsumer(uint8_t consumer);
+
+    /**
+     * @brief A fogyasztó legrégebbi kész blokkja (nullptr, ha nincs); feldolgozás után releaseBlock()
+     */
+    inline const AudioBlock *peekBlock(uint8_t consumer) const { return blockPool.peek(consumer); }
+
+    /**
+     * @brief A peekBlock()-kal kapott blokk elengedése
+     */
+    inline void releaseBlock(uint8_t consumer) { blockPool.release(consumer); }
+
+    /**
+     * @brief A fogyasztó minden várakozó blokkjának elengedése (pl. újraindításkor)
+     */
+    inline void flushBlocks(uint8_t consumer) { blockPool.flush(consumer); }
+
+    /**
+     * @brief A fogyasztótól elvett blokkok száma (a sora tele volt, nem győzte)
+     */
+    inline uint32_t getDropCount(uint8_t consumer) const { return blockPool.getDropCount(consumer); }
+
+    /**
+     * @brief Használja-e még valaki a mintavételezést (regisztrált blokk fogyasztó vagy core1 feldolgozó)
+     */
+    inline bool hasUsers() const { return blockPool.hasConsumers() || requestedProcessor.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief Teljesen elveszett blokkok száma (a poolban nem volt szabad blokk)
+     */
+    inline uint32_t getOverrunCount() const { return blockPool.getExhaustedCount(); }
+
+    /**
+     * @brief A fogyasztók által éppen tartott blokkok száma
+     */
+    inline uint8_t getBlocksInUse() const { return blockPool.getBlocksInUse(); }
+
+    /**
+     * @brief Az utolsó mérési ablakban ténylegesen leadott minták száma másodpercenként
+     */
+    inline uint32_t getSustainedSampleRate() const { return sustainedSampleRate.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief A beállított (aktív) mintavételi frekvencia (0: áll)
+     */
+    inline uint32_t getSampleRate() const { return activeSampleRate.load(std::memory_order_acquire); }
+
+    /**
+     * @brief A közös AGC (a core1 blokkonként frissíti, a fogyasztók csak olvassák)
+     */
+    inline const AudioAgc &getAgc() const { return agc; }
+
+    /**
+     * @brief A core1-en futó blokk feldolgozó beállítása (nullptr: nincs)
+     * @details Futó mintavételezésnél megvárja, amíg a core1 a következő blokknál átveszi az újat,
+     * így visszatérés után a korábbi feldolgozó biztosan nem fut már, és megszüntethető.
+     */
+    void setBlockProcessor(AudioBlockProcessor *processor);
+
+    // ===================================================================
+    // Core1 oldal
+    // ===================================================================
+
+    /**
+     * @brief Core1 inicializálás (setup1()-ből)
+     */
+    void setupCore1();
+
+    /**
+     * @brief Core1 ciklus (loop1()-ből): kérések alkalmazása, statisztika
+     */
+    void loopCore1();
+
+    /**
+     * @brief DMA megszakítás kezelő (core1)
+     */
+    void handleDmaIrq();
+
+  private:
+    static constexpr uint32_t STATS_WINDOW_MS = 1000;            // Sustained sample rate mérési ablak
+    static constexpr uint32_t PROCESSOR_SWITCH_TIMEOUT_MS = 200; // Feldolgozó és fogyasztó váltás nyugtázásának várakozási korlátja
+
+    AudioBlockPool blockPool;
+    AudioAgc agc;
+
+    // Kétmagos vezérlés: a core0 ír, a core1 olvas
+    std::atomic<uint32_t> requestedSampleRate; // 0: leállítás kérése
+    std::atomic<uint32_t> activeSampleRate;    // 0: áll
+
+    // Core1 blokk feldolgozó: a core0 kéri, a core1 blokkhatáron veszi át
+    std::atomic<AudioBlockProcessor *> requestedProcessor;
+    std::atomic<AudioBlockProcessor *> activeProcessor;
+
+    // Statisztika (a core1 írja)
+    std::atomic<uint32_t> sustainedSampleRate;
+    volatile uint32_t capturedSamples;
+    uint32_t statsWindowStart;
+    uint32_t statsWindowSamples;
+
+    // DMA állapot (csak a core1 használja)
+    int dmaChannels[2];
+    uint16_t dmaBuffers[2][AUDIO_CAPTURE_BLOCK_SIZE];
+    int16_t processorScratch[AUDIO_CAPTURE_BLOCK_SIZE]; // Konvertált minták a feldolgozónak, ha nincs szabad blokk
+    uint32_t blockSequence;
+
+    void startHardware(uint32_t sampleRate);
+    void stopHardware();
+    void deliverBuffer(uint8_t bufferIndex);
+    void updateStats();
+};
+
+// Globális audio mintavételező (a main.cpp setup1()/loop1() hajtja)
+extern AudioCapture audioCapture;
+
+#endif // __AUDIO_CAPTURE_H
@@ -0,0 +1,184 @@
+/**
+ * @file AudioDspStages.h
+ * @brief Fixpontos audio előfeldolgozó lépcsők az FFT elé: decimálás, átlapolt keretezés, ablakozás
+ * @details A lépcsők láncba fűzhetők (AudioBlock -> AudioDecimator -> AudioOverlapBuffer -> AudioWindow -> AudioFft),
+ * mindegyik előjeles Q15 mintákkal dolgozik. Memóriát csak a konstruktor foglal (a legnagyobb használt méretre),
+ * a blokkonkénti feldolgozás nem foglal és nem tol el puffert.
+ *
+ * - AudioDecimator: polifázisú FIR aluláteresztő + ritkítás 2/4/8-cal (a lassabb kimeneti frekvencia alias
+ *   mentes, mert a hasznos sávon kívüli hangok nem hajlanak vissza)
+ * - AudioOverlapBuffer: a legutóbbi keretnyi minta folytonosan olvasható; új keret akkor kész, ha legalább
+ *   a fele új (50% átlapolás)
+ * - AudioWindow: Hann vagy Blackman-Harris Q15 ablak tábla, csak méret/típus váltáskor számolva
+ */
+
+#ifndef __AUDIO_DSP_STAGES_H
+#define __AUDIO_DSP_STAGES_H
+
+#include <Arduino.h>
+
+#include "defines.h"
+
+/**
+ * @brief Q15 ablak tábla
+ */
+class AudioWindow {
+  public:
+    /**
+     * @brief Ablak típusok
+     */
+    enum class Type : uint8_t {
+        Hann,           // -31 dB oldalhurok, keskeny főhurok
+        BlackmanHarris, // 4 tagú, -92 dB oldalhurok (nagy dinamikájú kijelzéshez), szélesebb főhurok
+        Count
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param maxSize A legnagyobb ablak méret (ehhez foglal táblát)
+     */
+    explicit AudioWindow(uint16_t maxSize);
+    ~AudioWindow();
+
+    /**
+     * @brief Sikerült-e a tábla lefoglalása
+     */
+    inline bool isAvailable() const { return table != nullptr; }
+
+    /**
+     * @brief Típus és méret beállítása (a tábla csak változáskor számolódik újra)
+     * @return false, ha a méret nagyobb a lefoglaltnál vagy nincs tábla
+     */
+    bool configure(Type type, uint16_t size);
+
+    /**
+     * @brief Ablakozás: output[i] = input[i] * w[i] (getSize() minta; a bemenet és a kimenet lehet ugyanaz)
+     */
+    void apply(const int16_t *input, int16_t *output) const;
+
+    /**
+     * @brief Koherens erősítés (az ablak átlaga, Q15): egy szinusz FFT csúcsa ennyivel kisebb, mint ablak nélkül
+     */
+    inline uint16_t getCoherentGainQ15() const { return coherentGainQ15; }
+
+    inline Type getType() const { return type; }
+    inline uint16_t getSize() const { return size; }
+
+    /**
+     * @brief Rövid név kijelzéshez
+     */
+    static const char *getTypeName(Type type);
+
+  private:
+    int16_t *table;
+    uint16_t maxSize;
+    uint16_t size; // 0: még nincs kiszámolva
+    Type type;
+    uint16_t coherentGainQ15;
+};
+
+/**
+ * @brief Átlapolt keretező: a legutóbbi frameSize minta folytonosan, másolás nélkül olvasható
+ * @details Tükrözött gyűrűpuffer: minden minta két helyre íródik (i és i + maxFrameSize), így a legutóbbi
+ * keret mindig egy darabban van, és nem kell blokkonként eltolni a teljes puffert.
+ */
+class AudioOverlapBuffer {
+  public:
+    /**
+     * @brief Konstruktor
+     * @param maxFrameSize A legnagyobb keret méret (kétszeresét foglalja)
+     */
+    explicit AudioOverlapBuffer(uint16_t maxFrameSize);
+    ~AudioOverlapBuffer();
+
+    inline bool isAvailable() const { return buffer != nullptr; }
+
+    /**
+     * @brief Keret méret beállítása (a lépésköz a fele); a puffer kiürül
+     * @return false, ha a méret nagyobb a lefoglaltnál
+     */
+    bool configure(uint16_t frameSize);
+
+    /**
+     * @brief A puffer ürítése (pl. kimaradt blokk után a régi minták már nem folytonosak)
+     */
+    void reset();
+
+    /**
+     * @brief Minták hozzáfűzése
+     */
+    void write(const int16_t *samples, uint16_t count);
+
+    /**
+     * @brief Kész-e új keret: megtelt a puffer, és az előző keret óta legalább a keret fele új
+     */
+    inline bool isFrameReady() const { return filled >= frameSize && newSamples >= frameSize / 2; }
+
+    /**
+     * @brief A legutóbbi frameSize minta (a legrégebbi elöl); a következő write()-ig érvényes
+     */
+    inline const int16_t *getFrame() const { return buffer + writePos + maxFrameSize - frameSize; }
+
+    /**
+     * @brief A keret feldolgozva: a következő kész kerethez újabb fél keretnyi minta kell
+     */
+    inline void consumeFrame() { newSamples = 0; }
+
+    inline uint16_t getFrameSize() const { return frameSize; }
+
+  private:
+    int16_t *buffer; // 2 * maxFrameSize minta (tükrözött)
+    uint16_t maxFrameSize;
+    uint16_t frameSize;
+    uint16_t writePos;   // A következő írás helye (0..maxFrameSize-1)
+    uint16_t filled;     // Érvényes minták (legfeljebb maxFrameSize)
+    uint16_t newSamples; // Az utolsó consumeFrame() óta érkezett minták (telítődik)
+};
+
+/**
+ * @brief Polifázisú FIR decimátor (2, 4 vagy 8; 1: átengedés)
+ * @details Az N = factor * TAPS_PER_PHASE hosszú, Blackman ablakos sinc aluláteresztő h[k] együtthatói fázisonként
+ * (h[j * factor + p]) vannak tárolva; a p. fázis ág minden factor-adik mintát kapja, és csak kimenetenként
+ * egyszer összegződik, így kimeneti mintánként N szorzás kell (nem factor * N). A táblák rögzített méretűek,
+ * nincs dinamikus foglalás.
+ */
+class AudioDecimator {
+  public:
+    static constexpr uint8_t MAX_FACTOR = 8;
+    static constexpr uint8_t TAPS_PER_PHASE = 32; // Fázisonkénti együtthatók (a szűrő hossza factor * ennyi)
+
+    AudioDecimator();
+
+    /**
+     * @brief Decimálási arány beállítása (az együtthatók csak változáskor számolódnak); az állapot törlődik
+     * @return false, ha a factor nem 1, 2, 4 vagy 8
+     */
+    bool configure(uint8_t factor);
+
+    /**
+     * @brief A késleltető vonalak törlése (kimaradt blokk, mintavételi frekvencia váltás után)
+     */
+    void reset();
+
+    /**
+     * @brief Egy blokk decimálása
+     * @param input Bemeneti minták
+     * @param count Bemeneti minták száma
+     * @param output Kimenet (legalább count / factor + 1 hely; 1-es aránynál count)
+     * @return Kimeneti minták száma
+     */
+    uint16_t process(const int16_t *input, uint16_t count, int16_t *output);
+
+    inline uint8_t getFactor() const { return factor; }
+
+  private:
+    uint8_t factor;
+    uint8_t phase;       // A következő minta fázis ága (factor-1 .. 0; a 0. után kész egy kimenet)
+    uint8_t delayPos;    // A legújabb minta helye a fázis ágak késleltető vonalában
+    int32_t accumulator; // Az aktuális kimenet részösszege (Q15 * Q15)
+
+    int16_t coefficients[MAX_FACTOR][TAPS_PER_PHASE];   // [fázis][j] = h[j * factor + fázis]
+    int16_t delayLines[MAX_FACTOR][TAPS_PER_PHASE * 2]; // Fázis ágankénti tükrözött késleltető vonal
+};
+
+#endif // __AUDIO_DSP_STAGES_H
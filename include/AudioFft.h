@@ -0,0 +1,72 @@
+/**
+ * @file AudioFft.h
+ * @brief Valós bemenetű audio FFT magnitúdó spektrum, fordításkor választható implementációval
+ * @details AUDIO_FFT_IMPLEMENTATION szerint:
+ * - AUDIO_FFT_IMPLEMENTATION_FIXED: Q15 fixpontos radix-4 (szükség esetén egy záró radix-2 lépcsővel),
+ *   blokk lebegőpontos skálázással, fordítási időben (constexpr) generált szinusz táblával.
+ *   Az N pontos valós bemenet N/2 pontos komplex FFT-be csomagolva kerül feldolgozásra.
+ * - AUDIO_FFT_IMPLEMENTATION_ARDUINO: arduinoFFT (float).
+ */
+
+#ifndef __AUDIO_FFT_H
+#define __AUDIO_FFT_H
+
+#include <Arduino.h>
+
+#include "defines.h"
+
+/**
+ * @brief Audio FFT motor
+ */
+class AudioFft {
+  public:
+    /**
+     * @brief Konstruktor
+     * @param maxSize A legnagyobb használt FFT méret (ehhez foglal munkaterületet)
+     */
+    explicit AudioFft(uint16_t maxSize = AUDIO_FFT_SIZE_DEFAULT);
+    ~AudioFft();
+
+    /**
+     * @brief Sikerült-e a munkaterület lefoglalása
+     */
+    bool isAvailable() const;
+
+    inline uint16_t getMaxSize() const { return maxSize; }
+
+    /**
+     * @brief Támogatott-e a méret (kettő hatványa AUDIO_FFT_SIZE_MIN..AUDIO_FFT_SIZE_MAX között)
+     */
+    static bool isSupportedSize(uint16_t size);
+
+    /**
+     * @brief Az aktív implementáció neve (kijelzéshez, debughoz)
+     */
+    static const char *getImplementationName();
+
+    /**
+     * @brief Magnitúdó spektrum számítása
+     * @param samples size darab Q15 minta (nem módosul; az ablakozás a hívó feladata)
+     * @param size FFT méret (legfeljebb getMaxSize())
+     * @param magnitudes size/2 darab kimeneti bin; egy teljes kivezérlésű szinusz csúcsa ~32767
+     * @return false, ha a méret nem támogatott vagy nincs munkaterület
+     */
+    bool computeMagnitudes(const int16_t *samples, uint16_t size, uint16_t *magnitudes);
+
+  private:
+    uint16_t maxSize;
+
+#if AUDIO_FFT_IMPLEMENTATION == AUDIO_FFT_IMPLEMENTATION_FIXED
+    int16_t *work; // maxSize darab int16: maxSize/2 komplex pont (re, im felváltva)
+
+    int8_t complexFft(uint16_t points, uint8_t log2Points);
+    void bitReverse(uint16_t points);
+#elif AUDIO_FFT_IMPLEMENTATION == AUDIO_FFT_IMPLEMENTATION_ARDUINO
+    float *vReal;
+    float *vImag;
+#else
+#error "AudioFft: a választott AUDIO_FFT_IMPLEMENTATION nem támogatott (a CMSIS-DSP nincs a függőségek között)"
+#endif
+};
+
+#endif // __AUDIO_FFT_H
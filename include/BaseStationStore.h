@@ -47,6 +47,35 @@ template <typename StationListType, uint8_t MaxStations> class BaseStationStore
         return true;
     }
 
+    /**
+     * @brief Több állomás hozzáadása egyetlen EEPROM mentéssel (pl. scan eredményből)
+     * @return A ténylegesen hozzáadott állomások száma (duplikátumok és a betelt tároló miatt kevesebb lehet)
+     */
+    uint8_t addStations(const StationData *newStations, uint8_t count) {
+        uint8_t added = 0;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (data.count >= MaxStations) {
+                DEBUG("%s Memory full. %d station(s) skipped.\n", this->getClassName(), count - i);
+                break;
+            }
+
+            // Duplikátum ellenőrzés
+            if (isStationExists(newStations[i])) {
+                continue;
+            }
+
+            data.stations[data.count] = newStations[i];
+            data.count++;
+            added++;
+        }
+
+        if (added > 0) {
+            DEBUG("%s %d station(s) added in bulk.\n", this->getClassName(), added);
+            this->checkSave();
+        }
+        return added;
+    }
+
     /**
      * @brief Állomás frissítése
      */
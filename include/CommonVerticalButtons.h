@@ -33,6 +33,7 @@ static constexpr uint8_t SQUELCH = 14; ///< Zajzár beállítás (univerzális)
 static constexpr uint8_t FREQ = 15;    ///< Frekvencia input (univerzális)
 static constexpr uint8_t SETUP = 16;   ///< Beállítások képernyő (univerzális)
 static constexpr uint8_t MEMO = 17;    ///< Memória funkciók (univerzális)
+static constexpr uint8_t AFFT = 18;    ///< Audio analizátor képernyő (univerzális)
 } // namespace VerticalButtonIDs
 
 /**
@@ -292,6 +293,23 @@ class CommonVerticalButtons {
         screenManager->switchToScreen(SCREEN_NAME_MEMORY);
     }
 
+    /**
+     * @brief AFFT gomb kezelő - Képernyőváltás az audio analizátor képernyőre
+     */
+    static void handleAnalyzerButton(const UIButton::ButtonEvent &event, Si4735Manager *si4735Manager, UIScreen *screen) {
+        if (event.state != UIButton::EventButtonState::Clicked || !screen) {
+            return;
+        }
+
+        IScreenManager *screenManager = screen->getScreenManager();
+        if (!screenManager) {
+            DEBUG("ERROR: Could not get screenManager from screen in handleAnalyzerButton!\n");
+            return;
+        }
+        DEBUG("Switching to Analyzer screen\n");
+        screenManager->switchToScreen(SCREEN_NAME_ANALYZER);
+    }
+
     /**
      * @brief Központi gomb definíciók
      */
@@ -305,7 +323,8 @@ class CommonVerticalButtons {
             {VerticalButtonIDs::SQUELCH, "Sql", UIButton::ButtonType::Toggleable, UIButton::ButtonState::Off, 32, handleSquelchButton},
             {VerticalButtonIDs::FREQ, "Freq", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, 32, handleFrequencyButton},
             {VerticalButtonIDs::SETUP, "Setup", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, 32, handleSetupButton},
-            {VerticalButtonIDs::MEMO, "Memo", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, 32, handleMemoryButton}};
+            {VerticalButtonIDs::MEMO, "Memo", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, 32, handleMemoryButton},
+            {VerticalButtonIDs::AFFT, "AFFT", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, 32, handleAnalyzerButton}};
         return BUTTON_DEFINITIONS;
     }
 
@@ -381,7 +400,7 @@ class CommonVerticalButtons {
         void createCommonVerticalButtons(Si4735Manager *si4735Manager) {
             ScreenType *self = static_cast<ScreenType *>(this);
             auto buttonDefs = CommonVerticalButtons::createUniformButtonDefinitions(si4735Manager, self, self->getTFT());
-            ButtonsGroupManager<ScreenType>::layoutVerticalButtonGroup(buttonDefs, &createdVerticalButtons, 0, 0, 5, 60, 32, 3, 4);
+            ButtonsGroupManager<ScreenType>::layoutVerticalButtonGroup(buttonDefs, &createdVerticalButtons, 0, 0, 5, 60, 32, 3, 3); // 9 gomb 3px réssel még egy oszlopba fér
         }
 
         /**
@@ -63,7 +63,7 @@ struct Config_t {
     uint8_t audioModeAM;   // Utolsó audio mód AM képernyőn (AudioComponentType)
     uint8_t audioModeFM;   // Utolsó audio mód FM képernyőn (AudioComponentType)
     bool audioEnabled;     // Audio vizualizáció be/ki
-    uint16_t audioFftSize; // FFT méret (256, 512, 1024)
+    uint16_t audioFftSize; // FFT méret az analizátor képernyőn (256, 512, 1024, 2048)
     float audioFftGain;    // Audio FFT erősítés (0.1 - 10.0)
 };
 
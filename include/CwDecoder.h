@@ -0,0 +1,131 @@
+/**
+ * @file CwDecoder.h
+ * @brief Folyamatos CW (Morse) dekóder audio blokkokból
+ * @details Goertzel hang detektor a CW vételi eltolás (Config_t::cwReceiverOffsetHz) frekvenciáján,
+ * ~4 ms-os detektor ablakokkal. A billentyű állapotot adaptív (zajszint / jelszint követő) küszöb
+ * és hiszterézis adja, a jel/szünet hosszakból a becsült pont hossz szerint áll elő a pont/vonás,
+ * karakter- és szóköz. A pont hossz (és így a WPM) folyamatosan követi az adó sebességét.
+ *
+ * A dekóder a core1-en, a mintavételező blokk feldolgozójaként fut (AudioCapture::setBlockProcessor()),
+ * memóriát nem foglal; a dekódolt karaktereket SPSC soron adja át a core0-nak.
+ */
+
+#ifndef __CW_DECODER_H
+#define __CW_DECODER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "AudioCapture.h"
+#include "SpscQueue.h"
+#include "defines.h"
+
+/**
+ * @brief CW dekóder
+ */
+class CwDecoder : public AudioBlockProcessor {
+  public:
+    static constexpr uint16_t DETECTOR_FRAME_US = 4000; // Goertzel ablak hossza (us)
+    static constexpr uint16_t MAX_FRAME_SAMPLES = 160;  // Goertzel ablak felső korlátja (fixpontos tartomány)
+    static constexpr uint8_t DEBOUNCE_FRAMES = 2;       // Ennyi egyező ablak kell a billentyű állapot váltásához
+    static constexpr float MIN_SNR = 2.5f;              // Jel/zaj arány (amplitúdó), ami alatt nincs dekódolás
+    static constexpr float MIN_SIGNAL_LEVEL = 16.0f;    // Legkisebb elfogadott hang amplitúdó (12 bites minta egység, az effektív erősítés után)
+    static constexpr uint8_t TEXT_QUEUE_SIZE = 64;      // Core1 -> core0 karakter sor mérete
+    static constexpr char UNKNOWN_CHAR = '*';           // Ismeretlen jelsorozat jelölése
+
+    CwDecoder();
+
+    // ===================================================================
+    // Core0 oldal
+    // ===================================================================
+
+    /**
+     * @brief A figyelt hang frekvencia beállítása
+     * @param frequencyHz CW_DECODER_MIN_FREQUENCY..CW_DECODER_MAX_FREQUENCY közé korlátozva
+     */
+    void setToneFrequency(uint16_t frequencyHz);
+
+    inline uint16_t getToneFrequency() const { return requestedFrequency.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Erősítés beállítása (a minimális jelszint küszöbhöz)
+     * @param gainConfig 0.0f: az AudioAgc erősítése, >0.0f: kézi szorzó
+     */
+    inline void setGain(float gainConfig) { manualGainQ8.store(AudioAgc::toManualGainQ8(gainConfig), std::memory_order_relaxed); }
+
+    /**
+     * @brief Dekóder állapot törlésének kérése (pl. hangoláskor); a core1 a következő blokknál végzi el
+     */
+    inline void requestReset() { resetRequested.store(true, std::memory_order_release); }
+
+    /**
+     * @brief A következő dekódolt karakter kivétele
+     * @return false, ha nincs új karakter
+     */
+    bool popChar(char &c);
+
+    /**
+     * @brief Becsült adási sebesség (szó/perc)
+     */
+    inline uint8_t getWpm() const { return wpm.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Le van-e nyomva éppen a billentyű (van-e hang)
+     */
+    inline bool isKeyDown() const { return keyDown.load(std::memory_order_relaxed); }
+
+    // ===================================================================
+    // Core1 oldal
+    // ===================================================================
+
+    /**
+     * @brief Egy audio blokk feldolgozása (AudioBlockProcessor)
+     */
+    virtual void processBlock(const int16_t *samples, uint16_t count, uint32_t sampleRate, uint16_t agcGainQ8) override;
+
+  private:
+    // Core0 -> core1 kérések
+    std::atomic<uint16_t> requestedFrequency;
+    std::atomic<uint16_t> manualGainQ8; // 0: AGC
+    std::atomic<bool> resetRequested;
+
+    // Core1 -> core0 eredmények
+    SpscQueue<char, TEXT_QUEUE_SIZE> textQueue;
+    std::atomic<uint8_t> wpm;
+    std::atomic<bool> keyDown;
+
+    // Goertzel detektor (core1)
+    uint16_t toneFrequency;
+    uint32_t sampleRate;
+    uint16_t frameSamples; // Minták száma egy detektor ablakban
+    uint16_t frameFill;    // Az aktuális ablakba eddig került minták
+    int32_t coeffQ14;      // 2*cos(w) Q14-ben
+    int32_t s1, s2;        // Goertzel állapot
+    float frameMs;         // Egy ablak hossza (ms)
+
+    // Adaptív küszöb
+    float signalLevel;
+    float noiseLevel;
+    float gain; // Az aktuális blokk effektív erősítése
+
+    // Billentyű állapot és időzítés (ablakokban mérve)
+    bool rawKey;
+    bool key;
+    uint8_t debounceCount;
+    uint16_t stateFrames;
+    float ditFrames;
+    uint8_t symbol;        // Morse fa index: 1 = üres, pontnál *2, vonásnál *2+1
+    bool symbolOverflow;   // Túl hosszú jelsorozat
+    bool wordSpacePending; // Karakter után még jöhet szóköz
+
+    void configureDetector(uint16_t frequencyHz, uint32_t rate);
+    void resetDecoder();
+    void processFrame(float level);
+    void onKeyUp(uint16_t markFrames);
+    void onSpaceFrame();
+    void setDitFrames(float frames);
+    void emitChar(char c);
+    static char lookupSymbol(uint8_t symbol);
+};
+
+#endif // __CW_DECODER_H
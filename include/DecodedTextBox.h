@@ -0,0 +1,87 @@
+/**
+ * @file DecodedTextBox.h
+ * @brief Dekódolt szöveg (CW, RTTY) görgetett megjelenítése
+ * @details Rögzített méretű sor pufferekkel dolgozik (nincs dinamikus foglalás). A beérkező karakterek
+ * az utolsó sorba kerülnek, a sor betelésekor a szöveg egy sorral feljebb gördül. A felső, kis betűs
+ * állapotsorba a dekóder adatai (mód, sebesség, hang frekvencia) kerülnek. Változatlan tartalomnál
+ * nem rajzol, sorvége nélküli új karakternél csak az utolsó sort rajzolja újra. Érintésre a beállított
+ * kezelőt hívja.
+ */
+
+#ifndef __DECODED_TEXT_BOX_H
+#define __DECODED_TEXT_BOX_H
+
+#include "UIComponent.h"
+#include <functional>
+
+/**
+ * @brief Dekódolt szöveg doboz
+ */
+class DecodedTextBox : public UIComponent {
+  public:
+    static constexpr uint8_t MAX_LINES = 8;      // Sor pufferek száma (a látható sorok felső korlátja)
+    static constexpr uint8_t MAX_COLUMNS = 48;   // Egy sor legnagyobb hossza
+    static constexpr uint8_t STATUS_LENGTH = 48; // Állapotsor puffer mérete
+    static constexpr uint8_t TEXT_SIZE = 2;      // Szöveg betűméret (alap font)
+    static constexpr uint8_t CHAR_WIDTH = 6 * TEXT_SIZE;
+    static constexpr uint8_t LINE_HEIGHT = 8 * TEXT_SIZE;
+    static constexpr uint8_t STATUS_HEIGHT = 12; // Állapotsor magassága
+    static constexpr uint8_t PADDING = 3;        // Belső margó
+
+    /**
+     * @brief Konstruktor
+     * @param tft TFT display referencia
+     * @param bounds Komponens határai (a látható sorok és oszlopok száma ebből adódik)
+     * @param colors Színséma (opcionális)
+     */
+    DecodedTextBox(TFT_eSPI &tft, const Rect &bounds, const ColorScheme &colors = ColorScheme::defaultScheme());
+
+    virtual ~DecodedTextBox() = default;
+
+    /**
+     * @brief Egy dekódolt karakter hozzáfűzése ('\n' új sort kezd, a nem nyomtatható karakterek kimaradnak)
+     */
+    void appendChar(char c);
+
+    /**
+     * @brief A szöveg törlése (az állapotsor marad)
+     */
+    void clear();
+
+    /**
+     * @brief Az állapotsor szövegének beállítása (csak változás esetén rajzol újra)
+     */
+    void setStatus(const char *status);
+
+    /**
+     * @brief Érintés kezelő beállítása (pl. dekóder beállítás léptetése)
+     */
+    inline void setClickCallback(std::function<void()> callback) { clickCallback = callback; }
+
+    // UIComponent interface implementáció
+    virtual void draw() override;
+    virtual void markForRedraw(bool markChildren = false) override;
+
+  protected:
+    virtual void onClick(const TouchEvent &event) override;
+    virtual bool allowsVisualPressedFeedback() const override { return false; }
+
+  private:
+    std::function<void()> clickCallback;
+
+    char lines[MAX_LINES][MAX_COLUMNS + 1];
+    char status[STATUS_LENGTH];
+    uint8_t visibleLines; // A bounds-ba férő sorok száma
+    uint8_t columns;      // A bounds-ba férő oszlopok száma
+    uint8_t cursorColumn; // Az utolsó sor hossza
+    bool lastLineDirty;   // Csak az utolsó sor változott
+    bool allLinesDirty;   // Görgetés: minden sor változott
+    bool statusDirty;     // Csak az állapotsor változott
+    bool fullRedraw;      // Keret, háttér és minden sor (törlés, első rajzolás)
+
+    void newLine();
+    void drawStatus();
+    void drawLine(uint8_t line);
+};
+
+#endif // __DECODED_TEXT_BOX_H
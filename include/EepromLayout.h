@@ -1,8 +1,9 @@
 #ifndef __EEPROM_LAYOUT_H
 #define __EEPROM_LAYOUT_H
 
-#include "ConfigData.h"  // Config_t struktúra
-#include "StationData.h" // FmStationList_t, AmStationList_t struktúrák
+#include "ConfigData.h"       // Config_t struktúra
+#include "ScanSnapshotData.h" // ScanSnapshotData_t struktúra
+#include "StationData.h"      // FmStationList_t, AmStationList_t struktúrák
 #include "StoreEepromBase.h"
 #include "defines.h" // BANDTABLE_SIZE konstanshoz
 
@@ -24,7 +25,9 @@ struct BandStoreData_t;
  * │ Band Data       │ Config+  │ BAND_STORE_REQUIRED_SIZE bytes      │
  * │ FM Stations     │ Bands+   │ FM_STATIONS_REQUIRED_SIZE bytes     │
  * │ AM Stations     │ FM+      │ AM_STATIONS_REQUIRED_SIZE bytes     │
+ * │ Scan Snapshot * │ AM+      │ SCAN_SNAPSHOT_REQUIRED_SIZE bytes   │
  * └─────────────────┴──────────┴─────────────────────────────────────┘
+ * (*) Csak SCAN_SNAPSHOT_PERSIST esetén
  */
 
 // ============================================
@@ -55,8 +58,19 @@ constexpr uint16_t EEPROM_AM_STATIONS_ADDR = EEPROM_FM_STATIONS_ADDR + FM_STATIO
 /** AM állomások mérete */
 constexpr size_t AM_STATIONS_REQUIRED_SIZE = StoreEepromBase<AmStationList_t>::getRequiredSize();
 
+#ifdef SCAN_SNAPSHOT_PERSIST
+/** Scan snapshot kezdőcíme */
+constexpr uint16_t EEPROM_SCAN_SNAPSHOT_ADDR = EEPROM_AM_STATIONS_ADDR + AM_STATIONS_REQUIRED_SIZE;
+
+/** Scan snapshot mérete */
+constexpr size_t SCAN_SNAPSHOT_REQUIRED_SIZE = StoreEepromBase<ScanSnapshotData_t>::getRequiredSize();
+
+/** Teljes használt EEPROM méret */
+constexpr size_t EEPROM_TOTAL_USED = EEPROM_SCAN_SNAPSHOT_ADDR + SCAN_SNAPSHOT_REQUIRED_SIZE;
+#else
 /** Teljes használt EEPROM méret */
 constexpr size_t EEPROM_TOTAL_USED = EEPROM_AM_STATIONS_ADDR + AM_STATIONS_REQUIRED_SIZE;
+#endif
 
 /** Szabad EEPROM terület */
 constexpr size_t EEPROM_FREE_SPACE = EEPROM_SIZE - EEPROM_TOTAL_USED;
@@ -8,6 +8,7 @@
 #define __FM_SCREEN_H
 #include "CommonVerticalButtons.h"
 #include "MemoryScreen.h"
+#include "MiniAudioFft.h"
 #include "RDSComponent.h"
 #include "RadioScreen.h"
 #include "StereoIndicator.h"
@@ -181,6 +182,11 @@ class FMScreen : public RadioScreen, public CommonVerticalButtons::Mixin<FMScree
      */
     std::shared_ptr<StereoIndicator> stereoIndicator;
 
+    /**
+     * @brief Mini audio spektrum / oszcilloszkóp komponens
+     */
+    std::shared_ptr<MiniAudioFft> miniAudioFft;
+
     // ===================================================================
     // RDS komponens kezelés
     // ===================================================================
@@ -206,6 +212,11 @@ class FMScreen : public RadioScreen, public CommonVerticalButtons::Mixin<FMScree
             rdsComponent->clearRdsOnFrequencyChange();
         }
     }
+
+    /**
+     * @brief Seek befejezése után az RDS cache törlése (az új állomás adatai következnek)
+     */
+    void onSeekFinished() override { clearRDSCache(); }
 };
 
 #endif // __FM_SCREEN_H
\ No newline at end of file
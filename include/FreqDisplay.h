@@ -12,8 +12,10 @@
 #define __FREQDISPLAY_H
 
 #include <TFT_eSPI.h>
+#include <functional>
 
 #include "Config.h"
+#include "SevenSegmentGlyphCache.h"
 #include "Si4735Manager.h"
 #include "UIColorPalette.h"
 #include "UIComponent.h"
@@ -40,7 +42,7 @@ class FreqDisplay : public UIComponent {
   private:
     // === Referenciák és alapobjektumok ===
     Si4735Manager *pSi4735Manager;  ///< Hivatkozás a Si4735Manager objektumra
-    TFT_eSprite spr;                ///< Sprite objektum a 7-szegmenses rajzolásához    // === Színkonfigurációk ===
+    // === Színkonfigurációk ===
     FreqSegmentColors normalColors; ///< Színek normál módban
     FreqSegmentColors bfoColors;    ///< Színek BFO módban
     FreqSegmentColors customColors; ///< Egyedi színkonfiguráció (pl. képernyővédő módhoz)
@@ -51,6 +53,16 @@ class FreqDisplay : public UIComponent {
     bool hideUnderline;               ///< Ha true, az aláhúzás nem jelenik meg (képernyővédő mód)
     unsigned long lastUpdateTime;     ///< Utolsó frissítés ideje (villogás optimalizáláshoz)
     bool needsFullClear;              ///< Ha true, teljes háttér törlése szükséges
+    uint32_t lastDrawMicros;          ///< Az utolsó teljes rajzolás ideje (us)
+
+    SevenSegmentGlyphCache::Frame glyphFrame; ///< A 7-szegmenses terület utoljára kirajzolt képe (részleges rajzoláshoz)
+
+    // === Zero-beat jelző (SSB/CW) ===
+    bool zeroBeatShown;                    ///< Látszik-e a jelző (van aktív detektor)
+    bool zeroBeatTone;                     ///< Van-e mért hang
+    int16_t zeroBeatOffsetHz;              ///< A mért hang eltérése a célhangtól (Hz)
+    bool zeroBeatDirty;                    ///< Csak a jelzőt kell újrarajzolni
+    std::function<void()> zeroBeatHandler; ///< A jelző érintésekor hívódik (pl. BFO korrekció)
 
     /**
      * @brief Frekvencia megjelenítési adatok struktúrája
@@ -69,6 +81,18 @@ class FreqDisplay : public UIComponent {
     static constexpr int UNDERLINE_Y_OFFSET = 5;    ///< Aláhúzás távolsága a frekvenciától
     static constexpr int UNIT_Y_OFFSET_SSB_CW = 0; ///< Mértékegység Y eltolása SSB/CW képernyővédő módban (számok aljához igazítás)
 
+    // A 7-szegmenses sprite (SpritePool, 4 bites, csak ha a glyph atlasz nem tudja kirajzolni) paletta indexei
+    static constexpr uint8_t SPRITE_BACKGROUND_INDEX = 0;
+    static constexpr uint8_t SPRITE_INACTIVE_INDEX = 1;
+    static constexpr uint8_t SPRITE_ACTIVE_INDEX = 2;
+
+    // Zero-beat jelző: az aláhúzás sora alatt, a frekvencia bal szélénél (a mértékegység jobbra esik tőle)
+    static constexpr int ZERO_BEAT_X_OFFSET = 5;
+    static constexpr int ZERO_BEAT_Y_OFFSET = FREQ_7SEGMENT_HEIGHT + UNDERLINE_Y_OFFSET + UNDERLINE_HEIGHT + 3;
+    static constexpr int ZERO_BEAT_WIDTH = 110;      ///< "ZB -123 Hz" 2-es szövegmérettel
+    static constexpr int ZERO_BEAT_HEIGHT = 16;      ///< 2-es szövegméret magassága
+    static constexpr int ZERO_BEAT_TOLERANCE_HZ = 5; ///< Ezen belül a hang a célhangon van (zöld)
+
     // === Fő rajzolási metódusok ===
     /**
      * @brief Meghatározza a frekvencia formátumot és adatokat a mód alapján
@@ -143,6 +167,11 @@ class FreqDisplay : public UIComponent {
      */
     void drawFrequencySpriteWithSpaces(const FrequencyDisplayData &data, int x, int y, int width);
 
+    /**
+     * @brief Rajzolja a zero-beat jelzőt (SSB/CW módban, a frekvencia alatt)
+     */
+    void drawZeroBeat();
+
     // === Érintéskezelés ===
     int ssbCwTouchDigitAreas[3][2]; ///< Érintési területek: [digitIndex][0=x_start, 1=x_end]
 
@@ -195,6 +224,33 @@ class FreqDisplay : public UIComponent {
      */
     void setWidth(uint16_t newWidth);
 
+    /**
+     * @brief Az utolsó teljes rajzolás ideje (us) - pl. tekerési lépésenkénti rajzolási idő méréséhez
+     */
+    inline uint32_t getLastDrawMicros() const { return lastDrawMicros; }
+
+    /**
+     * @brief A 7-szegmenses glyph atlasz (közös) - pl. a kitolt pixelek számának méréséhez
+     */
+    static const SevenSegmentGlyphCache &getGlyphCache();
+
+    /**
+     * @brief A zero-beat jelző értékének beállítása (csak a jelző rajzolódik újra)
+     * @param hasTone Van-e mért hang
+     * @param offsetHz A hang eltérése a célhangtól (Hz; pozitív: a hang magasabb)
+     */
+    void setZeroBeat(bool hasTone, int16_t offsetHz);
+
+    /**
+     * @brief A zero-beat jelző elrejtése (nincs aktív detektor)
+     */
+    void hideZeroBeat();
+
+    /**
+     * @brief A zero-beat jelző érintésére hívott függvény beállítása
+     */
+    inline void setZeroBeatHandler(std::function<void()> handler) { zeroBeatHandler = handler; }
+
     /**
      * @brief Statikus szélességi konstansok különböző band típusokhoz
      */
@@ -205,6 +261,14 @@ class FreqDisplay : public UIComponent {
     // === UIComponent felülírt metódusok ===
     virtual void draw() override;
     virtual bool handleTouch(const TouchEvent &event) override;
+    virtual bool isRedrawNeeded() const override { return needsRedraw || zeroBeatDirty; }
+
+    /**
+     * @brief Újrarajzolásra jelölés kívülről (pl. dialóg bezárása, képernyő törlése után)
+     * @details A kijelzőn lévő kép ilyenkor nem biztos, hogy a legutóbb kirajzolt, ezért a 7-szegmenses terület
+     * teljesen újrarajzolódik. A frekvencia változása (setFrequency()) a részleges rajzolást megtartja.
+     */
+    virtual void markForRedraw(bool markChildren = false) override;
 };
 
 #endif // __FREQDISPLAY_H
@@ -0,0 +1,125 @@
+/**
+ * @file MiniAudioFft.h
+ * @brief Kis méretű audio spektrum / oszcilloszkóp / burkoló kijelző komponens (FM és AM képernyő)
+ * @details Az audio mintákat saját AudioCapture blokk fogyasztóként veszi (a pool blokkjaiból), a képet
+ * egy egyszer lefoglalt, újrahasznosított sprite-ba rajzolja és rögzített képkocka időközzel tolja ki a kijelzőre.
+ * A mód és az erősítés a konfigurációból jön (miniAudioFftModeAm/Fm, miniAudioFftConfigAm/Fm), auto gain
+ * beállításnál a blokkokkal érkező AudioAgc erősítés skáláz. Érintésre a következő módra vált.
+ */
+
+#ifndef __MINI_AUDIO_FFT_H
+#define __MINI_AUDIO_FFT_H
+
+#include "AudioDspStages.h"
+#include "AudioFft.h"
+#include "UIComponent.h"
+
+/**
+ * @brief Mini audio kijelző komponens
+ */
+class MiniAudioFft : public UIComponent {
+  public:
+    /**
+     * @brief Megjelenítési módok (a Config_t::miniAudioFftModeAm/Fm értékei)
+     */
+    enum class DisplayMode : uint8_t {
+        SpectrumLowRes = 0, ///< Oszlopos spektrum (kis FFT)
+        SpectrumHighRes,    ///< Pixelenkénti spektrum (nagy FFT)
+        Oscilloscope,       ///< Hullámforma, felfutó nullátmenetre triggerelve
+        Envelope,           ///< Görgetett amplitúdó burkoló
+        Count
+    };
+
+    static constexpr uint32_t FRAME_INTERVAL_MS = 40;   // Képkocka időköz (25 fps)
+    static constexpr uint16_t LOW_RES_FFT_SIZE = 256;   // SpectrumLowRes FFT méret
+    static constexpr uint16_t HIGH_RES_FFT_SIZE = 1024; // SpectrumHighRes FFT méret (egyben a mintapuffer mérete)
+    static constexpr uint8_t LOW_RES_BAR_PITCH = 4;     // Oszlop + rés szélessége pixelben
+
+    /**
+     * @brief Konstruktor
+     * @param tft TFT display referencia
+     * @param bounds Komponens határai (ekkora sprite-ot foglal)
+     * @param modeRef A módot tároló konfigurációs mező (érintésre ide írjuk vissza az új módot)
+     * @param gainConfigRef Az erősítés konfigurációs mező (-1.0f: kikapcsolva, 0.0f: auto, >0.0f: kézi szorzó)
+     * @param maxDisplayFrequencyHz A megjelenített legnagyobb hangfrekvencia (a mintavételi frekvencia ennek kétszerese)
+     */
+    MiniAudioFft(TFT_eSPI &tft, const Rect &bounds, uint8_t &modeRef, float &gainConfigRef, uint16_t maxDisplayFrequencyHz);
+
+    /**
+     * @brief Destruktor - a mintavételezés leállítása, a sprite és a pufferek felszabadítása
+     */
+    virtual ~MiniAudioFft();
+
+    // UIComponent interface implementáció
+    virtual void loop() override;
+    virtual void draw() override;
+
+    inline DisplayMode getMode() const { return mode; }
+
+    /**
+     * @brief Az utolsó képkocka feldolgozási + rajzolási ideje (us)
+     */
+    inline uint32_t getLastFrameMicros() const { return lastFrameMicros; }
+
+    /**
+     * @brief A képkocka idő mozgó átlaga (us)
+     */
+    inline uint32_t getAverageFrameMicros() const { return averageFrameMicros; }
+
+  protected:
+    virtual void onClick(const TouchEvent &event) override;
+
+  private:
+    uint8_t &modeRef;
+    float &gainConfigRef;
+    uint16_t maxDisplayFrequencyHz;
+    DisplayMode mode;
+
+    // Rajzolás
+    TFT_eSprite *sprite;
+    bool spriteCreated;
+    bool offScreenDrawn; // A kikapcsolt állapot képe már kint van
+
+    // Minták és FFT
+    AudioFft fft;
+    AudioWindow window;     // Hann ablak az aktuális FFT mérethez
+    int16_t *samples;       // Az utolsó HIGH_RES_FFT_SIZE minta (a legújabb a végén)
+    int16_t *fftInput;      // Ablakozott FFT bemenet
+    uint16_t *magnitudes;   // FFT kimenet (fftSize/2 bin)
+    uint8_t *envelope;      // Burkoló előzmény (bounds.width oszlop, gyűrűpuffer)
+    uint16_t envelopeHead;  // A következő írandó burkoló oszlop
+    uint16_t filledSamples; // Érvényes minták száma a pufferben
+    uint16_t newSamples;    // Az előző képkocka óta érkezett minták száma
+    uint32_t lastSequence;  // Az utolsó feldolgozott blokk sorszáma
+
+    // Időzítés és mérés
+    uint32_t lastFrameTime;
+    uint32_t processMicros;
+    uint32_t lastFrameMicros;
+    uint32_t averageFrameMicros;
+    uint16_t agcGainQ8;    // Az utolsó átvett blokk AGC erősítése (auto gain)
+    float frameScale;      // Az aktuális képkocka skálája: érték * frameScale -> 0..1
+    uint8_t blockConsumer; // AudioCapture blokk fogyasztó azonosító
+    bool captureStarted;   // A mintavételezést ez a komponens indította
+
+    bool isEnabled() const { return gainConfigRef >= 0.0f; }
+    uint32_t getSampleRate() const { // A mintavételező is ennyire korlátoz, a blokkok ezt a frekvenciát hordozzák
+        return constrain(static_cast<uint32_t>(maxDisplayFrequencyHz) * 2, (uint32_t)AUDIO_CAPTURE_SAMPLE_RATE_MIN, (uint32_t)AUDIO_CAPTURE_SAMPLE_RATE_MAX);
+    }
+    uint16_t getFftSize() const { return mode == DisplayMode::SpectrumHighRes ? HIGH_RES_FFT_SIZE : LOW_RES_FFT_SIZE; }
+
+    void allocateBuffers();
+    void releaseBuffers();
+    void consumeBlocks();
+    void processFrame();
+    float computeScale(uint32_t fullScale) const;
+
+    void renderSpectrumLowRes();
+    void renderSpectrumHighRes();
+    void renderOscilloscope();
+    void renderEnvelope();
+    void renderOffState();
+    void drawModeLabel();
+};
+
+#endif // __MINI_AUDIO_FFT_H
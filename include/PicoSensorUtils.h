@@ -3,7 +3,8 @@
 
 #include <Arduino.h>
 
-#include "defines.h" // PIN_VBUS
+#include "AudioCapture.h" // Az ADC foglaltságának ellenőrzéséhez
+#include "defines.h"      // PIN_VBUS
 
 namespace PicoSensorUtils {
 
@@ -50,6 +51,11 @@ inline float readVBus() {
         return sensorCache.vbusValue;
     }
 
+    // Audio mintavételezés közben az ADC foglalt, a legutóbbi értéket adjuk vissza
+    if (audioCapture.isAdcBusy()) {
+        return sensorCache.vbusValue;
+    }
+
     // Cache lejárt vagy nem érvényes, új mérés
     float voltageOut = (analogRead(PIN_VBUS_INPUT) * V_REFERENCE) / CONVERSION_FACTOR;
     float vbusVoltage = voltageOut * DIVIDER_RATIO;
@@ -74,6 +80,11 @@ inline float readCoreTemperature() {
         return sensorCache.temperatureValue;
     }
 
+    // Audio mintavételezés közben az ADC foglalt, a legutóbbi értéket adjuk vissza
+    if (audioCapture.isAdcBusy()) {
+        return sensorCache.temperatureValue;
+    }
+
     // Cache lejárt vagy nem érvényes, új mérés
     float temperature = analogReadTemp();
 
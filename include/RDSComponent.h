@@ -28,8 +28,10 @@ class RDSComponent : public UIComponent {
     static constexpr uint16_t RADIO_TEXT_AREA_HEIGHT = 20;
     static constexpr uint16_t DATETIME_AREA_HEIGHT = 20;
     static constexpr uint32_t RDS_UPDATE_INTERVAL_MS = 2000; // RDS frissítési időköz - 2 másodperc
-    static constexpr uint32_t SCROLL_INTERVAL_MS = 100;      // Scroll lépések közötti idő
+    static constexpr uint32_t SCROLL_INTERVAL_MS = 500;      // Scroll lépések közötti idő (az updateRDS() minden loop-ban fut)
     static constexpr uint8_t SCROLL_STEP_PIXELS = 2;         // Scroll lépés mérete pixelben
+    static constexpr uint8_t SCROLL_BACKGROUND_INDEX = 0;    // Scroll sprite (SpritePool, 4 bites) paletta: háttér
+    static constexpr uint8_t SCROLL_TEXT_INDEX = 1;          // Scroll sprite paletta: radio text
   private:
     Si4735Manager &si4735Manager;
 
@@ -63,7 +65,7 @@ class RDSComponent : public UIComponent {
     Rect dateTimeArea;
 
     // Radio text scroll kezelés
-    TFT_eSprite *scrollSprite;
+    TFT_eSprite *scrollSprite; // A SpritePool-tól kölcsönzött sprite
     int scrollOffset;
     uint16_t radioTextPixelWidth;
     bool needsScrolling;
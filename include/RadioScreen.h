@@ -7,7 +7,7 @@
  * - Seek (automatikus állomáskeresés) infrastruktúra
  * - Frekvencia kezelés és mentés
  * - Rádió-specifikus UI komponensek kezelése
- * - Közös callback rendszer a valós idejű seek frissítéshez
+ * - Nem blokkoló seek kezelés (a loop()-ból pollozva, rotary klikkel megszakítható)
  *
  * @author Rádió projekt
  * @version 1.0 - Refaktorált absztrakció
@@ -20,9 +20,6 @@
 #include "UIHorizontalButtonBar.h"
 #include "UIScreen.h"
 
-// Forward deklaráció a seek callback függvényhez
-void radioSeekProgressCallback(uint16_t frequency);
-
 /**
  * @brief Közös vízszintes gombsor gomb azonosítók
  * @details Minden RadioScreen alapú képernyő közös gombjai
@@ -53,9 +50,6 @@ static constexpr uint8_t SCAN_BUTTON = 52; ///< Scan (folyamatos keresés)
  */
 class RadioScreen : public UIScreen {
 
-    // Friend deklaráció a seek callback számára
-    friend void radioSeekProgressCallback(uint16_t frequency);
-
   public:
     // ===================================================================
     // Konstruktor és destruktor
@@ -106,6 +100,11 @@ class RadioScreen : public UIScreen {
      */
     virtual void activate() override;
 
+    /**
+     * @brief RadioScreen deaktiválása - a futó seek megszakítása
+     */
+    virtual void deactivate() override;
+
     /**
      * @brief Lehetőség a leszármazott osztályoknak további gombok hozzáadására
      * @param buttonConfigs A már meglévő gomb konfigurációk vektora
@@ -181,28 +180,42 @@ class RadioScreen : public UIScreen {
     // ===================================================================
 
     /**
-     * @brief Seek keresés indítása lefelé valós idejű frekvencia frissítéssel
-     * @details Beállítja a callback infrastruktúrát és indítja a seek-et
-     *
-     * Művelet:
-     * 1. Callback infrastruktúra beállítása
-     * 2. SI4735 seekStationProgress hívás SEEK_DOWN irányban
-     * 3. Valós idejű frekvencia frissítés a callback-en keresztül
-     * 4. Konfiguráció és band tábla frissítése
+     * @brief Seek keresés indítása lefelé
+     * @details Nem blokkol: a seek a háttérben fut, a processSeek() követi a loop()-ból.
+     * Futó seek esetén megszakítja azt.
      */
     void seekStationDown();
 
     /**
-     * @brief Seek keresés indítása felfelé valós idejű frekvencia frissítéssel
-     * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+     * @brief Seek keresés indítása felfelé
+     * @details Nem blokkol: a seek a háttérben fut, a processSeek() követi a loop()-ból.
+     * Futó seek esetén megszakítja azt.
+     */
+    void seekStationUp();
+
+    /**
+     * @brief Futó seek követése - a leszármazottak handleOwnLoop()-ja hívja
+     * @return true, ha seek fut (a hívó kihagyhatja a seek alatt értelmetlen frissítéseket, pl. RDS)
      *
      * Művelet:
-     * 1. Callback infrastruktúra beállítása
-     * 2. SI4735 seekStationProgress hívás SEEK_UP irányban
-     * 3. Valós idejű frekvencia frissítés a callback-en keresztül
-     * 4. Konfiguráció és band tábla frissítése
+     * 1. Si4735Manager::pollSeek() - legfeljebb 30ms-enként egy státusz olvasás
+     * 2. Frekvencia kijelző frissítése a seek haladásával
+     * 3. Befejezéskor: frekvencia mentése, memória státusz, onSeekFinished()
      */
-    void seekStationUp();
+    bool processSeek();
+
+    /**
+     * @brief Futó seek megszakítása rotary eseményre
+     * @return true, ha seek futott és az eseményt elfogyasztottuk
+     * @details Klikk megszakítja a seek-et; forgatás seek közben nem hangol (a chip épp keres).
+     */
+    bool abortSeekOnRotary(const RotaryEvent &event);
+
+    /**
+     * @brief Seek befejezése után hívódik (megtalált állomás, sávhatár, megszakítás)
+     * @details A leszármazottak felülírhatják (pl. FM: RDS cache törlése)
+     */
+    virtual void onSeekFinished() {}
 
     // ===================================================================
     // Rádió-specifikus utility metódusok
@@ -253,6 +266,9 @@ class RadioScreen : public UIScreen {
 
     /// Flag annak jelzésére, hogy az utolsó dialógus band dialógus volt-e
     bool lastDialogWasBandDialog = false;
+
+    /// A legutóbbi processSeek() hívásakor futott-e seek (a befejezés észleléséhez)
+    bool seekInProgress = false;
 };
 
 #endif //__RADIO_SCREEN_H
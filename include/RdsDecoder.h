@@ -0,0 +1,114 @@
+/**
+ * @file RdsDecoder.h
+ * @brief Helyi RDS csoport dekóder (0A/0B/2A/2B/4A)
+ * @details A Si4735 egyetlen FM_RDS_STATUS válaszából (A..D blokk + blokkonkénti hibaszint) dolgozik.
+ * A PS és RT szegmensenként érvényességi bittel épül fel: egy szegmens akkor érvényes, ha hibátlanul
+ * érkezett, vagy két egymást követő vétel azonos tartalmat adott. Csak teljes szöveg kerül publikálásra,
+ * így a zajos vétel nem "szemeteli" a kijelzőt.
+ */
+
+#ifndef __RDS_DECODER_H
+#define __RDS_DECODER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief RDS csoport dekóder rögzített méretű karakter pufferekkel
+ */
+class RdsDecoder {
+  public:
+    static constexpr uint8_t PS_LENGTH = 8;  ///< Program Service név hossza
+    static constexpr uint8_t RT_LENGTH = 64; ///< Radio Text maximális hossza (2A)
+    static constexpr uint8_t PTY_NONE = 255; ///< Még nincs érvényes PTY
+
+    /**
+     * @brief Blokk indexek a blocks[] / errors[] tömbökben
+     */
+    enum Block : uint8_t { BLOCK_A = 0, BLOCK_B, BLOCK_C, BLOCK_D, BLOCK_COUNT };
+
+    /**
+     * @brief Blokk hibaszintek (Si4735 BLEx mezők)
+     */
+    static constexpr uint8_t BLE_NONE = 0;          ///< Hibátlan blokk
+    static constexpr uint8_t BLE_CORRECTED = 1;     ///< 1-2 javított bit hiba
+    static constexpr uint8_t BLE_HEAVY = 2;         ///< 3-5 javított bit hiba
+    static constexpr uint8_t BLE_UNCORRECTABLE = 3; ///< Javíthatatlan blokk
+
+    /**
+     * @brief decodeGroup() visszatérési jelzői
+     */
+    static constexpr uint8_t CHANGED_PS = 0x01;
+    static constexpr uint8_t CHANGED_PTY = 0x02;
+    static constexpr uint8_t CHANGED_RT = 0x04;
+    static constexpr uint8_t CHANGED_CT = 0x08;
+    static constexpr uint8_t CHANGED_PI = 0x10; ///< Állomás váltás (új PI) - a korábbi adatok törlődtek
+
+    RdsDecoder() { reset(); }
+
+    /**
+     * @brief Minden dekódolt adat és részleges szegmens törlése (pl. állomásváltáskor)
+     */
+    void reset();
+
+    /**
+     * @brief Egy RDS csoport feldolgozása
+     * @param blocks A..D blokkok (16 bit)
+     * @param errors A..D blokkok hibaszintje (BLE_*)
+     * @return CHANGED_* jelzők - mely publikált adatok változtak
+     */
+    uint8_t decodeGroup(const uint16_t blocks[BLOCK_COUNT], const uint8_t errors[BLOCK_COUNT]);
+
+    inline uint16_t getPi() const { return pi; }
+    inline uint8_t getProgramType() const { return pty; }
+    inline const char *getProgramService() const { return ps; }
+    inline const char *getRadioText() const { return rt; }
+    inline bool hasDateTime() const { return ctValid; }
+
+    /**
+     * @brief Az utolsó érvényes CT (4A) helyi idő szerint
+     * @return true ha már érkezett érvényes dátum/idő
+     */
+    bool getDateTime(uint16_t &year, uint16_t &month, uint16_t &day, uint16_t &hour, uint16_t &minute) const;
+
+  private:
+    static constexpr uint8_t PS_SEGMENTS = PS_LENGTH / 2;
+    static constexpr uint8_t RT_SEGMENTS = 16;
+    static constexpr uint8_t RT_SEGMENT_NONE = 0xFF;
+    static constexpr uint8_t RT_END_MARK = 0x0D; ///< Radio Text vége karakter
+    static constexpr uint32_t MJD_MIN = 15079;   ///< A legkisebb MJD, amire a dátum képlet érvényes (1900.03.01)
+
+    // Publikált adatok
+    uint16_t pi;
+    uint8_t pty;
+    char ps[PS_LENGTH + 1];
+    char rt[RT_LENGTH + 1];
+    bool ctValid;
+    uint16_t ctYear;
+    uint8_t ctMonth;
+    uint8_t ctDay;
+    uint8_t ctHour;
+    uint8_t ctMinute;
+
+    // Részleges (összeállítás alatti) adatok
+    uint16_t piCandidate;
+    uint8_t ptyCandidate;
+    char psCandidate[PS_LENGTH];
+    uint8_t psValidMask; // Érvényes PS szegmensek (bitenként)
+    char rtCandidate[RT_LENGTH];
+    uint16_t rtValidMask; // Érvényes RT szegmensek (bitenként)
+    uint8_t rtAbFlag;     // Utolsó A/B jelző (0/1, 0xFF: még nincs)
+    uint8_t rtEndSegment; // A vége jelet tartalmazó szegmens (RT_SEGMENT_NONE: nincs)
+    bool rtVersionB;      // 2B csoport (32 karakter)
+
+    uint8_t decodePi(uint16_t blockPi, uint8_t error);
+    uint8_t decodeProgramService(uint16_t blockB, uint16_t blockD, uint8_t error);
+    uint8_t decodeRadioText(bool versionB, const uint16_t blocks[BLOCK_COUNT], const uint8_t errors[BLOCK_COUNT]);
+    uint8_t decodeClockTime(const uint16_t blocks[BLOCK_COUNT], const uint8_t errors[BLOCK_COUNT]);
+    uint8_t publishRadioText();
+    void resetRadioText();
+
+    static char toDisplayChar(uint8_t c);
+    static void mjdToDate(uint32_t mjd, uint16_t &year, uint8_t &month, uint8_t &day);
+};
+
+#endif // __RDS_DECODER_H
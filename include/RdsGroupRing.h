@@ -0,0 +1,80 @@
+/**
+ * @file RdsGroupRing.h
+ * @brief Nyers RDS csoportok lock-free (egy író, egy olvasó) gyűrűpuffere
+ * @details Az író a Si4735 RDS FIFO-ját üríti (Si4735Rds::drainRdsFifo()), az olvasó a dekóder
+ * (Si4735Rds::updateRdsDataWithCache()). Az indexeket mindig csak az egyik fél írja, így a puffer
+ * akkor is helyes marad, ha az író később megszakításba vagy a másik magra kerül.
+ */
+
+#ifndef __RDS_GROUP_RING_H
+#define __RDS_GROUP_RING_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "RdsDecoder.h"
+
+/**
+ * @brief Egy nyers RDS csoport (A..D blokk + blokkonkénti hibaszint)
+ */
+struct RdsRawGroup {
+    uint16_t blocks[RdsDecoder::BLOCK_COUNT];
+    uint8_t errors[RdsDecoder::BLOCK_COUNT];
+};
+
+/**
+ * @brief SPSC gyűrűpuffer RDS csoportokhoz
+ */
+class RdsGroupRing {
+  public:
+    static constexpr uint8_t CAPACITY = 32; ///< Kettő hatványa; ~2.8 másodpercnyi RDS forgalom (11.4 csoport/s)
+
+    RdsGroupRing() : head(0), tail(0), overflowCount(0) {}
+
+    /**
+     * @brief Csoport beírása (csak az író hívhatja)
+     * @return false, ha a puffer tele van (a csoport elveszett)
+     */
+    inline bool push(const RdsRawGroup &group) {
+        uint8_t h = head.load(std::memory_order_relaxed);
+        if (static_cast<uint8_t>(h - tail.load(std::memory_order_acquire)) >= CAPACITY) {
+            overflowCount++;
+            return false;
+        }
+        groups[h & MASK] = group;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief A legrégebbi csoport kivétele (csak az olvasó hívhatja)
+     * @return false, ha a puffer üres
+     */
+    inline bool pop(RdsRawGroup &group) {
+        uint8_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        group = groups[t & MASK];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Minden várakozó csoport eldobása (csak az olvasó hívhatja)
+     */
+    inline void flush() { tail.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    inline uint32_t getOverflowCount() const { return overflowCount; }
+
+  private:
+    static constexpr uint8_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "RdsGroupRing::CAPACITY must be a power of two");
+
+    RdsRawGroup groups[CAPACITY];
+    std::atomic<uint8_t> head; // Csak az író módosítja
+    std::atomic<uint8_t> tail; // Csak az olvasó módosítja
+    uint32_t overflowCount;    // Csak az író módosítja
+};
+
+#endif // __RDS_GROUP_RING_H
@@ -0,0 +1,184 @@
+/**
+ * @file RttyDecoder.h
+ * @brief Folyamatos RTTY (Baudot / ITA2 FSK) dekóder audio blokkokból
+ * @details A mark és space hangot egy-egy kvadratúra keverő és kétpólusú aluláteresztő (a baud
+ * sebességhez hangolt illesztett szűrő közelítés) választja le. A bit döntést automatikus küszöb
+ * (ATC: hangonkénti csúcs/alapszint követés) hozza meg, így szelektív fading mellett is működik.
+ * A keretezés aszinkron: start bit élére szinkronizál, a bit órát a karakteren belüli átmenetek
+ * finomhangolják, a hibás stop bitű karakterek eldobódnak. LTRS/FIGS váltás, szóköznél visszaváltás
+ * betűkre (USOS).
+ *
+ * A mark frekvencia és a shift a Config_t::rttyMarkFrequencyHz / rttyShiftHz értéke: LSB vételnél a
+ * space a mark + shift frekvencián van, USB vételnél a két hang felcserélődik (setInverted()).
+ *
+ * A dekóder a core1-en, a mintavételező blokk feldolgozójaként fut (AudioCapture::setBlockProcessor()),
+ * memóriát nem foglal; a dekódolt karaktereket SPSC soron adja át a core0-nak.
+ */
+
+#ifndef __RTTY_DECODER_H
+#define __RTTY_DECODER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "AudioCapture.h"
+#include "SpscQueue.h"
+#include "defines.h"
+
+/**
+ * @brief RTTY dekóder
+ */
+class RttyDecoder : public AudioBlockProcessor {
+  public:
+    /**
+     * @brief Támogatott adási sebességek
+     */
+    enum class BaudRate : uint8_t {
+        Baud45 = 0, ///< 45.45 Bd (amatőr szabvány)
+        Baud50,     ///< 50 Bd
+        Baud75,     ///< 75 Bd
+        Count
+    };
+
+    static constexpr uint16_t MIN_TONE_FREQUENCY = 300;  // Legkisebb elfogadott mark/space frekvencia (Hz)
+    static constexpr uint16_t MIN_SHIFT = 50;            // Legkisebb elfogadott shift (Hz)
+    static constexpr uint16_t MAX_SHIFT = 1000;          // Legnagyobb elfogadott shift (Hz)
+    static constexpr uint16_t MIN_SIGNAL_LEVEL = 24;     // Legkisebb hang amplitúdó csúcs (12 bites minta egység, az effektív erősítés után)
+    static constexpr uint8_t TEXT_QUEUE_SIZE = 64;       // Core1 -> core0 karakter sor mérete
+    static constexpr uint8_t CLOCK_CORRECTION_SHIFT = 2; // Bit óra korrekció: a fázishiba 1/4-e átmenetenként
+
+    RttyDecoder();
+
+    // ===================================================================
+    // Core0 oldal
+    // ===================================================================
+
+    /**
+     * @brief Mark frekvencia és shift beállítása (érvénytelen értéknél a defines.h alapértékei)
+     */
+    void setTones(float markFrequencyHz, float shiftHz);
+
+    /**
+     * @brief Adási sebesség beállítása
+     */
+    void setBaudRate(BaudRate baudRate);
+
+    /**
+     * @brief Mark/space felcserélése (USB vétel)
+     */
+    inline void setInverted(bool inverted) { requestedInverted.store(inverted, std::memory_order_release); }
+
+    /**
+     * @brief Erősítés beállítása (a minimális jelszint küszöbhöz)
+     * @param gainConfig 0.0f: az AudioAgc erősítése, >0.0f: kézi szorzó (Config_t::miniAudioFftConfigRtty)
+     */
+    inline void setGain(float gainConfig) { manualGainQ8.store(AudioAgc::toManualGainQ8(gainConfig), std::memory_order_relaxed); }
+
+    /**
+     * @brief Dekóder állapot törlésének kérése (pl. hangoláskor); a core1 a következő blokknál végzi el
+     */
+    inline void requestReset() { resetRequested.store(true, std::memory_order_release); }
+
+    /**
+     * @brief A következő dekódolt karakter kivétele
+     * @return false, ha nincs új karakter
+     */
+    bool popChar(char &c);
+
+    inline BaudRate getBaudRate() const { return static_cast<BaudRate>(requestedBaud.load(std::memory_order_relaxed)); }
+    inline uint16_t getMarkFrequency() const { return requestedMark.load(std::memory_order_relaxed); }
+    inline uint16_t getShift() const { return requestedShift.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Van-e dekódolható jel (mindkét hang szintje a küszöb felett)
+     */
+    inline bool isSignalPresent() const { return signalPresent.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Hibátlan keretű karakterek száma a legutóbbi törlés óta
+     */
+    inline uint32_t getCharCount() const { return charCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Hibás stop bitű (eldobott) karakterek száma a legutóbbi törlés óta
+     */
+    inline uint32_t getFramingErrorCount() const { return framingErrorCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief A sebesség megjelenítendő neve
+     */
+    static const char *getBaudRateLabel(BaudRate baudRate);
+
+    // ===================================================================
+    // Core1 oldal
+    // ===================================================================
+
+    /**
+     * @brief Egy audio blokk feldolgozása (AudioBlockProcessor)
+     */
+    virtual void processBlock(const int16_t *samples, uint16_t count, uint32_t sampleRate, uint16_t agcGainQ8) override;
+
+  private:
+    static constexpr uint16_t SINE_TABLE_SIZE = 256;
+
+    /**
+     * @brief Egy hang kvadratúra detektora
+     */
+    struct ToneFilter {
+        uint32_t phase;     // NCO fázis (teljes kör = 2^32)
+        uint32_t phaseStep; // NCO fázis lépés mintánként
+        int32_t i1, q1;     // Első aluláteresztő fokozat (<< 16 skálázva)
+        int32_t i2, q2;     // Második aluláteresztő fokozat (<< 16 skálázva)
+        int32_t peak;       // ATC: amplitúdó csúcs követés (<< 8)
+        int32_t floor;      // ATC: amplitúdó alapszint követés (<< 8)
+    };
+
+    enum class FrameState : uint8_t { WaitMark, WaitStart, StartBit, DataBits, StopBit };
+
+    // Core0 -> core1 kérések
+    std::atomic<uint16_t> requestedMark;
+    std::atomic<uint16_t> requestedShift;
+    std::atomic<uint8_t> requestedBaud;
+    std::atomic<bool> requestedInverted;
+    std::atomic<uint16_t> manualGainQ8; // 0: AGC
+    std::atomic<bool> resetRequested;
+
+    // Core1 -> core0 eredmények
+    SpscQueue<char, TEXT_QUEUE_SIZE> textQueue;
+    std::atomic<bool> signalPresent;
+    std::atomic<uint32_t> charCount;
+    std::atomic<uint32_t> framingErrorCount;
+
+    // Detektor (core1)
+    int16_t sineTable[SINE_TABLE_SIZE]; // Q15 szinusz
+    uint16_t markFrequency;
+    uint16_t shift;
+    uint8_t baud;
+    bool inverted;
+    uint32_t sampleRate;
+    int32_t filterAlphaQ15; // Aluláteresztő együttható
+    ToneFilter markFilter;
+    ToneFilter spaceFilter;
+
+    // Keretezés (core1), időzítés 1/256 minta egységben
+    int32_t bitLengthQ8;
+    int32_t bitCounterQ8;
+    FrameState frameState;
+    uint8_t bitIndex;
+    uint8_t code;
+    bool lastBit;
+    bool figures;
+    uint32_t chars;
+    uint32_t framingErrors;
+    int32_t qualityQ8; // Jelenlét mérték: |mark - space| / (mark + space), blokkonként simítva
+
+    void configure(uint32_t rate);
+    void resetDecoder();
+    void updatePresence(int32_t differenceSum, int32_t levelSum, uint16_t gainQ8);
+    int32_t processTone(ToneFilter &filter, int32_t sample);
+    void processBit(bool bit);
+    void emitCode(uint8_t baudotCode);
+    void emitChar(char c);
+};
+
+#endif // __RTTY_DECODER_H
@@ -0,0 +1,101 @@
+/**
+ * @file ScanBuffer.h
+ * @brief Spektrum scan mérési adatok tömör, structure-of-arrays tárolója
+ * @details Nyers RSSI/SNR bájtok és bitset jelzők (érvényes, állomás, skála vonal).
+ * A képernyő koordinátákra konvertálás csak rajzoláskor történik.
+ */
+
+#ifndef __SCANBUFFER_H
+#define __SCANBUFFER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Scan mérési pontok tárolója
+ * @details Pontonként 2 bájt + 3 bit, a korábbi öt párhuzamos tömb (~5.5 KB) helyett ~2.2 KB.
+ */
+class ScanBuffer {
+  public:
+    static constexpr uint16_t SIZE = 920; ///< Mintavételi pontok száma (2x a spektrum pixel szélessége)
+
+    ScanBuffer() { clear(); }
+
+    /**
+     * @brief Minden mért adat és jelző törlése
+     */
+    void clear();
+
+    /**
+     * @brief Mért pont tárolása (érvényesnek jelöli)
+     * @param pos Pont indexe
+     * @param rssi Átlagolt RSSI (dBuV)
+     * @param snr Átlagolt SNR (dB)
+     */
+    inline void set(uint16_t pos, uint8_t rssi, uint8_t snr) {
+        this->rssi[pos] = rssi;
+        this->snr[pos] = snr;
+        setBit(validBits, pos, true);
+    }
+
+    inline uint8_t getRssi(uint16_t pos) const { return rssi[pos]; }
+    inline uint8_t getSnr(uint16_t pos) const { return snr[pos]; }
+    inline bool isValid(uint16_t pos) const { return getBit(validBits, pos); }
+    inline bool isMarked(uint16_t pos) const { return getBit(markBits, pos); }
+    inline bool isScaleLine(uint16_t pos) const { return getBit(scaleBits, pos); }
+
+    inline void setMark(uint16_t pos, bool mark) { setBit(markBits, pos, mark); }
+    inline void setScaleLine(uint16_t pos, bool scale) { setBit(scaleBits, pos, scale); }
+
+    /**
+     * @brief Skála vonal jelzők törlése (zoom / tartomány váltás után)
+     */
+    void clearScaleLines();
+
+    /**
+     * @brief Adatok újramintavételezése szűkebb frekvencia tartományra (zoom in), helyben
+     * @param oldStartFreq Régi tartomány kezdete (kHz)
+     * @param oldStep Régi lépésköz (kHz)
+     * @param newStartFreq Új tartomány kezdete (kHz)
+     * @param newStep Új lépésköz (kHz), legfeljebb oldStep
+     * @details Legközelebbi szomszéd leképezés; ha a legközelebbi régi pont frekvenciája több mint
+     * fél régi lépésköznyire van, a cél pont üres marad (szellem adók elkerülése).
+     * A leképezés monoton, ezért a fixpont mentén két irányú bejárással segédtömb nélkül,
+     * felülírás nélkül végezhető. A skála vonal jelzőket törli.
+     */
+    void resampleInPlace(uint32_t oldStartFreq, float oldStep, uint32_t newStartFreq, float newStep);
+
+  private:
+    static constexpr uint16_t FLAG_WORDS = (SIZE + 31) / 32;
+
+    uint8_t rssi[SIZE];             ///< Nyers RSSI értékek
+    uint8_t snr[SIZE];              ///< Nyers SNR értékek
+    uint32_t validBits[FLAG_WORDS]; ///< Érvényes mért adat jelzők
+    uint32_t markBits[FLAG_WORDS];  ///< Állomás jelzők
+    uint32_t scaleBits[FLAG_WORDS]; ///< Skála vonal jelzők
+
+    static inline bool getBit(const uint32_t *bits, uint16_t pos) { return (bits[pos >> 5] >> (pos & 31)) & 1u; }
+    static inline void setBit(uint32_t *bits, uint16_t pos, bool value) {
+        if (value) {
+            bits[pos >> 5] |= (1u << (pos & 31));
+        } else {
+            bits[pos >> 5] &= ~(1u << (pos & 31));
+        }
+    }
+
+    /**
+     * @brief Egy pont adatainak (RSSI, SNR, érvényes, állomás) másolása
+     */
+    void copyEntry(uint16_t from, uint16_t to);
+
+    /**
+     * @brief Egy pont adatainak törlése
+     */
+    void clearEntry(uint16_t pos);
+
+    /**
+     * @brief Régi index számítása egy új indexhez (-1: nincs megfelelő régi pont)
+     */
+    static int16_t mapToOldPos(uint16_t newPos, uint32_t oldStartFreq, float oldStep, uint32_t newStartFreq, float newStep);
+};
+
+#endif // __SCANBUFFER_H
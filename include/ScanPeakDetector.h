@@ -0,0 +1,64 @@
+/**
+ * @file ScanPeakDetector.h
+ * @brief Csúcskeresés a spektrum scan adataiban
+ * @details Lokális maximumok keresése prominencia és minimális távolság alapján,
+ * így egy széles vivő egyetlen állomás jelöltet ad (a pontonkénti SNR jelölés helyett).
+ */
+
+#ifndef __SCANPEAKDETECTOR_H
+#define __SCANPEAKDETECTOR_H
+
+#include "ScanBuffer.h"
+
+/**
+ * @brief Scan csúcskereső
+ */
+class ScanPeakDetector {
+  public:
+    static constexpr uint8_t MAX_PEAKS = 40; ///< Maximálisan visszaadott csúcsok száma (= állomás tároló mérete)
+
+    /**
+     * @brief Egy talált csúcs
+     */
+    struct Peak {
+        uint16_t pos; ///< Pont index a scan pufferben
+        uint8_t rssi; ///< Csúcs RSSI (dBuV)
+        uint8_t snr;  ///< Legnagyobb SNR a csúcs környezetében
+    };
+
+    /**
+     * @brief Csúcskeresési paraméterek
+     */
+    struct Params {
+        uint16_t beginPos;     ///< Első vizsgált pont (sávon belül)
+        uint16_t endPos;       ///< Utolsó utáni pont
+        uint16_t minSpacing;   ///< Két csúcs közötti minimális távolság pontokban (sáv lépésközből)
+        uint8_t minProminence; ///< Minimális prominencia (dBuV) a környező völgyekhez képest
+        uint8_t minSnr;        ///< Minimális SNR a csúcs környezetében
+    };
+
+    /**
+     * @brief Csúcsok keresése
+     * @param data Scan adatok
+     * @param params Keresési paraméterek
+     * @param peaks Kimeneti tömb (legalább maxPeaks elem)
+     * @param maxPeaks A kimeneti tömb mérete (legfeljebb MAX_PEAKS)
+     * @return A talált csúcsok száma, pozíció szerint növekvő sorrendben
+     * @details Az erősebb csúcsok élveznek elsőbbséget: a minSpacing-en belül eső gyengébb csúcsok elvesznek.
+     * Érvénytelen (még nem mért) pontok völgyként viselkednek, azokon át nem terjed a prominencia.
+     */
+    static uint8_t findPeaks(const ScanBuffer &data, const Params &params, Peak *peaks, uint8_t maxPeaks);
+
+  private:
+    /**
+     * @brief Egy lokális maximum prominenciája (a magasabb szomszéd csúcsig tartó völgyek közül a magasabbik)
+     */
+    static uint8_t getProminence(const ScanBuffer &data, const Params &params, uint16_t pos);
+
+    /**
+     * @brief Legnagyobb SNR a csúcs +-minSpacing/2 környezetében
+     */
+    static uint8_t getPeakSnr(const ScanBuffer &data, const Params &params, uint16_t pos);
+};
+
+#endif // __SCANPEAKDETECTOR_H
@@ -8,6 +8,9 @@
 #define __SCANSCREEN_H
 
 #include "Config.h"
+#include "ScanBuffer.h"
+#include "ScanPeakDetector.h"
+#include "ScanWaterfall.h"
 #include "Si4735Manager.h"
 #include "UIButton.h"
 #include "UIHorizontalButtonBar.h"
@@ -67,21 +70,66 @@ class ScanScreen : public UIScreen {
     static constexpr uint8_t PLAY_PAUSE_BUTTON_ID = 41;
     static constexpr uint8_t ZOOM_IN_BUTTON_ID = 42;
     static constexpr uint8_t ZOOM_OUT_BUTTON_ID = 43;
-    static constexpr uint8_t RESET_BUTTON_ID = 44;    // Screen layout constants (480x320 display)
+    static constexpr uint8_t RESET_BUTTON_ID = 44;
+    static constexpr uint8_t VIEW_BUTTON_ID = 45;
+    static constexpr uint8_t STORE_BUTTON_ID = 46;    // Screen layout constants (480x320 display)
     static constexpr uint16_t SCAN_AREA_WIDTH = 460;  // Spektrum szélessége (pixelben)
-    static constexpr uint16_t SCAN_RESOLUTION = 920;  // Mintavételi pontok száma (2x felbontás)
+    static constexpr uint16_t SCAN_RESOLUTION = ScanBuffer::SIZE; // Mintavételi pontok száma (2x felbontás)
     static constexpr uint16_t SCAN_AREA_HEIGHT = 180; // Spektrum magassága
     static constexpr uint16_t SCAN_AREA_X = 10;       // Spektrum X pozíciója
     static constexpr uint16_t SCAN_AREA_Y = 40;       // Spektrum Y pozíciója
     static constexpr uint16_t SCALE_HEIGHT = 20;      // Skála magassága
     static constexpr uint16_t INFO_AREA_Y = 250;      // Info terület Y pozíciója (frekvencia címkék után)
 
+    // Sweep állapotgép időzítések (a loop() soha nem blokkolódik)
+    static constexpr uint32_t SWEEP_SETTLE_TIME_US = 5000;    // Minimális ráhangolódási idő, utána az STC bitet figyeljük (korábbi delay(5))
+    static constexpr uint32_t SWEEP_TUNE_TIMEOUT_US = 100000; // Ha az STC ennyi idő alatt sem áll be, mintavételezünk (ne akadjon el a sweep)
+    static constexpr uint32_t SWEEP_LOOP_BUDGET_US = 3000;    // Maximális munkaidő egy handleOwnLoop() hívásban
+    static constexpr uint32_t SWEEP_INFO_REFRESH_MS = 250;    // Info panel frissítési periódusa scan közben
+    static constexpr uint32_t SWEEP_RATE_WINDOW_MS = 1000;    // Pont/másodperc mérési ablak
+
+    // Adaptív mintavétel (early-exit) határai
+    static constexpr uint8_t SAMPLE_SNR_DECISION_MARGIN = 2; // SNR távolság a küszöbtől, ami már egyértelmű döntés
+    static constexpr uint8_t SAMPLE_NOISE_RSSI_MARGIN = 3;   // RSSI távolság a zajszinttől (dBuV), ami még zajnak számít
+    static constexpr uint8_t SAMPLE_MIN_STRONG_READS = 2;    // Erős jelnél ennyi egyező mérés kell a jelöléshez
+
+    // Csúcskeresés (állomás lista kinyerése a sweep-ből)
+    static constexpr uint8_t PEAK_MIN_PROMINENCE = 6; // Minimális kiemelkedés a környező völgyekhez képest (dBuV)
+
+    /**
+     * @brief A nem blokkoló sweep állapotgép fázisai
+     * @details Tune -> Settle (határidőre vár) -> Sample (mintánként egy I2C olvasás) -> Advance
+     */
+    enum class SweepPhase : uint8_t {
+        Tune,   ///< Frekvencia beállítása és settle határidő indítása
+        Settle, ///< Várakozás a határidőig - közben visszaadjuk a vezérlést
+        Sample, ///< RSSI/SNR minták gyűjtése
+        Advance ///< Pont tárolása, rajzolás, léptetés a következő pozícióra
+    };
+
+    /**
+     * @brief Egy spektrum pixel oszlop előre aggregált adatai
+     * @details Minta beérkezésekor az érintett oszlop frissül, zoom/reset esetén az egész újraépül,
+     * így a teljes újrarajzolás egyetlen menet a cache felett.
+     */
+    struct SpectrumColumn {
+        uint8_t rssi;  ///< Az oszlop érvényes pontjainak átlagolt RSSI-je (dBuV)
+        uint8_t snr;   ///< Az oszlop érvényes pontjainak átlagolt SNR-je
+        uint8_t flags; ///< COLUMN_* jelzők
+    };
+    static constexpr uint8_t COLUMN_HAS_DATA = 0x01;    // Van érvényes mért pont az oszlopban
+    static constexpr uint8_t COLUMN_STATION = 0x02;     // Van állomás jelölésű pont az oszlopban
+    static constexpr uint8_t COLUMN_SCALE = 0x04;       // Skála vonal esik az oszlopba
+    static constexpr uint8_t COLUMN_OUT_OF_BAND = 0x08; // Az oszlop átlagfrekvenciája a scan tartományon kívül esik
+
     // UI komponensek
     std::shared_ptr<UIButton> backButton;
     std::shared_ptr<UIButton> playPauseButton;
     std::shared_ptr<UIButton> zoomInButton;
     std::shared_ptr<UIButton> zoomOutButton;
     std::shared_ptr<UIButton> resetButton;
+    std::shared_ptr<UIButton> viewButton;
+    std::shared_ptr<UIButton> storeButton;
 
     // Scan állapot változók
     ScanState scanState;
@@ -96,23 +144,43 @@ class ScanScreen : public UIScreen {
     uint16_t currentScanPos;  // Aktuális pozíció a spektrumban
     uint8_t zoomGeneration;   // Zoom generációk száma (interpoláció limitáláshoz)
 
-    // RSSI/SNR adatok (nagyobb felbontással)
-    int16_t scanValueRSSI[SCAN_RESOLUTION]; // RSSI értékek
-    uint8_t scanValueSNR[SCAN_RESOLUTION];  // SNR értékek
-    bool scanMark[SCAN_RESOLUTION];         // Állomás jelzők
-    uint8_t scanScaleLine[SCAN_RESOLUTION]; // Skála vonalak
-    bool scanDataValid[SCAN_RESOLUTION];    // Érvényes adatok jelzői
+    // RSSI/SNR adatok (nagyobb felbontással, nyers értékek + bitset jelzők)
+    ScanBuffer scanData;
+    SpectrumColumn spectrumColumns[SCAN_AREA_WIDTH]; // Pixel oszloponkénti aggregátum cache
+
+    // Waterfall (idő × frekvencia) nézet
+    ScanWaterfall waterfall; // Utolsó sweep-ek kvantált RSSI sorai (a képernyővel együtt szabadul fel)
+    bool waterfallView;      // true: waterfall nézet, false: spektrum nézet
+    uint16_t waterfallFillX; // Az aktuális (head) sorban eddig beírt oszlopok száma
 
     // Sáv határok
-    int16_t scanBeginBand; // Sáv kezdete a spektrumban
-    int16_t scanEndBand;   // Sáv vége a spektrumban
-    uint8_t scanMarkSNR;   // SNR küszöb az állomás jelzéshez
-    bool scanEmpty;        // Üres scan (inicializálás)
+    int16_t scanBeginBand;   // Sáv kezdete a spektrumban
+    int16_t scanEndBand;     // Sáv vége a spektrumban
+    uint8_t scanMarkSNR;     // SNR küszöb az állomás jelzéshez
+    bool scanEmpty;          // Üres scan (inicializálás)
+    bool resumeAfterRestore; // Snapshot visszaállítás után a háttérben frissítő sweep indítása
 
     // Konfiguráció
-    uint8_t countScanSignal; // Jel mérések száma átlagoláshoz
+    uint8_t countScanSignal; // Jel mérések maximális száma átlagoláshoz (csak a küszöb közelében)
     float signalScale;       // Jel skálázási tényező
 
+    // Sweep állapotgép
+    SweepPhase sweepPhase;         // Aktuális fázis
+    uint32_t sweepSettleDeadline;  // Settle minimális határidő (micros), ezután STC polling
+    int16_t sweepRssiSum;          // Aktuális pont RSSI összege
+    int16_t sweepSnrSum;           // Aktuális pont SNR összege
+    uint8_t sweepSampleCount;      // Aktuális ponton eddig vett minták
+    uint32_t sweepRateWindowStart; // Pont/s mérési ablak kezdete (millis)
+    uint16_t sweepPointsInWindow;  // Az ablakban lemért pontok
+    uint16_t sweepPointsPerSecond; // Utolsó mért áteresztőképesség
+    uint32_t sweepMaxLoopTimeUs;   // Leghosszabb updateScan() munkaidő az aktuális sweep alatt
+    uint32_t lastInfoDrawTime;     // Info panel utolsó frissítése (millis)
+    uint8_t lastRssi;              // Info panelen megjelenített RSSI (dBuV)
+    uint8_t lastSnr;               // Info panelen megjelenített SNR
+    int16_t noiseFloorRssiQ4;      // Becsült zajszint RSSI (Q4 fixpontos, <0: még nincs becslés)
+    uint32_t sweepSignalReads;     // I2C jelminőség olvasások az aktuális sweep alatt
+    uint32_t sweepStartTime;       // Az aktuális teljes sweep kezdete (millis, 0: részleges sweep, nem mérjük)
+
     // UI állapot cache (villogás elkerülésére)
     String lastStatusText; // Előző státusz szöveg cache    // Metódusok
     void layoutComponents();
@@ -122,16 +190,39 @@ class ScanScreen : public UIScreen {
     void startScan();
     void pauseScan();
     void stopScan();
+    bool restoreSnapshot();
+    void saveSnapshot();
     void updateScan();
+    void commitScanPoint(uint8_t rssi, uint8_t snr);
+    void updateSweepRate();
+    void resetSweepStateMachine();
+    bool needsMoreSamples() const;
+    void updateNoiseFloor(int16_t rssi, uint8_t snr);
+    void readCursorSignal();
+    int16_t rssiToScreenY(int rssi) const;
     void drawSpectrum();
     void drawSpectrumLine(uint16_t x);
+    void updateScaleLines();
+    void updateSpectrumColumn(uint16_t pixelX);
+    void rebuildSpectrumColumns();
+    int16_t columnToScreenY(const SpectrumColumn &column) const;
+    void toggleWaterfallView();
+    void drawWaterfall();
+    void drawWaterfallRow(uint16_t line);
+    void drawWaterfallCell(uint16_t pixelX);
+    uint16_t getWaterfallCellColor(uint16_t line, uint16_t pixelX);
+    uint16_t getWaterfallRowHeight() const;
+    uint8_t detectPeaks(ScanPeakDetector::Peak *peaks, uint8_t maxPeaks);
+    void storeDetectedStations();
+    uint16_t snapToChannel(uint32_t scanFreq);
     void drawScale();
     void drawFrequencyLabels();
     void drawBandBoundaries();
     void drawScanInfoStatic();
     void drawScanInfo();
-    void getSignalQuality(int16_t &rssiY, uint8_t &snr);
+    void getSignalQuality(uint8_t &rssi, uint8_t &snr);
     void setFrequency(uint32_t freq);
+    void tuneFrequency(uint32_t freq);
     void calculateScanParameters();
     void zoomIn();
     void zoomOut();
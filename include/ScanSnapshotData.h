@@ -0,0 +1,27 @@
+#ifndef __SCANSNAPSHOTDATA_H
+#define __SCANSNAPSHOTDATA_H
+
+#include "ScanBuffer.h"
+
+// Snapshot-ban tárolt pontok száma: két szomszédos scan pontból egy (a spektrum pixel felbontása)
+#define SCAN_SNAPSHOT_POINTS (ScanBuffer::SIZE / 2)
+
+// Jelzők a tömörített adatokban
+#define SCAN_SNAPSHOT_NO_BAND 0xFF     // bandIndex: nincs mentett snapshot
+#define SCAN_SNAPSHOT_INVALID_SNR 0xFF // snr: a pont nem volt lemérve
+#define SCAN_SNAPSHOT_MARK_BIT 0x80    // rssi legfelső bitje: állomás jelölés (az RSSI 0..127 dBuV)
+
+/**
+ * @brief Egy scan tömörített formája (a RAM gyorsítótár és az EEPROM is ebben tárolja)
+ */
+struct ScanSnapshotData_t {
+    uint8_t bandIndex;                  // Sáv index (SCAN_SNAPSHOT_NO_BAND: üres)
+    uint8_t zoomGeneration;             // Zoom generáció
+    uint32_t startFreq;                 // Scan tartomány kezdete (scan egység)
+    uint32_t endFreq;                   // Scan tartomány vége (scan egység)
+    float zoomLevel;                    // Zoom szint
+    uint8_t rssi[SCAN_SNAPSHOT_POINTS]; // RSSI + állomás jelölés bit
+    uint8_t snr[SCAN_SNAPSHOT_POINTS];  // SNR (SCAN_SNAPSHOT_INVALID_SNR: nincs adat)
+};
+
+#endif // __SCANSNAPSHOTDATA_H
@@ -0,0 +1,124 @@
+/**
+ * @file ScanSnapshotStore.h
+ * @brief Spektrum scan snapshot-ok tárolása képernyőváltások (és opcionálisan újraindítás) között
+ * @details A ScreenManager minden váltáskor újra létrehozza a ScanScreen-t, ezért a legutóbbi sweep
+ * sávonként tömörítve (ScanSnapshotData_t) egy globális gyorsítótárba kerül. SCAN_SNAPSHOT_PERSIST esetén
+ * a képernyő elhagyásakor a snapshot az EEPROM store-ba is átkerül (a többi store-hoz hasonlóan CRC alapú checkSave()-vel).
+ */
+
+#ifndef __SCANSNAPSHOTSTORE_H
+#define __SCANSNAPSHOTSTORE_H
+
+#include "ScanBuffer.h"
+#include "ScanSnapshotData.h"
+#include "defines.h"
+
+#ifdef SCAN_SNAPSHOT_PERSIST
+#include "EepromLayout.h"
+#include "StoreBase.h"
+#endif
+
+/**
+ * @brief Egy sáv legutóbbi scan-je a zoom ablakkal együtt (gyorsítótár slot)
+ */
+struct ScanSnapshot {
+    bool used;               // Foglalt-e a slot
+    uint32_t lastUsed;       // LRU számláló
+    ScanSnapshotData_t data; // Tömörített scan adatok (ugyanaz a forma, mint az EEPROM-ban)
+};
+
+/**
+ * @brief Sávonkénti scan snapshot gyorsítótár (RAM, statikus foglalás)
+ */
+class ScanSnapshotCache {
+  public:
+    ScanSnapshotCache();
+
+    /**
+     * @brief Snapshot mentése (a sáv meglévő slotja, vagy a legrégebben használt slot íródik felül)
+     */
+    void store(uint8_t bandIndex, uint32_t startFreq, uint32_t endFreq, float zoomLevel, uint8_t zoomGeneration, const ScanBuffer &data);
+
+    /**
+     * @brief A sáv snapshot-ja
+     * @return A snapshot, vagy nullptr ha nincs (SCAN_SNAPSHOT_PERSIST esetén az EEPROM-ból is próbálkozik)
+     */
+    const ScanSnapshot *find(uint8_t bandIndex);
+
+    /**
+     * @brief A sáv snapshot-jának átadása az EEPROM store-nak (csak SCAN_SNAPSHOT_PERSIST esetén)
+     * @details Képernyő elhagyásakor hívandó, nem minden sweep után: a checkSave() CRC változásra ír.
+     */
+    void persist(uint8_t bandIndex);
+
+    /**
+     * @brief A sáv snapshot-jának törlése (pl. Reset után)
+     */
+    void invalidate(uint8_t bandIndex);
+
+    /**
+     * @brief Scan adatok tömörítése (két szomszédos pontból az érvényes és erősebb marad meg)
+     */
+    static void pack(const ScanBuffer &src, ScanSnapshotData_t &dst);
+
+    /**
+     * @brief Tömörített adatok kibontása (mindkét szomszédos pont ugyanazt az értéket kapja)
+     */
+    static void unpack(const ScanSnapshotData_t &src, ScanBuffer &dst);
+
+  private:
+    ScanSnapshot slots[SCAN_SNAPSHOT_SLOTS];
+    uint32_t useCounter;
+
+    ScanSnapshot *findSlot(uint8_t bandIndex);
+    ScanSnapshot *allocateSlot(uint8_t bandIndex);
+};
+
+#ifdef SCAN_SNAPSHOT_PERSIST
+/**
+ * @brief A legutóbbi scan snapshot EEPROM tárolója
+ */
+class ScanSnapshotStore : public StoreBase<ScanSnapshotData_t> {
+  public:
+    ScanSnapshotData_t data;
+
+  protected:
+    const char *getClassName() const override { return "ScanSnapshotStore"; }
+
+    ScanSnapshotData_t &getData() override { return data; }
+    const ScanSnapshotData_t &getData() const override { return data; }
+
+    uint16_t performSave() override { return StoreEepromBase<ScanSnapshotData_t>::save(getData(), EEPROM_SCAN_SNAPSHOT_ADDR, getClassName()); }
+
+    uint16_t performLoad() override { return StoreEepromBase<ScanSnapshotData_t>::load(getData(), EEPROM_SCAN_SNAPSHOT_ADDR, getClassName()); }
+
+  public:
+    ScanSnapshotStore() { loadDefaults(); }
+
+    void loadDefaults() override {
+        memset(&data, 0, sizeof(ScanSnapshotData_t));
+        data.bandIndex = SCAN_SNAPSHOT_NO_BAND;
+    }
+
+    /**
+     * @brief A mentett snapshot érvényes-e a megadott sávhoz
+     */
+    bool matches(uint8_t bandIndex) const { return data.bandIndex != SCAN_SNAPSHOT_NO_BAND && data.bandIndex == bandIndex && data.endFreq > data.startFreq; }
+
+    /**
+     * @brief A mentett snapshot törlése, ha a megadott sávhoz tartozik
+     */
+    void invalidate(uint8_t bandIndex) {
+        if (data.bandIndex == bandIndex) {
+            loadDefaults();
+        }
+    }
+};
+
+extern ScanSnapshotStore scanSnapshotStore;
+#endif
+
+// Globális példány deklarációja (definíció a .cpp fájlban)
+extern ScanSnapshotCache scanSnapshotCache;
+
+#endif // __SCANSNAPSHOTSTORE_H
@@ -0,0 +1,103 @@
+/**
+ * @file ScanWaterfall.h
+ * @brief Spektrum scan waterfall (idő × frekvencia) előzmény gyűrűpuffer
+ * @details Az utolsó N sweep kvantált (4 bites) RSSI sorait tárolja egy rögzített memória kereten belül.
+ * Minden sor megjegyzi a saját frekvencia tartományát, így zoom után is helyesen leképezhető.
+ */
+
+#ifndef __SCANWATERFALL_H
+#define __SCANWATERFALL_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Waterfall előzmény gyűrűpuffer
+ */
+class ScanWaterfall {
+  public:
+    static constexpr uint8_t LEVELS = 16;        ///< Kvantálási szintek száma (4 bit)
+    static constexpr uint8_t RSSI_PER_LEVEL = 4; ///< Ennyi dBuV esik egy szintre (0..63 dBuV tartomány)
+
+    /**
+     * @brief Egy sor metaadatai
+     */
+    struct LineInfo {
+        uint32_t startFreq; ///< A sor frekvencia tartományának kezdete (kHz)
+        uint32_t endFreq;   ///< A sor frekvencia tartományának vége (kHz)
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param width Egy sor oszlopainak száma
+     * @param maxLines Maximálisan megjeleníthető sorok száma
+     * @param memoryBudget Memória keret bájtban (adat + metaadat)
+     */
+    ScanWaterfall(uint16_t width, uint16_t maxLines, size_t memoryBudget);
+    ~ScanWaterfall();
+
+    /**
+     * @brief Sikerült-e a puffer lefoglalása
+     */
+    inline bool isAvailable() const { return data != nullptr; }
+
+    inline uint16_t getLineCount() const { return lineCount; }
+    inline uint16_t getHeadLine() const { return headLine; }
+    inline const LineInfo &getLineInfo(uint16_t line) const { return lineInfo[line]; }
+
+    /**
+     * @brief Az összes előzmény törlése
+     */
+    void clear();
+
+    /**
+     * @brief Az aktuális (head) sor újrakezdése új frekvencia tartománnyal
+     */
+    void restartLine(uint32_t startFreq, uint32_t endFreq);
+
+    /**
+     * @brief Egy oszlop értékének beírása az aktuális (head) sorba
+     * @param x Oszlop index
+     * @param rssi RSSI (dBuV), kvantálva tárolódik
+     */
+    void setColumn(uint16_t x, uint8_t rssi);
+
+    /**
+     * @brief A kész sor lezárása, a head továbbléptetése (a legrégebbi sor felülíródik)
+     * @param startFreq Az új sor frekvencia tartományának kezdete
+     * @param endFreq Az új sor frekvencia tartományának vége
+     */
+    void commitLine(uint32_t startFreq, uint32_t endFreq);
+
+    /**
+     * @brief Egy cella kvantált szintje (0: nincs adat / nincs jel)
+     */
+    inline uint8_t getLevel(uint16_t line, uint16_t x) const {
+        uint8_t packed = data[line * bytesPerLine + (x >> 1)];
+        return (x & 1) ? (packed >> 4) : (packed & 0x0F);
+    }
+
+    /**
+     * @brief RSSI kvantálása szintté
+     */
+    static inline uint8_t rssiToLevel(uint8_t rssi) {
+        uint8_t level = rssi / RSSI_PER_LEVEL;
+        return level >= LEVELS ? LEVELS - 1 : level;
+    }
+
+    /**
+     * @brief Szint RGB565 színe (fekete -> kék -> cián -> sárga -> piros)
+     */
+    static uint16_t levelToColor(uint8_t level);
+
+  private:
+    uint16_t width;
+    uint16_t bytesPerLine;
+    uint16_t lineCount;
+    uint16_t headLine;
+    uint8_t *data;
+    LineInfo *lineInfo;
+
+    void clearLine(uint16_t line);
+};
+
+#endif // __SCANWATERFALL_H
@@ -14,6 +14,8 @@
 #include "ScanScreen.h"
 #include "ScreenSaverScreen.h"
 #include "TestScreen.h"
+#include "TftDma.h"
+#include "UIProfiler.h"
 #include "UIScreen.h"
 #include "defines.h" // Képernyőnevekhez
 
@@ -113,7 +115,10 @@ class ScreenManager : public IScreenManager {
         if (it == screenFactories.end()) {
             DEBUG("ScreenManager: Screen factory not found for '%s'\n", screenName);
             return false;
-        } // Navigációs stack kezelése KÉPERNYŐVÁLTÁS ELŐTT - csak forward navigációnál
+        }
+        tftDma.fence(); // A váltás (deaktiválás, törlés) közvetlenül rajzol
+
+        // Navigációs stack kezelése KÉPERNYŐVÁLTÁS ELŐTT - csak forward navigációnál
         if (currentScreen && !isBackNavigation) {
             const char *currentName = currentScreen->getName();
 
@@ -212,11 +217,14 @@ class ScreenManager : public IScreenManager {
 
     // Touch esemény kezelése
     bool handleTouch(const TouchEvent &event) {
+        tftDma.noteInput();
+        tftDma.fence(); // Az eseménykezelők közvetlenül is rajzolhatnak
         if (currentScreen) {
             if (!STREQ(currentScreen->getName(), SCREEN_NAME_SCREENSAVER)) {
                 lastActivityTime = millis();
             }
             processingEvents = true;
+            UI_PROFILE_SCOPE(TouchDispatch);
             bool result = currentScreen->handleTouch(event);
             processingEvents = false;
             return result;
@@ -226,11 +234,14 @@ class ScreenManager : public IScreenManager {
 
     // Rotary encoder esemény kezelése
     bool handleRotary(const RotaryEvent &event) {
+        tftDma.noteInput();
+        tftDma.fence();
         if (currentScreen) {
             if (!STREQ(currentScreen->getName(), SCREEN_NAME_SCREENSAVER)) {
                 lastActivityTime = millis();
             }
             processingEvents = true;
+            UI_PROFILE_SCOPE(RotaryDispatch);
             bool result = currentScreen->handleRotary(event);
             processingEvents = false;
             return result;
@@ -256,6 +267,7 @@ class ScreenManager : public IScreenManager {
                 // lastActivityTime frissül, amikor a felhasználó újra interakcióba lép a képernyővédőn,
                 // és visszaváltáskor az immediateSwitch-ben.
             }
+            tftDma.fence(); // A képernyő loop-ja közvetlenül is rajzolhat
             currentScreen->loop();
         }
     }
@@ -265,7 +277,11 @@ class ScreenManager : public IScreenManager {
         if (currentScreen) {
             // Csak akkor rajzolunk, ha valóban szükséges
             if (currentScreen->isRedrawNeeded()) {
+                tftDma.fence();
+                tftDma.beginFrame(); // Képkocka idő és input-to-photon mérés (az utolsó DMA kitolás végéig)
+                UI_PROFILE_SCOPE(Frame);
                 currentScreen->draw();
+                tftDma.endFrame();
             }
         }
     }
@@ -0,0 +1,120 @@
+/**
+ * @file SevenSegmentGlyphCache.h
+ * @brief Előre feldolgozott 7-szegmenses (GFX free font) glyph atlasz a frekvencia kijelzőhöz
+ * @details A font bitképéből egyszer, az első használatkor kicsomagolja a kijelzőn előforduló karakterek
+ * ("0123456789 .-") glyph-jeit soronkénti 32 bites maszkokba. A maszkok színfüggetlenek, így egy színséma váltás
+ * (normál, BFO, képernyővédő) nem jár újrarendereléssel: a színek csak a kitoláskor kerülnek a pixelekbe.
+ *
+ * A kirajzolás ugyanazt a képet adja, mint a sprite-ba jobbra-alulra (BR_DATUM) igazított drawString() a
+ * maszkkal (inaktív szegmensek) és a szöveggel (aktív szegmensek). A kép felét a hívó Frame-je tárolja:
+ * ha csak a szöveg változott, csak azok az oszlopok kerülnek újra a kijelzőre, ahol egy glyph eltűnt vagy
+ * megjelent (tekerésnél jellemzően egy-két digit), a többi pixel a kijelzőn marad. A kitolás a TftDma-n át
+ * (DMA-val) történik; a hívó a saját közvetlen rajzolása előtt fence()-et hív.
+ */
+
+#ifndef __SEVEN_SEGMENT_GLYPH_CACHE_H
+#define __SEVEN_SEGMENT_GLYPH_CACHE_H
+
+#include <TFT_eSPI.h>
+
+#include "TftDma.h"
+
+/**
+ * @brief 7-szegmenses glyph atlasz és részleges kirajzoló
+ */
+class SevenSegmentGlyphCache {
+  public:
+    static constexpr const char *CHARSET = "0123456789 .-"; // Az atlaszban tárolt karakterek
+    static constexpr uint8_t MAX_GLYPHS = 13;               // = strlen(CHARSET)
+    static constexpr uint8_t MAX_HEIGHT = 40;               // A legnagyobb kirajzolási magasság (pixel)
+    static constexpr uint8_t MAX_TEXT_LENGTH = 15;          // A maszk és a szöveg legnagyobb hossza
+    static constexpr uint8_t CHUNK_WIDTH = 32;              // Egy kitolás legnagyobb szélessége (egy sor maszk = 32 bit)
+    static_assert(CHUNK_WIDTH * MAX_HEIGHT <= TftDma::BUFFER_PIXELS, "Egy csíknak el kell férnie a TftDma staging pufferében");
+
+    /**
+     * @brief Színek (RGB565)
+     */
+    struct Colors {
+        uint16_t background;
+        uint16_t inactive;
+        uint16_t active;
+    };
+
+    /**
+     * @brief Egy kijelzési hely utoljára kirajzolt képe (a hívó tárolja, helyenként egyet)
+     */
+    struct Frame {
+        bool valid = false; // false: a következő rajzolás teljes (pl. a terület törlése után)
+        int16_t x = 0;
+        int16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        Colors colors = {0, 0, 0};
+        bool showMask = false;
+        char mask[MAX_TEXT_LENGTH + 1] = {0};
+        char text[MAX_TEXT_LENGTH + 1] = {0};
+
+        inline void invalidate() { valid = false; }
+    };
+
+    /**
+     * @brief Konstruktor (az atlasz az első rajzoláskor épül fel)
+     * @param font A 7-szegmenses GFX free font
+     */
+    explicit SevenSegmentGlyphCache(const GFXfont &font);
+
+    /**
+     * @brief Maszk és szöveg kirajzolása jobbra-alulra igazítva a (x, y, width, height) területre
+     * @param frame A terület előző képe (frissül)
+     * @param showMask Kirajzolódjanak-e az inaktív szegmensek (config.data.tftDigitLigth)
+     * @return false, ha a maszk vagy a szöveg az atlaszban nem szereplő karaktert tartalmaz, túl hosszú, vagy a
+     *         terület túl magas; ilyenkor semmi nem rajzolódott és a frame érvénytelen (a hívó maga rajzol)
+     */
+    bool draw(Frame &frame, int16_t x, int16_t y, uint16_t width, uint16_t height, const char *mask, const char *text, const Colors &colors, bool showMask);
+
+    // Mérés (pl. tekerési lépésenként kitolt pixelek)
+    inline uint32_t getPushedPixels() const { return pushedPixels; }
+    inline uint32_t getFullDraws() const { return fullDraws; }
+    inline uint32_t getPartialDraws() const { return partialDraws; }
+
+  private:
+    /**
+     * @brief Egy glyph az atlaszban
+     */
+    struct Glyph {
+        int8_t left;    // A bitkép bal széle a kurzorhoz képest (xOffset)
+        uint8_t width;  // A bitkép szélessége
+        int8_t top;     // A bitkép teteje az alapvonalhoz képest (yOffset, negatív)
+        uint8_t height; // A bitkép magassága
+        uint8_t advance;
+        uint32_t rows[MAX_HEIGHT]; // Soronkénti maszk, 0. bit = bal szélső oszlop
+    };
+
+    /**
+     * @brief Egy glyph elhelyezése a területen
+     */
+    struct Placement {
+        int16_t x; // A bitkép bal széle a terület bal széléhez képest
+        uint8_t glyph;
+    };
+
+    const GFXfont &font;
+    Glyph glyphs[MAX_GLYPHS];
+    bool built;
+    bool usable;     // Minden karakter benne van a fontban és elfér az atlaszban
+    int16_t descent; // Az alapvonal alatti legnagyobb kiterjedés (TFT_eSPI glyph_bb)
+
+    uint32_t pushedPixels;
+    uint32_t fullDraws;
+    uint32_t partialDraws;
+
+    void build();
+    static int8_t findGlyph(char c);
+    uint16_t textWidth(const char *text) const;
+    uint8_t layout(const char *text, uint16_t areaWidth, Placement *placements) const;
+    void pushColumns(const Frame &frame, const Placement *maskPlacements, uint8_t maskCount, const Placement *textPlacements, uint8_t textCount, int16_t from,
+                     int16_t to);
+    void composeLayer(uint32_t *layerRows, const Placement *placements, uint8_t count, int16_t chunkX, uint8_t chunkWidth, int16_t baseline) const;
+};
+
+#endif // __SEVEN_SEGMENT_GLYPH_CACHE_H
@@ -58,6 +58,12 @@ class Si4735Band : public Si4735Runtime, public Band {
      */
     void tuneMemoryStation(uint8_t bandIndex, uint16_t frequency, uint8_t demodModIndex, uint8_t bandwidthIndex);
 
+    /**
+     * @brief Az aktuális demodulációs módhoz tartozó sávszélesség index a konfigból (a tuneMemoryStation() párja)
+     * @return A memória állomásba menthető sávszélesség index
+     */
+    uint8_t getCurrentBandwidthIndex();
+
     /**
      * @brief A frekvencia léptetése a rotary encoder értéke alapján
      * @param rotaryValue A rotary encoder értéke (növelés/csökkentés)
@@ -25,13 +25,30 @@ static constexpr int SI4735_MAX_ATTENNUATOR_AM = 37; // AM/SSB: 0-37+ATTN_BACKUP
 
 }; // namespace Si4735Constants
 
+/**
+ * @brief Az SI4735 könyvtár osztály minimális kiterjesztése
+ * @details A könyvtár az utolsó FM_RDS_STATUS választ (állapot, A..D blokk, blokk hibaszintek) és az utolsó
+ * FM/AM_TUNE_STATUS választ protected tagban tárolja. Ezeket tesszük olvashatóvá, így egyetlen lekérdezésből
+ * dolgozhat a saját RDS dekóder, és a tune status frekvenciája is kiolvasható (a getFrequency() CANCEL=1-gyel
+ * kérdez, ami egy futó seek-et megállítana).
+ */
+class Si4735Device : public SI4735 {
+  public:
+    inline const si47x_rds_status &getRdsResponse() const { return currentRdsStatus; }
+
+    /**
+     * @brief Az utolsó getStatus() válaszában szereplő frekvencia
+     */
+    inline uint16_t getStatusFrequency() const { return (static_cast<uint16_t>(currentStatus.resp.READFREQH) << 8) | currentStatus.resp.READFREQL; }
+};
+
 /**
  * @brief Si4735Base osztály
  */
 class Si4735Base {
 
   protected:
-    SI4735 si4735;
+    Si4735Device si4735;
 
   public:
     Si4735Base() {}
@@ -7,6 +7,21 @@
 class Si4735Manager : public Si4735Rds {
 
   public:
+    /**
+     * @brief Nem blokkoló seek eseményei (pollSeek() visszatérési értéke)
+     */
+    enum class SeekEvent : uint8_t {
+        None,      // Nincs változás (vagy nincs aktív seek)
+        Progress,  // A seek frekvenciája változott
+        Found,     // Állomást talált (STC, VALID)
+        BandLimit, // Sávhatárt ért el állomás nélkül
+        Cancelled, // cancelSeek() megszakította
+        Timeout    // SEEK_TIMEOUT_MS alatt nem fejeződött be
+    };
+
+    static constexpr uint32_t SEEK_POLL_INTERVAL_MS = 30; // STC/frekvencia lekérdezés periódusa seek közben
+    static constexpr uint32_t SEEK_TIMEOUT_MS = 8000;     // Maximális seek idő (a library alapértelmezett maxSeekTime értéke)
+
     /**
      * @brief Konstruktor, amely inicializálja a Si4735 eszközt.
      * @param band A Band objektum, amely kezeli a rádió sávokat.
@@ -24,6 +39,44 @@ class Si4735Manager : public Si4735Rds {
      * Ez a függvény folyamatosan figyeli a squelch állapotát és kezeli a hardver némítást.
      */
     void loop();
+
+    /**
+     * @brief Nem blokkoló seek indítása
+     * @param seekUp true: felfelé, false: lefelé
+     * @return false, ha a seek nem indítható (SSB/CW mód, vagy már fut egy seek)
+     * @details Csak a seek parancsot küldi ki; a befejezést a pollSeek() figyeli az STC bit alapján.
+     */
+    bool startSeek(bool seekUp);
+
+    /**
+     * @brief Az aktív seek állapotának lekérdezése (a loop()-ból hívandó)
+     * @return A seek eseménye; befejező esemény (Found, BandLimit, Timeout) csak egyszer érkezik
+     * @details Legfeljebb SEEK_POLL_INTERVAL_MS-enként egyetlen státusz olvasás. Befejezéskor a band tábla frekvenciája frissül.
+     */
+    SeekEvent pollSeek();
+
+    /**
+     * @brief Az aktív seek megszakítása (a chip az aktuális frekvencián marad)
+     */
+    void cancelSeek();
+
+    inline bool isSeeking() const { return seekActive; }
+
+    /**
+     * @brief A seek aktuális (utoljára kiolvasott) frekvenciája
+     */
+    inline uint16_t getSeekFrequency() const { return seekFrequency; }
+
+  private:
+    bool seekActive = false;    // Fut-e seek
+    uint32_t seekStartTime = 0; // Seek indítási ideje (millis)
+    uint32_t lastSeekPoll = 0;  // Utolsó státusz olvasás ideje (millis)
+    uint16_t seekFrequency = 0; // Utoljára kiolvasott frekvencia
+
+    /**
+     * @brief Seek lezárása: frekvencia mentése a band táblába
+     */
+    void finishSeek(uint16_t frequency);
 };
 
-#endif // __Si4735_MANAGER_H
\ No newline at end of file
+#endif // __Si4735_MANAGER_H
@@ -2,6 +2,8 @@
 #define __SI4735_RDS_H
 
 #include "Band.h"
+#include "RdsDecoder.h"
+#include "RdsGroupRing.h"
 #include "Si4735Band.h"
 #include "utils.h"
 
@@ -29,120 +31,139 @@ class Si4735Rds : public Si4735Band {
     // String getCurrentRdsProgramService();
 
     /**
-     * @brief Lekérdezi az RDS állomásnevet (Program Service)
-     * @return String Az RDS állomásnév, vagy üres string ha nem elérhető
+     * @brief Ellenőrzi, hogy elérhető-e RDS adat
+     * @details Nem küld I2C parancsot: az utolsó drainRdsFifo() lekérdezés szinkron állapotát adja vissza.
+     * @return true ha van szinkronizált RDS vétel
      */
-    String getRdsStationName();
+    bool isRdsAvailable();
+
+    // ===================================================================
+    // RDS dekódolás és cache
+    // ===================================================================
 
     /**
-     * @brief Lekérdezi az RDS program típus kódot (PTY)
-     * @return uint8_t Az RDS program típus kódja (0-31), vagy 255 ha nincs RDS
+     * @brief A Si4735 RDS FIFO ürítése a csoport gyűrűpufferbe (író oldal)
+     * @details Az RDS-t megjelenítő képernyő loop-ja hívja. RDS_FIFO_POLL_INTERVAL_MS-enként egy állapot lekérdezés
+     * (az RDSRECV nyugtázásával), ami megadja a FIFO-ban várakozó csoportok számát (RDSFIFOUSED); ennyi csoportot olvas ki,
+     * csoportonként egy tranzakcióval (A..D blokk + hibaszintek). Dekódolás itt nem történik.
      */
-    uint8_t getRdsProgramTypeCode();
+    void drainRdsFifo();
 
     /**
-     * @brief Lekérdezi az RDS radio text üzenetet
-     * @return String Az RDS radio text, vagy üres string ha nem elérhető
+     * @brief A gyűrűpufferben várakozó csoportok dekódolása, a cache frissítése (olvasó oldal)
+     * @details I2C forgalmat nem generál, így a UI minden ciklusban hívhatja.
+     * @return true ha változtak a megjelenítendő adatok
      */
-    String getRdsRadioText();
+    bool updateRdsDataWithCache();
 
     /**
-     * @brief Lekérdezi az RDS dátum és idő információt
-     * @param year Referencia a év tárolásához
-     * @param month Referencia a hónap tárolásához
-     * @param day Referencia a nap tárolásához
-     * @param hour Referencia az óra tárolásához
-     * @param minute Referencia a perc tárolásához
-     * @return true ha sikerült lekérdezni a dátum/idő adatokat
+     * @brief Az utolsó cache törlés (hangolás) és az első érvényes PS között eltelt idő
+     * @return Idő milliszekundumban, 0 ha még nem érkezett PS
      */
-    bool getRdsDateTime(uint16_t &year, uint16_t &month, uint16_t &day, uint16_t &hour, uint16_t &minute);
+    inline uint32_t getRdsTimeToFirstPs() const { return timeToFirstPsMs; }
 
     /**
-     * @brief Ellenőrzi, hogy elérhető-e RDS adat
-     * @return true ha van érvényes RDS vétel
+     * @brief Az utolsó lezárt egy perces ablakban kiolvasott RDS csoportok száma
      */
-    bool isRdsAvailable();
-
-    // ===================================================================
-    // Adaptív cache és időzítési funkcionalitás
-    // ===================================================================
+    inline uint16_t getRdsGroupsPerMinute() const { return groupsPerMinute; }
 
     /**
-     * @brief RDS adatok frissítése adaptív időzítéssel és cache-eléssel
-     * @return true ha változtak az adatok
+     * @brief Elveszett csoportok száma (chip FIFO túlcsordulás + gyűrűpuffer túlcsordulás)
      */
-    bool updateRdsDataWithCache();
+    inline uint32_t getRdsLostGroups() const { return chipGroupsLost + rdsGroupRing.getOverflowCount(); }
 
     /**
      * @brief Cache-elt RDS állomásnév lekérdezése
-     * @return String A cache-elt állomásnév
+     * @return A cache-elt állomásnév (üres, ha nincs)
      */
-    String getCachedStationName() const { return cachedStationName; }
+    const char *getCachedStationName() const { return cachedStationName; }
 
     /**
      * @brief Cache-elt RDS program típus lekérdezése
-     * @return String A cache-elt program típus
+     * @return A cache-elt program típus (üres, ha nincs)
      */
-    String getCachedProgramType() const { return cachedProgramType; }
+    const char *getCachedProgramType() const { return cachedProgramType; }
 
     /**
      * @brief Cache-elt RDS radio text lekérdezése
-     * @return String A cache-elt radio text
+     * @return A cache-elt radio text (üres, ha nincs)
      */
-    String getCachedRadioText() const { return cachedRadioText; }
+    const char *getCachedRadioText() const { return cachedRadioText; }
 
     /**
      * @brief Cache-elt RDS dátum lekérdezése
-     * @return String A cache-elt dátum
+     * @return A cache-elt dátum (üres, ha nincs)
      */
-    String getCachedDate() const { return cachedDate; }
+    const char *getCachedDate() const { return cachedDate; }
 
     /**
      * @brief Cache-elt RDS idő lekérdezése
-     * @return String A cache-elt idő
+     * @return A cache-elt idő (üres, ha nincs)
      */
-    String getCachedTime() const { return cachedTime; }
+    const char *getCachedTime() const { return cachedTime; }
 
     /**
      * @brief Cache-elt RDS dátum/idő lekérdezése (kompatibilitás)
-     * @return String A cache-elt dátum/idő
+     * @return A cache-elt "dátum idő" (üres, ha nincs)
      */
-    String getCachedDateTime() const {
-        if (!cachedDate.isEmpty() && !cachedTime.isEmpty()) {
-            return cachedDate + " " + cachedTime;
-        }
-        return cachedDate.isEmpty() ? cachedTime : cachedDate;
-    }
+    const char *getCachedDateTime() const { return cachedDateTime; }
 
     /**
-     * @brief Cache törlése (pl. állomásváltáskor)
+     * @brief Cache és dekóder törlése (pl. állomásváltáskor)
      */
     void clearRdsCache();
 
     /**
      * @brief PTY kód szöveges leírássá alakítása
      * @param ptyCode A PTY kód (0-31)
-     * @return String A PTY szöveges leírása
+     * @return A PTY szöveges leírása
      */
-    String convertPtyCodeToString(uint8_t ptyCode);
-
-  private: // RDS cache változók
-    String cachedStationName;
-    String cachedProgramType;
-    String cachedRadioText;
-    String cachedDate;
-    String cachedTime;
+    const char *convertPtyCodeToString(uint8_t ptyCode);
+
+  private:
+    static constexpr uint8_t DATE_BUFFER_SIZE = 11; // "2025.06.14"
+    static constexpr uint8_t TIME_BUFFER_SIZE = 6;  // "15:30"
+
+    // RDS dekóder, csoport puffer és a legutolsó lekérdezés állapota
+    RdsDecoder rdsDecoder;
+    RdsGroupRing rdsGroupRing;
+    bool rdsSync = false;
+    uint32_t lastRdsFifoPoll = 0; // Utolsó FIFO ellenőrzés ideje (millis)
+
+    // Statisztika
+    uint32_t rdsCacheClearTime = 0; // Utolsó cache törlés (hangolás) ideje (millis)
+    uint32_t timeToFirstPsMs = 0;   // Hangolástól az első PS-ig eltelt idő (0: még nincs)
+    uint32_t groupWindowStart = 0;  // Csoport számláló ablak kezdete (millis)
+    uint16_t groupWindowCount = 0;  // Az aktuális ablakban kiolvasott csoportok
+    uint16_t groupsPerMinute = 0;   // Az utolsó lezárt ablak csoport/perc értéke
+    uint32_t chipGroupsLost = 0;    // A chip által jelzett elveszett csoportok (GRPLOST)
+
+    // RDS cache (rögzített méretű pufferek)
+    char cachedStationName[RdsDecoder::PS_LENGTH + 1];
+    const char *cachedProgramType;
+    char cachedRadioText[RdsDecoder::RT_LENGTH + 1];
+    char cachedDate[DATE_BUFFER_SIZE];
+    char cachedTime[TIME_BUFFER_SIZE];
+    char cachedDateTime[DATE_BUFFER_SIZE + TIME_BUFFER_SIZE];
 
     // Időzítés változók
-    uint32_t lastRdsUpdate = 0;
     uint32_t lastValidRdsData = 0;
 
-    // Adaptív frissítési intervallumok (milliszekundum)
-    static const uint32_t RDS_UPDATE_INTERVAL_FAST = 1000; // 1 másodperc új állomás esetén
-    static const uint32_t RDS_UPDATE_INTERVAL_SLOW = 3000; // 3 másodperc stabil állomás esetén
+    // FIFO ellenőrzés periódusa: a csoport idő (~88 ms) fele, így a chip FIFO sosem telik meg
+    static const uint32_t RDS_FIFO_POLL_INTERVAL_MS = 40;
+
+    // Egy ürítésben kiolvasott csoportok felső korlátja (a chip FIFO mérete)
+    static const uint8_t RDS_MAX_GROUPS_PER_DRAIN = 25;
+
+    // Csoport/perc mérési ablak
+    static const uint32_t RDS_GROUP_RATE_WINDOW_MS = 60000;
 
     // Timeout értékek (milliszekundum)
     static const uint32_t RDS_DATA_TIMEOUT = 120000; // 120 másodperc
+
+    void clearCachedText();
+    bool updateCachedText(uint8_t decoderChanges);
+    void updateGroupRate(uint32_t currentTime);
 };
 
 #endif // __SI4735_RDS_H
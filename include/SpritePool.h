@@ -0,0 +1,83 @@
+/**
+ * @file SpritePool.h
+ * @brief Tartós, közös sprite pool a komponensek rajzolásához (rajzolásonkénti create/delete helyett)
+ * @details A komponensek rajzoláskor kölcsönkérnek (lease()) egy adott méretű és színmélységű sprite-ot, majd
+ * a kitolás után visszaadják (release()). A pool a sprite puffereket nem szabadítja fel: a következő azonos
+ * méretű kérés ugyanazt a puffert kapja, így pl. tekerés közben nincs lépésenkénti heap foglalás és töredezés.
+ * Új puffer csak akkor foglalódik, ha nincs szabad, pontosan egyező sprite; ilyenkor egy még nem használt hely,
+ * vagy a legrégebben visszaadott szabad sprite kerül (újra)foglalásra (sávváltás, képernyőváltás).
+ *
+ * A sprite-ok pontos méretűek, így a kitolás (pushSprite()) a teljes sprite-ot viszi ki. 4 bites színmélységnél
+ * a sprite palettás: a színek a paletta indexei, a palettát a kölcsönző állítja be (setPaletteColor()); egy 208x38-as
+ * frekvencia sprite így ~4 kB a 16 bites ~16 kB helyett. A sprite állapotát (font, szín, datum) a kölcsönző
+ * minden használatkor maga állítja be.
+ */
+
+#ifndef __SPRITE_POOL_H
+#define __SPRITE_POOL_H
+
+#include <TFT_eSPI.h>
+
+/**
+ * @brief Sprite pool
+ */
+class SpritePool {
+  public:
+    static constexpr uint8_t MAX_SPRITES = 4; // Egyszerre létező sprite-ok legnagyobb száma
+
+    /**
+     * @brief Konstruktor (a sprite-ok az első kéréskor jönnek létre)
+     * @param tft A TFT, amire a sprite-ok kitolódnak
+     */
+    explicit SpritePool(TFT_eSPI &tft);
+
+    /**
+     * @brief Sprite kölcsönkérése
+     * @param width Szélesség (pixel)
+     * @param height Magasság (pixel)
+     * @param colorDepth Színmélység (1, 4, 8 vagy 16 bit)
+     * @return A sprite, vagy nullptr, ha minden hely foglalt vagy nincs elég memória
+     */
+    TFT_eSprite *lease(uint16_t width, uint16_t height, uint8_t colorDepth = 16);
+
+    /**
+     * @brief Sprite visszaadása (a puffer megmarad a következő kérésnek)
+     */
+    void release(TFT_eSprite *sprite);
+
+    // Mérés: a tartós pool mellett a foglalások száma nem nőhet a kölcsönzésekkel együtt
+    inline uint32_t getLeaseCount() const { return leaseCount; }
+    inline uint32_t getAllocationCount() const { return allocationCount; }
+    inline uint32_t getFailureCount() const { return failureCount; }
+
+    /**
+     * @brief A pool által tartott sprite pufferek összmérete (byte)
+     */
+    uint32_t getAllocatedBytes() const;
+
+  private:
+    struct Slot {
+        TFT_eSprite *sprite; // Az első használatkor jön létre (a puffere csak createSprite()-tal)
+        uint16_t width;
+        uint16_t height;
+        uint8_t colorDepth;
+        bool created;      // Van lefoglalt puffere
+        bool leased;       // Kölcsönben van
+        uint32_t lastUsed; // A visszaadás sorszáma (a legrégebben használt szabad sprite foglalható újra)
+    };
+
+    TFT_eSPI &tft;
+    Slot slots[MAX_SPRITES];
+    uint32_t useCounter;
+    uint32_t leaseCount;
+    uint32_t allocationCount;
+    uint32_t failureCount;
+
+    bool allocate(Slot &slot, uint16_t width, uint16_t height, uint8_t colorDepth);
+    void freeSlot(Slot &slot);
+    static uint32_t getBufferSize(uint16_t width, uint16_t height, uint8_t colorDepth);
+};
+
+extern SpritePool spritePool;
+
+#endif // __SPRITE_POOL_H
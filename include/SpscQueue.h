@@ -0,0 +1,78 @@
+/**
+ * @file SpscQueue.h
+ * @brief Általános lock-free, egy író / egy olvasó sor helyben írható és olvasható elemekkel
+ * @details A két mag (vagy megszakítás és főciklus) között másolás nélkül ad át nagyobb blokkokat:
+ * az író a beginWrite() által adott helyre ír és commitWrite()-tal teszi láthatóvá,
+ * az olvasó a peek() által adott elemet dolgozza fel és release()-szel adja vissza.
+ */
+
+#ifndef __SPSC_QUEUE_H
+#define __SPSC_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief SPSC sor
+ * @tparam T Elem típus
+ * @tparam Capacity Elemek száma (kettő hatványa)
+ */
+template <typename T, uint8_t Capacity> class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+  public:
+    SpscQueue() : head(0), tail(0) {}
+
+    /**
+     * @brief A következő szabad elem (csak az író hívhatja)
+     * @return nullptr, ha a sor tele van
+     */
+    inline T *beginWrite() {
+        uint8_t h = head.load(std::memory_order_relaxed);
+        if (static_cast<uint8_t>(h - tail.load(std::memory_order_acquire)) >= Capacity) {
+            return nullptr;
+        }
+        return &items[h & MASK];
+    }
+
+    /**
+     * @brief A beginWrite()-tal kapott elem közzététele az olvasónak
+     */
+    inline void commitWrite() { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /**
+     * @brief A legrégebbi elem (csak az olvasó hívhatja)
+     * @return nullptr, ha a sor üres
+     */
+    inline const T *peek() const {
+        uint8_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[t & MASK];
+    }
+
+    /**
+     * @brief A peek()-kel kapott elem visszaadása az írónak
+     */
+    inline void release() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /**
+     * @brief Minden várakozó elem eldobása (csak az olvasó hívhatja)
+     */
+    inline void flush() { tail.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    /**
+     * @brief Várakozó elemek száma (tájékoztató jellegű)
+     */
+    inline uint8_t size() const { return static_cast<uint8_t>(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire)); }
+
+  private:
+    static constexpr uint8_t MASK = Capacity - 1;
+
+    T items[Capacity];
+    std::atomic<uint8_t> head; // Csak az író módosítja
+    std::atomic<uint8_t> tail; // Csak az olvasó módosítja
+};
+
+#endif // __SPSC_QUEUE_H
@@ -7,8 +7,12 @@
 #include "utils.h"
 
 #ifndef EEPROM_SIZE
+#ifdef SCAN_SNAPSHOT_PERSIST
+#define EEPROM_SIZE 4096 // A scan snapshot nem fér el a 2K területen
+#else
 #define EEPROM_SIZE 2048 // Alapértelmezett 2K méret (512-4096 között módosítható)
 #endif
+#endif
 
 /**
  * @brief Generikus EEPROM kezelő osztály struktúrák tárolásához
@@ -0,0 +1,122 @@
+/**
+ * @file TftDma.h
+ * @brief DMA-s (aszinkron) kitolás a TFT-re: sprite-ok és téglalapok, két váltakozó staging pufferrel
+ * @details A kitolandó pixelek (bájtcserélt RGB565, mint a 16 bites sprite pufferekben) csíkokban egy staging
+ * pufferbe kerülnek, amit a DMA visz ki az SPI-n. Amíg az egyik puffer kitolása tart, a CPU a másikba állítja
+ * össze a következő csíkot (sprite konverzió, glyph összeállítás), majd az utolsó csík kitolása alatt fut tovább.
+ * A staging pufferbe másolás miatt a forrás (sprite) a hívás után azonnal újra írható.
+ *
+ * Az SPI buszon a DMA mellett más nem forgalmazhat: mielőtt bárki közvetlenül rajzol (fillRect, drawString, ...)
+ * vagy a touch-ot olvassa, fence() kell. Ezt a közös belépési pontok végzik (ScreenManager, a UIContainerComponent
+ * és a UIScreen rajzolási/loop ciklusa, a touch olvasás), a DMA-t használó komponensek pedig a saját közvetlen
+ * rajzolásuk előtt. Ha a DMA nem érhető el, minden kitolás szinkron (tft.pushImage()) történik.
+ *
+ * Mérés: a képkocka idő a ScreenManager::draw() kezdetétől az utolsó kitolás befejezéséig tart, az input-to-photon
+ * késleltetés az első, az esemény után kezdett képkocka befejezéséig. A befejezést a fence() vagy a poll() észleli.
+ */
+
+#ifndef __TFT_DMA_H
+#define __TFT_DMA_H
+
+#include <TFT_eSPI.h>
+
+/**
+ * @brief DMA-s TFT kitolás
+ */
+class TftDma {
+  public:
+    static constexpr uint16_t BUFFER_PIXELS = 2048; // Egy staging puffer mérete (pixel), ebből kettő van
+
+    /**
+     * @brief Konstruktor
+     * @param tft A TFT, amire a kitolás történik
+     */
+    explicit TftDma(TFT_eSPI &tft);
+
+    /**
+     * @brief A DMA csatorna lefoglalása (a tft.init() után)
+     */
+    void begin();
+
+    inline bool isEnabled() const { return enabled; }
+    inline bool isBusy() const { return transferActive; }
+
+    /**
+     * @brief A következő kitolandó staging puffer (BUFFER_PIXELS méretű, bájtcserélt RGB565)
+     * @details Ha a puffer kitolása még tart, megvárja (fence az újrahasználat előtt).
+     */
+    uint16_t *acquireBuffer();
+
+    /**
+     * @brief Az acquireBuffer()-rel kapott puffer kitolása a (x, y, width, height) téglalapra
+     * @details A kitolás a háttérben fut; a következő acquireBuffer() már a másik puffert adja.
+     */
+    void pushBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+    /**
+     * @brief Sprite kitolása csíkokban (16, 8 és 4 bites sprite-ok; az 1 bitesek szinkron mennek ki)
+     */
+    void pushSprite(TFT_eSprite &sprite, int16_t x, int16_t y);
+
+    /**
+     * @brief A folyamatban lévő kitolás megvárása, a busz elengedése (közvetlen rajzolás előtt kötelező)
+     */
+    void fence();
+
+    /**
+     * @brief A kitolás befejezésének észlelése várakozás nélkül
+     */
+    void poll();
+
+    // Képkocka és input mérés (ScreenManager)
+    void beginFrame();
+    void endFrame();
+    void noteInput();
+
+    inline uint32_t getLastFrameMicros() const { return lastFrameMicros; }       // Kezdettől az utolsó kitolás végéig
+    inline uint32_t getAverageFrameMicros() const { return averageFrameMicros; } // Mozgó átlag (7/8)
+    inline uint32_t getMaxFrameMicros() const { return maxFrameMicros; }
+    inline uint32_t getLastFrameCpuMicros() const { return lastFrameCpuMicros; } // A draw() hívás ideje
+    inline uint32_t getLastInputLatencyMicros() const { return lastInputLatencyMicros; }
+    inline uint32_t getMaxInputLatencyMicros() const { return maxInputLatencyMicros; }
+    inline uint32_t getFenceWaitMicros() const { return fenceWaitMicros; } // Összesen a fence()-ben várva
+    inline uint32_t getAsyncPushCount() const { return asyncPushCount; }
+    inline uint32_t getSyncPushCount() const { return syncPushCount; }
+
+    /**
+     * @brief A mért értékek kiírása a soros portra, a maximumok nullázása
+     */
+    void debugMetrics();
+
+  private:
+    TFT_eSPI &tft;
+    bool enabled;
+    bool transferActive; // Nyitott SPI tranzakció, DMA kitolással
+    uint8_t nextBuffer;
+    const uint16_t *inFlight;
+    uint16_t buffers[2][BUFFER_PIXELS];
+    uint16_t rgb332Colors[256]; // 8 bites sprite szín -> bájtcserélt RGB565
+
+    // Mérés
+    bool frameActive;   // Elkezdett képkocka, amelynek a kitolása még nem fejeződött be
+    bool frameHasInput; // A képkocka egy input esemény után kezdődött
+    bool inputPending;
+    uint32_t frameStartMicros;
+    uint32_t inputMicros;
+    uint32_t lastFrameMicros;
+    uint32_t averageFrameMicros;
+    uint32_t maxFrameMicros;
+    uint32_t lastFrameCpuMicros;
+    uint32_t lastInputLatencyMicros;
+    uint32_t maxInputLatencyMicros;
+    uint32_t fenceWaitMicros;
+    uint32_t asyncPushCount;
+    uint32_t syncPushCount;
+
+    void completeTransfer();
+    void completeFrame();
+};
+
+extern TftDma tftDma;
+
+#endif // __TFT_DMA_H
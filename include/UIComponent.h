@@ -33,6 +33,31 @@ struct Rect {
     Rect(int16_t x = 0, int16_t y = 0, uint16_t width = 0, uint16_t height = 0) : x(x), y(y), width(width), height(height) {}
 
     bool contains(int16_t px, int16_t py) const { return px >= x && px < x + width && py >= y && py < y + height; }
+    bool contains(const Rect &other) const { return other.x >= x && other.y >= y && other.x + other.width <= x + width && other.y + other.height <= y + height; }
+    bool intersects(const Rect &other) const { return other.x < x + width && x < other.x + other.width && other.y < y + height && y < other.y + other.height; }
+    bool isEmpty() const { return width == 0 || height == 0; }
+    uint32_t area() const { return static_cast<uint32_t>(width) * height; }
+
+    // A két téglalapot befoglaló legkisebb téglalap
+    Rect united(const Rect &other) const {
+        int16_t left = x < other.x ? x : other.x;
+        int16_t top = y < other.y ? y : other.y;
+        int16_t right = x + width > other.x + other.width ? x + width : other.x + other.width;
+        int16_t bottom = y + height > other.y + other.height ? y + height : other.y + other.height;
+        return Rect(left, top, right - left, bottom - top);
+    }
+
+    // A közös rész (üres, ha nem fedik egymást)
+    Rect intersected(const Rect &other) const {
+        if (!intersects(other)) {
+            return Rect();
+        }
+        int16_t left = x > other.x ? x : other.x;
+        int16_t top = y > other.y ? y : other.y;
+        int16_t right = x + width < other.x + other.width ? x + width : other.x + other.width;
+        int16_t bottom = y + height < other.y + other.height ? y + height : other.y + other.height;
+        return Rect(left, top, right - left, bottom - top);
+    }
 
     int16_t centerX() const { return x + width / 2; }
     int16_t centerY() const { return y + height / 2; }
@@ -5,7 +5,9 @@
 #include <memory>
 #include <vector>
 
+#include "TftDma.h"
 #include "UIComponent.h"
+#include "UIProfiler.h"
 
 class UIContainerComponent : public UIComponent {
 
@@ -124,11 +126,15 @@ class UIContainerComponent : public UIComponent {
 
         // Először saját loop logika (UIComponent::loop() + UIContainerComponent specifikus)
         UIComponent::loop(); // Hívja az UIComponent alap loopját (ami jelenleg üres, de lehetne benne logika)
-        handleOwnLoop();     // Hívja a UIContainerComponent specifikus loopját (ha van)
+        {
+            UI_PROFILE_SCOPE(OwnLoop);
+            handleOwnLoop(); // Hívja a UIContainerComponent specifikus loopját (ha van)
+        }
 
         // Majd minden aktív gyerek megkapja (megszakítás nélkül)
         for (auto &child : children) {
             if (!child->isDisabled()) {
+                tftDma.fence(); // A gyerek loop-ja közvetlenül is rajzolhat
                 child->loop();
             }
         }
@@ -144,11 +150,14 @@ class UIContainerComponent : public UIComponent {
         // Ha a UIContainerComponent-nek van saját vizuális megjelenése (pl. háttér),
         // azt a drawSelf()-ben kell implementálni.
         if (UIComponent::isRedrawNeeded()) {  // Ellenőrzi a UIComponent::needsRedraw flag-et
+            tftDma.fence();                   // Az előző DMA kitolásnak be kell fejeződnie a közvetlen rajzolás előtt
             drawSelf();                       // Leszármazott implementálja, ha van mit rajzolnia (pl. háttér)
             UIComponent::needsRedraw = false; // Fontos: töröljük a flag-et, miután a "saját" rajzolás megtörtént
         } // 2. Gyerekek rajzolása (csak ha szükséges újrarajzolás)
         for (auto &child : children) {
             if (child->isRedrawNeeded()) {
+                tftDma.fence();
+                UI_PROFILE_COMPONENT(child.get());
                 child->draw();
             }
         }
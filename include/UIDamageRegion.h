@@ -0,0 +1,43 @@
+/**
+ * @file UIDamageRegion.h
+ * @brief Sérült (újrarajzolandó) képernyő területek gyűjtője a UIScreen kompozitorához
+ * @details Egy rajzolási ciklus alatt gyűjti a téglalapokat. Az átfedő vagy szomszédos téglalapok összevonódnak,
+ * ha a befoglaló téglalap nem nagyobb a kettő összterületénél (így egy L alakú sérülésből nem lesz feleslegesen
+ * nagy terület). Ha a lista betelt, az új téglalap azzal olvad össze, amelyiknél a legkisebb a területnövekedés.
+ */
+
+#ifndef __UI_DAMAGE_REGION_H
+#define __UI_DAMAGE_REGION_H
+
+#include "UIComponent.h"
+
+/**
+ * @brief Sérült területek listája
+ */
+class UIDamageRegion {
+  public:
+    static constexpr uint8_t MAX_RECTS = 8; // Egyszerre tárolt téglalapok legnagyobb száma
+
+    /**
+     * @brief Téglalap hozzáadása (a képernyőre vágva; az üres téglalap kimarad)
+     */
+    void add(const Rect &rect);
+
+    inline void clear() { count = 0; }
+    inline bool isEmpty() const { return count == 0; }
+    inline uint8_t getCount() const { return count; }
+    inline const Rect &getRect(uint8_t index) const { return rects[index]; }
+
+    /**
+     * @brief Van-e közös része a téglalappal valamelyik sérült területnek
+     */
+    bool intersects(const Rect &rect) const;
+
+  private:
+    Rect rects[MAX_RECTS];
+    uint8_t count = 0;
+
+    void removeAt(uint8_t index);
+};
+
+#endif // __UI_DAMAGE_REGION_H
@@ -42,6 +42,7 @@ class UIDialogBase : public UIContainerComponent {
     static constexpr uint16_t BORDER_RADIUS = 8;                                   // Saroklekerekítés
     static constexpr uint16_t CLOSE_BUTTON_SIZE = HEADER_HEIGHT - 2 * PADDING - 2; // Bezáró gomb mérete
     static constexpr uint16_t VEIL_COLOR = TFT_DARKGREY;                           // Fátyol színe (lehetne tft.color565(30,30,30) egy sötétebbért)
+    static constexpr uint8_t SHADOW_OFFSET = 4;                                    // Árnyék eltolása jobbra és lefelé
 
     // MultiButtonDialog lefagyás debughoz
     static constexpr uint16_t DEFAULT_HEADER_HEIGHT = HEADER_HEIGHT;
@@ -52,7 +53,7 @@ class UIDialogBase : public UIContainerComponent {
 
     // Belső segéd metódusok
     void createCloseButton();
-    void drawVeil();
+    void drawVeil(const Rect &area);
 
     bool topDialog = false; // Jelzi, hogy ez a dialógus a legfelső (legutolsó) a stackben
 
@@ -81,6 +82,19 @@ class UIDialogBase : public UIContainerComponent {
     // A veilDrawn flag resetelése
     void resetVeilDrawnFlag() { veilDrawn = false; }
 
+    /**
+     * @brief A dialógus által takart terület (a dialógus és az árnyéka)
+     */
+    inline Rect getFootprint() const { return Rect(bounds.x, bounds.y, bounds.width + SHADOW_OFFSET, bounds.height + SHADOW_OFFSET); }
+
+    /**
+     * @brief A dialógus (fátyol és keret) helyreállítása egy sérült területen, amelyet alatta lévő elem írt felül
+     * @param area A sérült terület; a kirajzolás vágását (setViewport) a hívó állítja be
+     * @details A fátyol a területen mindig visszakerül, a dialógus pedig akkor rajzolódik újra, ha a terület érinti.
+     * A még ki nem rajzolt dialógust a következő draw() úgyis teljesen kirajzolja (fátyollal együtt).
+     */
+    void repairArea(const Rect &area);
+
     /**
      * @brief Touch esemény kezelése, amely először a gyerek komponenseken próbálkozik,
      * majd ha egyik sem, akkor maga a UIDialogBase kezeli.
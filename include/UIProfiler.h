@@ -0,0 +1,148 @@
+/**
+ * @file UIProfiler.h
+ * @brief Könnyűsúlyú futásidő profilozó: képkocka, loop, komponens rajzolás, eseménykezelés
+ * @details A mérőpontokon egy hatókörös (scoped) időzítő micros()-szal méri a futásidőt, és egy logaritmikus
+ * hisztogramba gyűjti (fél oktávos vödrök, ~40% felbontás). Ebből áll elő a min/átlag/max/p99 érték.
+ * A komponens rajzolások komponensenként (a komponens címe szerint) gyűlnek, a többi mérőpont összesítve.
+ * Az eredmények időszakonként a soros portra kerülnek, opcionálisan a képernyő bal felső sarkában is
+ * megjelennek (UI_PROFILER_OVERLAY). Minden kiírás után a mérési ablak újraindul.
+ *
+ * Csak UI_PROFILER mellett fordul be (a defines.h-ban a __DEBUG blokkban); nélküle a UI_PROFILE_* makrók
+ * üresek, és maga a profilozó sem kerül a programba.
+ */
+
+#ifndef __UI_PROFILER_H
+#define __UI_PROFILER_H
+
+#include "defines.h"
+
+#ifdef UI_PROFILER
+
+#include <TFT_eSPI.h>
+
+#include "UIComponent.h"
+
+/**
+ * @brief Egy mérőpont statisztikája (mérési ablakonként)
+ */
+struct UIProfileStats {
+    static constexpr uint8_t BUCKETS = 32; // Fél oktávos vödrök: a ~49 ms feletti értékek az utolsóba esnek
+
+    uint32_t count;
+    uint32_t totalMicros;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint32_t buckets[BUCKETS];
+
+    void reset();
+    void add(uint32_t micros);
+    inline uint32_t getAverage() const { return count ? totalMicros / count : 0; }
+
+    /**
+     * @brief Percentilis becslése a hisztogramból (a vödör felső határa, legfeljebb a maximum)
+     * @param percent 1..100
+     */
+    uint32_t getPercentile(uint8_t percent) const;
+};
+
+/**
+ * @brief Profilozó
+ */
+class UIProfiler {
+  public:
+    /**
+     * @brief Összesített mérőpontok
+     */
+    enum class Point : uint8_t {
+        Frame,          // ScreenManager::draw() - a képernyő rajzolása
+        LoopIteration,  // A core0 loop() egy menete
+        OwnLoop,        // UIContainerComponent::handleOwnLoop() (pl. képernyők saját loop-ja)
+        Si4735Loop,     // Si4735Manager::loop()
+        TouchDispatch,  // Touch esemény továbbítása a képernyőnek
+        RotaryDispatch, // Rotary esemény továbbítása a képernyőnek
+        ScanSpectrum,   // ScanScreen::drawSpectrum() - teljes spektrum kirajzolás
+        Count
+    };
+
+    static constexpr uint8_t MAX_COMPONENTS = 24; // Komponensenként mért rajzolások legnagyobb száma egy ablakban
+
+    UIProfiler();
+
+    void record(Point point, uint32_t micros);
+
+    /**
+     * @brief Komponens rajzolásának rögzítése (ha betelt a tábla, csak a kimaradt mérések száma nő)
+     */
+    void recordComponent(const UIComponent *component, uint32_t micros);
+
+    /**
+     * @brief Az ablak statisztikáinak kiírása a soros portra (komponensek átlag szerint csökkenő sorrendben)
+     */
+    void dump();
+
+    /**
+     * @brief Az összesítés megjelenítése a képernyő bal felső sarkában (a felülírt UI a következő
+     * újrarajzolásáig takarásban marad)
+     */
+    void drawOverlay(TFT_eSPI &tft);
+
+    /**
+     * @brief Új mérési ablak
+     */
+    void reset();
+
+  private:
+    struct ComponentSlot {
+        const UIComponent *component;
+        Rect bounds; // Az azonosításhoz (a legutóbbi rajzoláskor)
+        UIProfileStats stats;
+    };
+
+    UIProfileStats points[static_cast<uint8_t>(Point::Count)];
+    ComponentSlot components[MAX_COMPONENTS];
+    uint8_t componentCount;
+    uint32_t droppedComponentSamples;
+    uint32_t windowStartMillis;
+
+    static const char *getPointName(Point point);
+};
+
+/**
+ * @brief Hatókörös időzítő egy összesített mérőponthoz
+ */
+class UIProfileScope {
+  public:
+    explicit UIProfileScope(UIProfiler::Point point) : point(point), start(micros()) {}
+    ~UIProfileScope();
+
+  private:
+    UIProfiler::Point point;
+    uint32_t start;
+};
+
+/**
+ * @brief Hatókörös időzítő egy komponens rajzolásához
+ */
+class UIProfileComponentScope {
+  public:
+    explicit UIProfileComponentScope(const UIComponent *component) : component(component), start(micros()) {}
+    ~UIProfileComponentScope();
+
+  private:
+    const UIComponent *component;
+    uint32_t start;
+};
+
+extern UIProfiler uiProfiler;
+
+#define UI_PROFILE_SCOPE(point) UIProfileScope uiProfileScope(UIProfiler::Point::point)
+#define UI_PROFILE_COMPONENT(component) UIProfileComponentScope uiProfileComponentScope(component)
+
+#else
+
+#define UI_PROFILE_SCOPE(point)
+#define UI_PROFILE_COMPONENT(component)
+
+#endif // UI_PROFILER
+
+#endif // __UI_PROFILER_H
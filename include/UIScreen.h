@@ -7,6 +7,7 @@
 #include "Si4735Manager.h"
 #include "StatusLine.h"
 #include "UIContainerComponent.h"
+#include "UIDamageRegion.h"
 #include "UIDialogBase.h"
 
 class UIScreen : public UIContainerComponent {
@@ -36,6 +37,31 @@ class UIScreen : public UIContainerComponent {
      */
     std::shared_ptr<UIDialogBase> currentDialog;
 
+    /**
+     * @brief Feltárt területek: a képernyő tartalma itt elveszett (pl. bezárt dialógus alatt), teljesen újrarajzolandó
+     */
+    UIDamageRegion exposedRegion;
+
+    /**
+     * @brief Dialógus alatti rajzolás által felülírt területek: a fátyol és a dialógusok itt újrarajzolandók
+     */
+    UIDamageRegion overlayRegion;
+
+    /**
+     * @brief Teljesen letakarja-e valamelyik dialógus a területet
+     */
+    bool isOccludedByDialog(const Rect &area) const;
+
+    /**
+     * @brief A feltárt területek helyreállítása: háttér, képernyő tartalom, és az érintett komponensek megjelölése
+     */
+    void repairExposedRegion();
+
+    /**
+     * @brief A felülírt területeken a fátyol és a dialógusok újrarajzolása (vágással)
+     */
+    void repairDialogOverlays();
+
   protected: // Si4735Manager pointer
     Si4735Manager *pSi4735Manager;
 
@@ -197,14 +223,25 @@ class UIScreen : public UIContainerComponent {
      * @brief Képernyő és dialógusok kirajzolása
      *
      * Rajzolási sorrend:
-     * 1. Alap képernyő komponensek (UICompositeComponent::draw())
-     * 2. Összes aktív dialógus a stack sorrendjében (alulról felfelé)
+     * 1. Feltárt (sérült) területek: háttér és képernyő tartalom vágással, az érintett komponensek megjelölése
+     * 2. Alap képernyő komponensek - a dialógus által teljesen letakartak kimaradnak (a bezáráskor pótlódnak)
+     * 3. A dialógus alatti rajzolás által felülírt területeken a fátyol és a dialógusok vágással
+     * 4. Összes aktív dialógus a stack sorrendjében (alulról felfelé)
      *
      * A layered dialog rendszer magja - minden látható dialógust kirajzol
      * a megfelelő rétegzési sorrendben.
      */
     virtual void draw() override;
 
+    /**
+     * @brief Képernyő terület érvénytelenítése: a következő draw() a területet (és a komponenseket, amelyeket érint)
+     * a háttértől kezdve újrarajzolja
+     * @param area A terület (képernyő koordinátákban)
+     * @details Egy rajzolási cikluson belül a területek összevonódnak, így pl. egy dialógus bezárása és az utána
+     * kért gombsor frissítés egyetlen rajzolásban történik.
+     */
+    void invalidateRect(const Rect &area);
+
     /**
      * @brief Touch esemény kezelése
      * @param event Touch esemény adatok
@@ -269,7 +306,7 @@ class UIScreen : public UIContainerComponent {
      * Funkciók:
      * - Dialógus eltávolítása mindkét stack-ből
      * - Előző dialógus aktiválása (ha van)
-     * - Képernyő újrarajzolás (ha szükséges)
+     * - A dialógus által érintett terület érvénytelenítése (a következő draw() rajzolja újra)
      * - Memória cleanup
      *
      * @see docs/LayeredDialogSystem.md#onDialogClosed
@@ -297,7 +334,7 @@ class UIScreen : public UIContainerComponent {
     /**
      * @brief Dialógus cleanup végrehajtása rajzolás nélkül
      * @param closedDialog A bezárt dialógus pointer
-     * @details Lemásolja az onDialogClosed logikáját, de kihagyja a draw() hívásokat.
+     * @details Lemásolja az onDialogClosed logikáját, de a teljes képernyőt érvényteleníti (pl. sávváltás után).
      * Hasznos olyan esetekben, amikor a leszármazott osztály egyedi rajzolási logikát szeretne.
      */
     void performDialogCleanupWithoutDraw(UIDialogBase *closedDialog);
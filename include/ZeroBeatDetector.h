@@ -0,0 +1,113 @@
+/**
+ * @file ZeroBeatDetector.h
+ * @brief Hang alapú finomhangolás segéd (zero-beat jelző) SSB/CW vételhez
+ * @details Saját AudioCapture blokk fogyasztóként veszi a mintákat, 50%-os átlapolással Hann ablakos FFT-t
+ * számol, és a célhang (config.data.cwReceiverOffsetHz) körüli keresési tartományban megkeresi a domináns hangot.
+ * A csúcs helyét a szomszédos binek logaritmikus magnitúdójára illesztett parabolával (Gauss interpoláció)
+ * bin alatti pontossággal becsüli: 12 kS/s és 1024 pontos FFT mellett egy bin ~11.7 Hz, a becslés hibája
+ * tiszta szinuszra 1 Hz alatti.
+ *
+ * Érvényes hangnak csak a keresési tartomány átlagánál legalább PEAK_TO_AVERAGE_RATIO-szor erősebb csúcs számít;
+ * a becslés exponenciálisan simított, és billentyűzött CW-nél a szünetekben HOLD_MS ideig megmarad.
+ */
+
+#ifndef __ZERO_BEAT_DETECTOR_H
+#define __ZERO_BEAT_DETECTOR_H
+
+#include "AudioCapture.h"
+#include "AudioDspStages.h"
+#include "AudioFft.h"
+
+/**
+ * @brief Zero-beat detektor
+ */
+class ZeroBeatDetector {
+  public:
+    static constexpr uint16_t FFT_SIZE = 1024;            // 12 kS/s-nél ~11.7 Hz bin, ~43 ms új keret
+    static constexpr uint16_t SEARCH_SPAN_HZ = 400;       // Keresési tartomány a célhang körül (+/-)
+    static constexpr uint16_t MIN_PEAK_MAGNITUDE = 48;    // A legkisebb elfogadott csúcs (FFT egység, ~ -50 dBFS)
+    static constexpr uint8_t PEAK_TO_AVERAGE_RATIO = 6;   // A csúcs és a keresési tartomány átlagának legkisebb aránya
+    static constexpr uint8_t SMOOTHING_SHIFT = 2;         // Simítás: keretenként a különbség 1/4-e
+    static constexpr float MAX_TRACKING_STEP_BINS = 2.0f; // Ennél nagyobb ugrásnál a simítás újraindul (új állomás)
+    static constexpr uint32_t HOLD_MS = 1500;             // Ennyi ideig marad érvényes az utolsó becslés hang nélkül
+
+    ZeroBeatDetector();
+
+    /**
+     * @brief Destruktor - a blokk fogyasztó leiratkoztatása
+     */
+    ~ZeroBeatDetector();
+
+    /**
+     * @brief Sikerült-e a pufferek lefoglalása
+     */
+    bool isAvailable() const;
+
+    /**
+     * @brief A célhang beállítása (ehhez képest mérjük az eltérést); a becslés törlődik
+     */
+    void setTargetFrequency(uint16_t frequencyHz);
+    inline uint16_t getTargetFrequency() const { return targetFrequencyHz; }
+
+    /**
+     * @brief A becslés és a keretező törlése (pl. hangolás vagy BFO korrekció után)
+     */
+    void reset();
+
+    /**
+     * @brief Blokk fogyasztóként a mintavételezőre csatlakozás, ill. leválás
+     * @return false, ha nincs szabad fogyasztó hely vagy puffer
+     */
+    bool attach();
+    void detach();
+    inline bool isAttached() const { return blockConsumer != AudioCapture::INVALID_CONSUMER; }
+
+    /**
+     * @brief A várakozó blokkok feldolgozása (core0 loop)
+     * @return true, ha a kijelzendő eredmény (van-e hang, kerekített eltérés) megváltozott
+     */
+    bool update();
+
+    /**
+     * @brief Minták feldolgozása (az update() ezt hívja blokkonként; közvetlenül tesztjelhez is használható)
+     * @param samples Előjeles Q15 minták
+     * @param count Minták száma
+     * @param sampleRate Mintavételi frekvencia (Hz)
+     */
+    void processSamples(const int16_t *samples, uint16_t count, uint32_t sampleRate);
+
+    /**
+     * @brief Van-e érvényes hang becslés
+     */
+    bool hasTone() const;
+
+    /**
+     * @brief A domináns hang becsült frekvenciája (Hz, simított)
+     */
+    inline float getToneFrequency() const { return toneFrequencyHz; }
+
+    /**
+     * @brief A hang eltérése a célhangtól (Hz, kerekítve; pozitív: a hang magasabb)
+     */
+    int16_t getOffsetHz() const;
+
+  private:
+    AudioFft fft;
+    AudioWindow window;
+    AudioOverlapBuffer frames;
+    int16_t *fftInput;
+    uint16_t *magnitudes;
+
+    uint16_t targetFrequencyHz;
+    uint32_t sampleRate;        // Az utolsó feldolgozott minták mintavételi frekvenciája
+    float toneFrequencyHz;      // Simított becslés (0: még nincs)
+    uint32_t lastToneTime;      // Az utolsó érvényes csúcs ideje (millis)
+    uint32_t lastSequence;      // Az utolsó átvett blokk sorszáma
+    uint8_t blockConsumer;      // AudioCapture blokk fogyasztó azonosító
+    bool lastReportedTone;      // Az update() által utoljára jelzett állapot
+    int16_t lastReportedOffset; // Az update() által utoljára jelzett eltérés
+
+    bool analyzeFrame(float &peakFrequencyHz);
+};
+
+#endif // __ZERO_BEAT_DETECTOR_H
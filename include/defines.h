@@ -20,6 +20,7 @@
 #define SCREEN_NAME_SETUP "SetupScreen"
 #define SCREEN_NAME_MEMORY "MemoryScreen"
 #define SCREEN_NAME_SCAN "ScanScreen"
+#define SCREEN_NAME_ANALYZER "AnalyzerScreen"
 
 #define SCREEN_NAME_TEST "TestScreen"
 #define SCREEN_NAME_EMPTY "EmptyScreen"
@@ -32,6 +33,16 @@
 // #define SHOW_MEMORY_INFO
 #define MEMORY_INFO_INTERVAL 20 * 1000 // 20mp
 
+// Képkocka idő, input-to-photon késleltetés és DMA kitolás statisztika (TftDma)
+// #define SHOW_RENDER_METRICS
+#define RENDER_METRICS_INTERVAL 10 * 1000 // 10mp
+
+// Futásidő profilozó (UIProfiler): képkocka, loop, komponens rajzolás, eseménykezelés - min/átlag/p99/max
+// #define UI_PROFILER
+#define UI_PROFILER_DUMP_INTERVAL 10 * 1000 // 10mp, a kiírás után új mérési ablak indul
+// #define UI_PROFILER_OVERLAY              // Összesítés a képernyő bal felső sarkában is
+#define UI_PROFILER_OVERLAY_INTERVAL 500    // ms
+
 // Soros portra várakozás a debug üzenetek előtt
 // #define DEBUG_WAIT_FOR_SERIAL
 
@@ -60,10 +71,25 @@
 #define SCREEN_SAVER_TIMEOUT_MAX 60
 #define SCREEN_SAVER_TIMEOUT 10 // 1 perc a képernyővédő időzítése - tesztelés
 
+//--- Spektrum scan ---
+// Waterfall előzmény memória kerete bájtban (változtatható a platformio.ini-ben)
+#ifndef SCAN_WATERFALL_MEMORY_BUDGET
+#define SCAN_WATERFALL_MEMORY_BUDGET (8 * 1024)
+#endif
+// Képernyőváltást túlélő scan snapshot-ok száma (sávonként egy tömörített, ~0.9 KB-os slot, a legrégebben használt íródik felül)
+#ifndef SCAN_SNAPSHOT_SLOTS
+#define SCAN_SNAPSHOT_SLOTS 3
+#endif
+// A legutóbbi scan snapshot mentése EEPROM-ba is (újraindítás után is megmarad, 4K EEPROM kell hozzá)
+// #define SCAN_SNAPSHOT_PERSIST
+
 //--- CW Decoder ---
 #define CW_DECODER_DEFAULT_FREQUENCY 750 // Alapértelmezett CW dekóder frekvencia (Hz)
 #define CW_DECODER_MIN_FREQUENCY 600     // Minimum CW dekóder frekvencia (Hz)
 #define CW_DECODER_MAX_FREQUENCY 1500    // Maximum CW dekóder frekvencia (Hz)
+#define CW_DECODER_MIN_WPM 5             // A követett leglassabb adási sebesség (szó/perc)
+#define CW_DECODER_MAX_WPM 40            // A követett leggyorsabb adási sebesség (szó/perc)
+#define CW_DECODER_DEFAULT_WPM 20        // Induló sebesség becslés (szó/perc)
 
 //--- RTTY mód adatai
 // #define RTTY_DEFAULT_MARKER_FREQUENCY 2295.0f                                      // RTTY jelölő frekvencia (Hz)
@@ -92,10 +118,11 @@
 // Audio DSP/FFT beállítások
 #define AUDIO_FFT_IMPLEMENTATION_ARDUINO 1
 #define AUDIO_FFT_IMPLEMENTATION_CMSIS 2
+#define AUDIO_FFT_IMPLEMENTATION_FIXED 3 // Q15 fixpontos radix-4 (FPU nélküli Cortex-M0+ magra)
 
 // Választható FFT implementáció (változtatható a platformio.ini-ben)
 #ifndef AUDIO_FFT_IMPLEMENTATION
-#define AUDIO_FFT_IMPLEMENTATION AUDIO_FFT_IMPLEMENTATION_ARDUINO
+#define AUDIO_FFT_IMPLEMENTATION AUDIO_FFT_IMPLEMENTATION_FIXED
 #endif
 
 // FFT méretek (power of 2)
@@ -103,4 +130,13 @@
 #define AUDIO_FFT_SIZE_MAX 4096
 #define AUDIO_FFT_SIZE_DEFAULT 1024
 
+// Audio mintavételezés (ADC + DMA, core1)
+#define AUDIO_CAPTURE_SAMPLE_RATE_MIN 4000      // Hz
+#define AUDIO_CAPTURE_SAMPLE_RATE_MAX 100000    // Hz (az ADC 500 kS/s-ig képes, de ennyi bőven elég)
+#define AUDIO_CAPTURE_SAMPLE_RATE_DEFAULT 20000 // Hz - 10 kHz hang sávszélesség (FM audio is belefér)
+#define AUDIO_CAPTURE_BLOCK_SIZE 256            // Minták száma egy DMA blokkban
+#define AUDIO_CAPTURE_POOL_BLOCKS 8             // Közös blokk pool mérete (minden fogyasztó ugyanazt a példányt olvassa)
+#define AUDIO_CAPTURE_MAX_CONSUMERS 4           // Egyszerre regisztrálható core0 blokk fogyasztók száma
+#define AUDIO_CAPTURE_CONSUMER_DEPTH 4          // Fogyasztónként várakozó blokkok legnagyobb száma (kettő hatványa)
+
 #endif // DEFINES_H
\ No newline at end of file
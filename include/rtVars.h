@@ -52,6 +52,9 @@ extern bool SEEK;
 // CW shift
 extern bool CWShift;
 
+// RTTY dekóder SSB módban (0: ki, 1..: RttyDecoder::BaudRate + 1)
+extern uint8_t rttyDecoderMode;
+
 } // namespace rtv
 
 #endif //__RTVARS_H
@@ -1,4 +1,5 @@
 #include "AMScreen.h"
+#include "AudioCapture.h"
 #include "Band.h"
 #include "CommonVerticalButtons.h"
 #include "Config.h"
@@ -9,6 +10,7 @@
 #include "rtVars.h"
 #include "utils.h"
 #include <algorithm>
+#include <new>
 
 // ===================================================================
 // Vízszintes gombsor azonosítók - Képernyő-specifikus navigáció
@@ -30,6 +32,9 @@ static constexpr uint8_t DEMOD_BUTTON = 73;  ///< Demodulation
 static constexpr uint8_t STEP_BUTTON = 74;   ///< Frequency Step
 } // namespace AMScreenHorizontalButtonIDs
 
+// AM hang sávszélesség: a mini audio kijelző felső frekvenciája, a mintavételezés ennek kétszeresével megy
+static constexpr uint16_t AM_AUDIO_BANDWIDTH_HZ = 6000;
+
 // =====================================================================
 // Konstruktor és inicializálás
 // =====================================================================
@@ -48,9 +53,15 @@ AMScreen::AMScreen(TFT_eSPI &tft, Si4735Manager &si4735Manager) : RadioScreen(tf
 /**
  * @brief AMScreen destruktor - MiniAudioDisplay parent pointer törlése
  * @details Biztosítja, hogy az MiniAudioDisplay ne próbáljon hozzáférni
- * a törölt screen objektumhoz képernyőváltáskor
+ * a törölt screen objektumhoz képernyőváltáskor. A CW dekódert a core1 még
+ * használhatja, ezért a tag megszűnése előtt le kell választani a mintavételezőről.
  */
-AMScreen::~AMScreen() { DEBUG("AMScreen::~AMScreen() - Destruktor hívása\n"); }
+AMScreen::~AMScreen() {
+    DEBUG("AMScreen::~AMScreen() - Destruktor hívása\n");
+    audioCapture.setBlockProcessor(nullptr);
+    zeroBeat.reset();
+    audioCapture.stop();
+}
 
 // =====================================================================
 // UIScreen interface megvalósítás
@@ -70,6 +81,11 @@ AMScreen::~AMScreen() { DEBUG("AMScreen::~AMScreen() - Destruktor hívása\n");
  */
 bool AMScreen::handleRotary(const RotaryEvent &event) {
 
+    // Seek közben a klikk megszakítja a keresést, a forgatás nem hangol
+    if (!isDialogActive() && abortSeekOnRotary(event)) {
+        return true;
+    }
+
     // Biztonsági ellenőrzés: csak aktív dialógus nélkül és nem klikk eseménykor
     if (isDialogActive() || event.buttonState == RotaryEvent::ButtonState::Clicked) {
         // Nem kezeltük az eseményt, továbbítjuk a szülő osztálynak (dialógusokhoz)
@@ -139,9 +155,7 @@ bool AMScreen::handleRotary(const RotaryEvent &event) {
         newFreq = pSi4735Manager->getSi4735().getCurrentFrequency();
 
         // SSB hangolás esetén a BFO eltolás beállítása
-        const int16_t cwBaseOffset = (currentBand.currDemod == CW_DEMOD_TYPE) ? 750 : 0; // Ideiglenes konstans CW offset
-        int16_t bfoToSet = cwBaseOffset + rtv::currentBFO + rtv::currentBFOmanu;
-        pSi4735Manager->getSi4735().setSSBBfo(bfoToSet);
+        applySsbBfo();
 
     } else {
         // Léptetjük a rádiót, ez el is menti a band táblába
@@ -159,6 +173,16 @@ bool AMScreen::handleRotary(const RotaryEvent &event) {
     // Memória státusz ellenőrzése és frissítése
     checkAndUpdateMemoryStatus();
 
+    // Új állomáson a korábbi jel szintje és sebessége nem érvényes
+    if (activeDecoder == TextDecoder::Cw) {
+        cwDecoder.requestReset();
+    } else if (activeDecoder == TextDecoder::Rtty) {
+        rttyDecoder.requestReset();
+    }
+    if (zeroBeat) {
+        zeroBeat->reset();
+    }
+
     return true; // Esemény sikeresen kezelve
 }
 
@@ -180,10 +204,25 @@ bool AMScreen::handleRotary(const RotaryEvent &event) {
  */
 void AMScreen::handleOwnLoop() {
 
+    // ===================================================================
+    // Futó seek követése (nem blokkoló)
+    // ===================================================================
+    processSeek();
+
     // ===================================================================
     // S-Meter (jelerősség) időzített frissítése - Közös RadioScreen implementáció
     // ===================================================================
     updateSMeter(false /* AM mód */);
+
+    // ===================================================================
+    // Szöveg dekóderek (CW módban CW, SSB módban igény szerint RTTY)
+    // ===================================================================
+    updateTextDecoder();
+
+    // ===================================================================
+    // Zero-beat jelző (SSB/CW)
+    // ===================================================================
+    updateZeroBeat();
 }
 
 /**
@@ -308,6 +347,23 @@ void AMScreen::layoutComponents() {
     Rect smeterBounds(2, FreqDisplayY + FreqDisplay::FREQDISPLAY_HEIGHT, SMeterConstants::SMETER_WIDTH, 60);
     createSMeterComponent(smeterBounds);
 
+    // ===================================================================
+    // Mini audio kijelző az S-Meter mellett, a frekvencia kijelző alatt (AM: 6kHz hang sávszélesség)
+    // ===================================================================
+    Rect miniAudioFftBounds(SMeterConstants::SMETER_WIDTH + 10, FreqDisplayY + FreqDisplay::FREQDISPLAY_HEIGHT + 10, 160, 60);
+    miniAudioFft = std::make_shared<MiniAudioFft>(tft, miniAudioFftBounds, config.data.miniAudioFftModeAm, config.data.miniAudioFftConfigAm, AM_AUDIO_BANDWIDTH_HZ);
+    addChild(miniAudioFft);
+
+    // ===================================================================
+    // Dekódolt szöveg doboz (a gyerekek közé csak SSB/CW módban kerül be)
+    // ===================================================================
+    Rect textBoxBounds(2, miniAudioFftBounds.y + miniAudioFftBounds.height + 5, 405, 110);
+    decodedTextBox = std::make_shared<DecodedTextBox>(tft, textBoxBounds);
+    decodedTextBox->setClickCallback([this]() { handleTextBoxClick(); });
+
+    // A zero-beat jelző érintése a kézi BFO-ba írja a mért eltérést
+    freqDisplayComp->setZeroBeatHandler([this]() { applyZeroBeatCorrection(); });
+
       createCommonVerticalButtons(pSi4735Manager); // ButtonsGroupManager használata
     createCommonHorizontalButtons();             // Alsó közös + AM specifikus vízszintes gombsor
 }
@@ -708,3 +764,232 @@ void AMScreen::updateFreqDisplayWidth() {
 
     freqDisplayComp->setWidth(newWidth);
 }
+
+// =====================================================================
+// Szöveg dekóderek (CW, RTTY)
+// =====================================================================
+
+/**
+ * @brief Szöveg dekóderek követése - a loop-ból hívódik
+ * @details SSB/CW módban megjeleníti a szöveg dobozt, a módnak megfelelő dekódert köti be a
+ * mintavételezőbe, átveszi a core1-en dekódolt karaktereket és frissíti az állapotsort.
+ */
+void AMScreen::updateTextDecoder() {
+
+    bool showTextBox = pSi4735Manager->isCurrentDemodSSBorCW();
+    if (showTextBox != textBoxShown) {
+        if (showTextBox) {
+            decodedTextBox->clear();
+            addChild(decodedTextBox);
+        } else {
+            removeChild(decodedTextBox);
+            const Rect &textBounds = decodedTextBox->getBounds();
+            tft.fillRect(textBounds.x, textBounds.y, textBounds.width, textBounds.height, TFT_COLOR_BACKGROUND);
+        }
+        textBoxShown = showTextBox;
+    }
+
+    TextDecoder decoder = selectTextDecoder();
+    if (decoder != activeDecoder) {
+        switchTextDecoder(decoder);
+    }
+
+    if (activeDecoder == TextDecoder::None) {
+        if (textBoxShown) {
+            updateTextDecoderStatus();
+        }
+        return;
+    }
+
+    // Ha közben más leállította a mintavételezést (pl. kikapcsolt mini audio kijelző), újraindítjuk
+    if (!audioCapture.isAdcBusy()) {
+        audioCapture.start(AM_AUDIO_BANDWIDTH_HZ * 2);
+    }
+
+    char c;
+    if (activeDecoder == TextDecoder::Cw) {
+        while (cwDecoder.popChar(c)) {
+            decodedTextBox->appendChar(c);
+        }
+    } else {
+        // LSB <-> USB váltásnál a dekóder marad, csak a mark/space cserélődik (a dekóder csak eltérésnél konfigurál újra)
+        rttyDecoder.setInverted(pSi4735Manager->isCurrentDemodUSB());
+        while (rttyDecoder.popChar(c)) {
+            decodedTextBox->appendChar(c);
+        }
+    }
+
+    updateTextDecoderStatus();
+}
+
+/**
+ * @brief Az aktuális módhoz tartozó dekóder
+ */
+AMScreen::TextDecoder AMScreen::selectTextDecoder() {
+    if (pSi4735Manager->isCurrentDemodCW()) {
+        return TextDecoder::Cw;
+    }
+    if ((pSi4735Manager->isCurrentDemodLSB() || pSi4735Manager->isCurrentDemodUSB()) && rtv::rttyDecoderMode != 0) {
+        return TextDecoder::Rtty;
+    }
+    return TextDecoder::None;
+}
+
+/**
+ * @brief Dekóder váltás: a régi leválasztása, az új beállítása és bekötése a mintavételezőbe
+ */
+void AMScreen::switchTextDecoder(TextDecoder decoder) {
+    DEBUG("AMScreen::switchTextDecoder(%u)\n", static_cast<uint8_t>(decoder));
+
+    audioCapture.setBlockProcessor(nullptr);
+
+    switch (decoder) {
+        case TextDecoder::Cw:
+            cwDecoder.setToneFrequency(config.data.cwReceiverOffsetHz);
+            cwDecoder.requestReset();
+            audioCapture.setBlockProcessor(&cwDecoder);
+            break;
+
+        case TextDecoder::Rtty:
+            rttyDecoder.setTones(config.data.rttyMarkFrequencyHz, config.data.rttyShiftHz);
+            rttyDecoder.setGain(config.data.miniAudioFftConfigRtty);
+            rttyDecoder.setBaudRate(static_cast<RttyDecoder::BaudRate>(rtv::rttyDecoderMode - 1));
+            rttyDecoder.setInverted(pSi4735Manager->isCurrentDemodUSB());
+            rttyDecoder.requestReset();
+            audioCapture.setBlockProcessor(&rttyDecoder);
+            break;
+
+        default:
+            break;
+    }
+
+    decodedTextBox->clear();
+    activeDecoder = decoder;
+    textDecoderStatusDirty = true;
+    updateTextDecoderStatus();
+}
+
+/**
+ * @brief Az állapotsor frissítése (a szöveg doboz csak változásnál rajzol)
+ */
+void AMScreen::updateTextDecoderStatus() {
+
+    // Csak a kijelzett értékek változásakor formázunk
+    uint8_t wpm = cwDecoder.getWpm();
+    bool rttySignal = rttyDecoder.isSignalPresent();
+    if (!textDecoderStatusDirty && (activeDecoder != TextDecoder::Cw || wpm == lastCwWpm) && (activeDecoder != TextDecoder::Rtty || rttySignal == lastRttySignal)) {
+        return;
+    }
+    textDecoderStatusDirty = false;
+    lastCwWpm = wpm;
+    lastRttySignal = rttySignal;
+
+    char status[DecodedTextBox::STATUS_LENGTH];
+    switch (activeDecoder) {
+        case TextDecoder::Cw:
+            snprintf(status, sizeof(status), "CW  %u WPM  %u Hz", wpm, cwDecoder.getToneFrequency());
+            break;
+
+        case TextDecoder::Rtty:
+            snprintf(status, sizeof(status), "RTTY  %s Bd  %u/%u Hz  %s", RttyDecoder::getBaudRateLabel(rttyDecoder.getBaudRate()), rttyDecoder.getMarkFrequency(),
+                     rttyDecoder.getShift(), rttySignal ? "SYNC" : "----");
+            break;
+
+        default:
+            snprintf(status, sizeof(status), "RTTY off - touch to select speed");
+            break;
+    }
+
+    decodedTextBox->setStatus(status);
+}
+
+/**
+ * @brief Szöveg doboz érintés: SSB módban az RTTY sebesség léptetése
+ */
+void AMScreen::handleTextBoxClick() {
+    if (pSi4735Manager->isCurrentDemodCW()) {
+        decodedTextBox->clear();
+        return;
+    }
+    rtv::rttyDecoderMode = (rtv::rttyDecoderMode + 1) % (static_cast<uint8_t>(RttyDecoder::BaudRate::Count) + 1);
+    if (rtv::rttyDecoderMode != 0) {
+        rttyDecoder.setBaudRate(static_cast<RttyDecoder::BaudRate>(rtv::rttyDecoderMode - 1));
+        textDecoderStatusDirty = true;
+    }
+}
+
+// =====================================================================
+// Zero-beat jelző (SSB/CW)
+// =====================================================================
+
+/**
+ * @brief Zero-beat detektor követése - a loop-ból hívódik
+ * @details SSB/CW módba lépéskor létrehozza a detektort és blokk fogyasztóként a mintavételezőre köti,
+ * kilépéskor felszabadítja. A célhang mindig a config.data.cwReceiverOffsetHz (SSB-ben is erre húzható rá egy vivő).
+ */
+void AMScreen::updateZeroBeat() {
+
+    if (!pSi4735Manager->isCurrentDemodSSBorCW()) {
+        if (zeroBeat) {
+            zeroBeat.reset();
+            freqDisplayComp->hideZeroBeat();
+        }
+        zeroBeatUnavailable = false;
+        return;
+    }
+
+    if (!zeroBeat) {
+        if (zeroBeatUnavailable) {
+            return;
+        }
+        zeroBeat.reset(new (std::nothrow) ZeroBeatDetector());
+        if (!zeroBeat || !zeroBeat->attach()) {
+            DEBUG("AMScreen: zero-beat detector not available\n");
+            zeroBeat.reset();
+            zeroBeatUnavailable = true;
+            return;
+        }
+        freqDisplayComp->setZeroBeat(false, 0);
+    }
+
+    zeroBeat->setTargetFrequency(config.data.cwReceiverOffsetHz);
+
+    // Ha közben más leállította a mintavételezést (pl. kikapcsolt mini audio kijelző), újraindítjuk
+    if (!audioCapture.isAdcBusy()) {
+        audioCapture.start(AM_AUDIO_BANDWIDTH_HZ * 2);
+    }
+
+    if (zeroBeat->update()) {
+        freqDisplayComp->setZeroBeat(zeroBeat->hasTone(), zeroBeat->getOffsetHz());
+    }
+}
+
+/**
+ * @brief A mért eltérés korrekciója a kézi BFO eltolásban
+ * @details USB és CW módban a BFO növelése a hangot ugyanennyivel emeli, LSB-ben süllyeszti (lásd a hangolás
+ * előjelét a handleRotary()-ben), így a korrekció USB/CW-ben -eltérés, LSB-ben +eltérés.
+ */
+void AMScreen::applyZeroBeatCorrection() {
+    if (!zeroBeat || !zeroBeat->hasTone()) {
+        return;
+    }
+
+    int16_t offset = zeroBeat->getOffsetHz();
+    int16_t correction = pSi4735Manager->isCurrentDemodLSB() ? offset : -offset;
+    rtv::currentBFOmanu = constrain(rtv::currentBFOmanu + correction, -999, 999);
+    applySsbBfo();
+    DEBUG("AMScreen: zero-beat correction %d Hz, BFO manual %d Hz\n", correction, rtv::currentBFOmanu);
+
+    // A régi hang becslése már nem érvényes; BFO módban a kijelzett kézi BFO is változott
+    zeroBeat->reset();
+    freqDisplayComp->setFrequency(pSi4735Manager->getSi4735().getCurrentFrequency(), true);
+}
+
+/**
+ * @brief A BFO beállítása a chipen
+ */
+void AMScreen::applySsbBfo() {
+    const int16_t cwBaseOffset = pSi4735Manager->isCurrentDemodCW() ? config.data.cwReceiverOffsetHz : 0;
+    int16_t bfoToSet = cwBaseOffset + rtv::currentBFO + rtv::currentBFOmanu;
+    pSi4735Manager->getSi4735().setSSBBfo(bfoToSet);
+}
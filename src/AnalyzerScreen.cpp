@@ -0,0 +1,569 @@
+/**
+ * @file AnalyzerScreen.cpp
+ * @brief Teljes képernyős audio analizátor implementáció
+ */
+
+#include "AnalyzerScreen.h"
+#include "AudioCapture.h"
+#include "Config.h"
+#include "Si4735Manager.h"
+#include "TftDma.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+constexpr uint16_t SPECTRUM_COLOR = TFT_CYAN;
+constexpr uint16_t PEAK_HOLD_COLOR = TFT_YELLOW;
+constexpr uint16_t GRID_COLOR = TFT_DARKGREY;
+constexpr uint16_t LABEL_COLOR = TFT_SILVER;
+constexpr uint16_t MARKER_COLOR = TFT_RED;
+
+constexpr uint8_t GRID_STEP_DB = 10; // Vízszintes rács vonalak távolsága
+
+/**
+ * @brief log2 közelítés 1/256 egységben (Mitchell: egész rész a legmagasabb bit, tört rész a mantissza felső 8 bitje)
+ * @details A hiba legfeljebb ~0.09 (kb. 0.5 dB), kijelzéshez bőven elég, és nem kell lebegőpontos logaritmus oszloponként.
+ */
+inline int32_t log2Q8(uint32_t value) {
+    if (value == 0) {
+        return 0;
+    }
+    int32_t msb = 31 - __builtin_clz(value);
+    uint32_t mantissa = msb >= 8 ? (value >> (msb - 8)) : (value << (8 - msb));
+    return (msb << 8) + static_cast<int32_t>(mantissa & 0xFF);
+}
+} // namespace
+
+/**
+ * @brief Választható sávszélességek: SSB/CW, AM, szélesebb AM szűrők, FM audio
+ * @details A mintavételezés legalább ~24 kS/s, a decimátor hozza le a sáv kétszeresére, így a sáv feletti hangok
+ * nem hajlanak vissza a kijelzett tartományba (az ADC előtt nincs analóg alias szűrő).
+ */
+const AnalyzerScreen::SpanOption AnalyzerScreen::SPAN_OPTIONS[] = {
+    {3000, 500, 4},
+    {6000, 1000, 2},
+    {10000, 2000, 2},
+    {15000, 2500, 1},
+};
+const uint8_t AnalyzerScreen::SPAN_OPTION_COUNT = ARRAY_ITEM_COUNT(AnalyzerScreen::SPAN_OPTIONS);
+
+/**
+ * @brief Konstruktor
+ */
+AnalyzerScreen::AnalyzerScreen(TFT_eSPI &tft, Si4735Manager *si4735Manager)
+    : UIScreen(tft, SCREEN_NAME_ANALYZER, si4735Manager), spectrumSprite(nullptr), waterfallSprite(nullptr), spritesCreated(false), buffersAvailable(false), waterfallRow(0),
+      frames(MAX_FFT_SIZE), window(MAX_FFT_SIZE), fft(MAX_FFT_SIZE), fftInput(nullptr), magnitudes(nullptr), levels(nullptr), peakHold(nullptr), fftSize(AUDIO_FFT_SIZE_DEFAULT),
+      lastSequence(0), spanIndex(1), windowType(AudioWindow::Type::Hann), peakHoldEnabled(true), agcGainQ8(AudioAgc::UNITY_GAIN_Q8), blockConsumer(AudioCapture::INVALID_CONSUMER),
+      nextFrameTime(0), fpsWindowStart(0), framesInWindow(0), framesPerSecond(0), averageFrameMicros(0), infoDirty(true) {
+
+    if (AudioFft::isSupportedSize(config.data.audioFftSize) && config.data.audioFftSize <= MAX_FFT_SIZE) {
+        fftSize = config.data.audioFftSize;
+    }
+
+    // Alapértelmezett sávszélesség: FM sávon a teljes FM audio, egyébként az AM audio sáv
+    if (si4735Manager && si4735Manager->isCurrentBandFM()) {
+        spanIndex = SPAN_OPTION_COUNT - 1;
+    }
+
+    buildWaterfallPalette();
+    if (!allocateBuffers()) {
+        DEBUG("AnalyzerScreen: memória foglalás sikertelen, a képernyő inaktív\n");
+    }
+
+    layoutComponents();
+}
+
+/**
+ * @brief Destruktor
+ */
+AnalyzerScreen::~AnalyzerScreen() {
+    audioCapture.unregisterConsumer(blockConsumer);
+    audioCapture.stop();
+    releaseBuffers();
+}
+
+/**
+ * @brief Sprite-ok és minta pufferek lefoglalása
+ * @details A spektrum sprite 8 bites, a waterfall csak egyetlen sornyi 16 bites sprite-ot foglal.
+ */
+bool AnalyzerScreen::allocateBuffers() {
+    spectrumSprite = new (std::nothrow) TFT_eSprite(&tft);
+    waterfallSprite = new (std::nothrow) TFT_eSprite(&tft);
+    if (spectrumSprite && waterfallSprite) {
+        spectrumSprite->setColorDepth(8);
+        waterfallSprite->setColorDepth(16);
+        spritesCreated = spectrumSprite->createSprite(AREA_WIDTH, SPECTRUM_HEIGHT) != nullptr && waterfallSprite->createSprite(AREA_WIDTH, 1) != nullptr;
+    }
+
+    fftInput = new (std::nothrow) int16_t[MAX_FFT_SIZE];
+    magnitudes = new (std::nothrow) uint16_t[MAX_FFT_SIZE / 2];
+    levels = new (std::nothrow) uint8_t[AREA_WIDTH];
+    peakHold = new (std::nothrow) uint8_t[AREA_WIDTH];
+
+    if (!spritesCreated || !fft.isAvailable() || !frames.isAvailable() || !window.isAvailable() || !fftInput || !magnitudes || !levels || !peakHold) {
+        releaseBuffers();
+        return false;
+    }
+
+    blockConsumer = audioCapture.registerConsumer();
+    if (blockConsumer == AudioCapture::INVALID_CONSUMER) {
+        releaseBuffers();
+        return false;
+    }
+
+    frames.configure(fftSize);
+    memset(levels, 0, AREA_WIDTH);
+    memset(peakHold, 0, AREA_WIDTH);
+    buffersAvailable = true;
+    return true;
+}
+
+/**
+ * @brief Sprite-ok és pufferek felszabadítása
+ */
+void AnalyzerScreen::releaseBuffers() {
+    if (spectrumSprite) {
+        spectrumSprite->deleteSprite();
+        delete spectrumSprite;
+        spectrumSprite = nullptr;
+    }
+    if (waterfallSprite) {
+        waterfallSprite->deleteSprite();
+        delete waterfallSprite;
+        waterfallSprite = nullptr;
+    }
+    spritesCreated = false;
+
+    delete[] fftInput;
+    delete[] magnitudes;
+    delete[] levels;
+    delete[] peakHold;
+    fftInput = nullptr;
+    magnitudes = nullptr;
+    levels = nullptr;
+    peakHold = nullptr;
+    buffersAvailable = false;
+}
+
+/**
+ * @brief Waterfall paletta: fekete -> kék -> cián -> sárga -> piros
+ */
+void AnalyzerScreen::buildWaterfallPalette() {
+    static constexpr uint8_t STOPS[][3] = {{0, 0, 0}, {0, 0, 255}, {0, 255, 255}, {255, 255, 0}, {255, 0, 0}};
+    constexpr uint8_t SEGMENTS = ARRAY_ITEM_COUNT(STOPS) - 1;
+
+    for (uint8_t i = 0; i < WATERFALL_COLORS; i++) {
+        uint16_t position = static_cast<uint16_t>(i) * SEGMENTS * 256 / (WATERFALL_COLORS - 1); // Paletta pozíció 1/256 szakasz egységben
+        uint8_t segment = std::min<uint8_t>(position >> 8, SEGMENTS - 1);
+        uint16_t t = position - segment * 256;
+        const uint8_t *from = STOPS[segment];
+        const uint8_t *to = STOPS[segment + 1];
+        waterfallPalette[i] = tft.color565(from[0] + ((to[0] - from[0]) * t) / 256, from[1] + ((to[1] - from[1]) * t) / 256, from[2] + ((to[2] - from[2]) * t) / 256);
+    }
+}
+
+/**
+ * @brief Gombsor létrehozása (Size, Span, Hold, Win, Back)
+ */
+void AnalyzerScreen::layoutComponents() {
+    constexpr int16_t margin = 5;
+    uint16_t buttonHeight = UIButton::DEFAULT_BUTTON_HEIGHT;
+    uint16_t buttonY = UIComponent::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT - margin;
+    uint16_t buttonWidth = 62;
+    uint16_t buttonSpacing = 5;
+
+    // Size gomb - FFT méret léptetése
+    uint16_t sizeX = margin;
+    sizeButton = std::make_shared<UIButton>(tft, SIZE_BUTTON_ID, Rect(sizeX, buttonY, buttonWidth, buttonHeight), "Size", UIButton::ButtonType::Pushable,
+                                            UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+                                                if (event.state == UIButton::EventButtonState::Clicked) {
+                                                    cycleFftSize();
+                                                }
+                                            });
+    addChild(sizeButton);
+
+    // Span gomb - megjelenített sávszélesség léptetése
+    uint16_t spanX = sizeX + buttonWidth + buttonSpacing;
+    spanButton = std::make_shared<UIButton>(tft, SPAN_BUTTON_ID, Rect(spanX, buttonY, buttonWidth, buttonHeight), "Span", UIButton::ButtonType::Pushable,
+                                            UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+                                                if (event.state == UIButton::EventButtonState::Clicked) {
+                                                    cycleSpan();
+                                                }
+                                            });
+    addChild(spanButton);
+
+    // Hold gomb - csúcstartás be/ki
+    uint16_t holdX = spanX + buttonWidth + buttonSpacing;
+    holdButton = std::make_shared<UIButton>(tft, HOLD_BUTTON_ID, Rect(holdX, buttonY, buttonWidth, buttonHeight), "Hold", UIButton::ButtonType::Toggleable,
+                                            peakHoldEnabled ? UIButton::ButtonState::On : UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+                                                if (event.state == UIButton::EventButtonState::On || event.state == UIButton::EventButtonState::Off) {
+                                                    setPeakHold(event.state == UIButton::EventButtonState::On);
+                                                }
+                                            });
+    addChild(holdButton);
+
+    // Win gomb - ablak típus léptetése
+    uint16_t windowX = holdX + buttonWidth + buttonSpacing;
+    windowButton = std::make_shared<UIButton>(tft, WINDOW_BUTTON_ID, Rect(windowX, buttonY, buttonWidth, buttonHeight), "Win", UIButton::ButtonType::Pushable,
+                                              UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+                                                  if (event.state == UIButton::EventButtonState::Clicked) {
+                                                      cycleWindow();
+                                                  }
+                                              });
+    addChild(windowButton);
+
+    // Back gomb - visszalépés (jobbra igazítva)
+    uint16_t backButtonWidth = 60;
+    uint16_t backButtonX = UIComponent::SCREEN_W - backButtonWidth - margin;
+    backButton = std::make_shared<UIButton>(tft, BACK_BUTTON_ID, Rect(backButtonX, buttonY, backButtonWidth, buttonHeight), "Back", UIButton::ButtonType::Pushable,
+                                            UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+                                                if (event.state == UIButton::EventButtonState::Clicked) {
+                                                    if (getScreenManager()) {
+                                                        getScreenManager()->goBack();
+                                                    }
+                                                }
+                                            });
+    addChild(backButton);
+}
+
+/**
+ * @brief Statikus tartalom: cím, keretek, frekvencia skála, üres waterfall
+ */
+void AnalyzerScreen::drawContent() {
+    tft.fillScreen(TFT_BLACK);
+
+    tft.setFreeFont();
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextSize(2);
+    tft.setTextDatum(TL_DATUM);
+    tft.drawString("AUDIO ANALYZER", AREA_X, 4);
+
+    tft.drawRect(AREA_X - 1, SPECTRUM_Y - 1, AREA_WIDTH + 2, SPECTRUM_HEIGHT + 2, GRID_COLOR);
+    tft.drawRect(AREA_X - 1, WATERFALL_Y - 1, AREA_WIDTH + 2, WATERFALL_HEIGHT + 2, GRID_COLOR);
+    drawFrequencyScale();
+
+    // A waterfall elölről indul, a csúcstartás törlődik
+    waterfallRow = 0;
+    if (peakHold) {
+        memset(peakHold, 0, AREA_WIDTH);
+    }
+
+    if (!buffersAvailable) {
+        tft.setTextSize(1);
+        tft.setTextDatum(MC_DATUM);
+        tft.setTextColor(GRID_COLOR, TFT_BLACK);
+        tft.drawString("No memory", AREA_X + AREA_WIDTH / 2, SPECTRUM_Y + SPECTRUM_HEIGHT / 2);
+        return;
+    }
+
+    infoDirty = true;
+    drawInfo();
+}
+
+/**
+ * @brief Frekvencia címkék a spektrum és a waterfall között
+ */
+void AnalyzerScreen::drawFrequencyScale() {
+    const SpanOption &span = SPAN_OPTIONS[spanIndex];
+
+    tft.fillRect(0, SCALE_Y, UIComponent::SCREEN_W, WATERFALL_Y - 1 - SCALE_Y, TFT_BLACK);
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextColor(LABEL_COLOR, TFT_BLACK);
+
+    for (uint16_t frequency = 0; frequency <= span.maxFrequencyHz; frequency += span.labelStepHz) {
+        int16_t x = AREA_X + static_cast<uint32_t>(frequency) * (AREA_WIDTH - 1) / span.maxFrequencyHz;
+        tft.setTextDatum(frequency == 0 ? TL_DATUM : (frequency == span.maxFrequencyHz ? TR_DATUM : TC_DATUM));
+        char label[8];
+        if (frequency % 1000 == 0) {
+            snprintf(label, sizeof(label), "%uk", frequency / 1000);
+        } else {
+            snprintf(label, sizeof(label), "%u.%uk", frequency / 1000, (frequency % 1000) / 100);
+        }
+        tft.drawString(label, x, SCALE_Y + 1);
+    }
+}
+
+/**
+ * @brief Információs sor: FFT méret, felbontás, sávszélesség, erősítés, képkocka sebesség (jobbra igazítva)
+ */
+void AnalyzerScreen::drawInfo() {
+    if (!infoDirty) {
+        return;
+    }
+    infoDirty = false;
+    tftDma.fence();
+
+    char gainText[8];
+    if (config.data.miniAudioFftConfigAnalyzer > 0.0f) {
+        snprintf(gainText, sizeof(gainText), "x%.1f", config.data.miniAudioFftConfigAnalyzer);
+    } else {
+        strcpy(gainText, "Auto");
+    }
+
+    char info[64];
+    float binWidth = static_cast<float>(getSampleRate()) / fftSize;
+    snprintf(info, sizeof(info), "N:%u  RBW:%.1fHz  %s  Gain:%s  %ufps", fftSize, binWidth, AudioWindow::getTypeName(windowType), gainText, framesPerSecond);
+
+    constexpr int16_t infoX = 200; // A cím utáni terület
+    tft.fillRect(infoX, INFO_Y, UIComponent::SCREEN_W - infoX, 8, TFT_BLACK);
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(LABEL_COLOR, TFT_BLACK);
+    tft.drawString(info, AREA_X + AREA_WIDTH, INFO_Y);
+}
+
+/**
+ * @brief Mintavételezés (újra)indítása a sávhoz tartozó frekvenciával, a decimátor beállítása
+ */
+void AnalyzerScreen::restartCapture() {
+    frames.reset();
+    decimator.configure(SPAN_OPTIONS[spanIndex].decimation);
+    audioCapture.flushBlocks(blockConsumer);
+    audioCapture.start(getCaptureRate());
+}
+
+/**
+ * @brief Loop: blokkok átvétele, rögzített ütemű képkockák
+ * @details A következő képkocka ideje az előzőhöz igazodik (nincs csúszás a feldolgozási idő miatt);
+ * ha a feldolgozás egy teljes időköznél többet késett, az ütem újraindul (nincs képkocka torlódás).
+ * Egy ütemben csak akkor készül új spektrum, ha az FFT keret legalább fele új (szűk sávnál és nagy
+ * FFT méretnél így ritkább, de nincs két közel azonos waterfall sor).
+ */
+void AnalyzerScreen::handleOwnLoop() {
+    if (!buffersAvailable) {
+        return;
+    }
+
+    if (!audioCapture.isAdcBusy()) {
+        restartCapture();
+    }
+
+    consumeBlocks();
+
+    uint32_t now = millis();
+    if (static_cast<int32_t>(now - nextFrameTime) < 0) {
+        return;
+    }
+    nextFrameTime += FRAME_INTERVAL_MS;
+    if (static_cast<int32_t>(now - nextFrameTime) >= 0) {
+        nextFrameTime = now + FRAME_INTERVAL_MS;
+    }
+
+    if (frames.isFrameReady()) {
+        uint32_t start = micros();
+        processFrame();
+        frames.consumeFrame();
+        renderSpectrum();
+        pushWaterfallLine();
+        uint32_t frameMicros = micros() - start;
+        averageFrameMicros = averageFrameMicros == 0 ? frameMicros : (averageFrameMicros * 7 + frameMicros) / 8;
+        framesInWindow++;
+    }
+
+    // Képkocka sebesség másodpercenként
+    if (now - fpsWindowStart >= 1000) {
+        if (framesPerSecond != framesInWindow) {
+            framesPerSecond = framesInWindow;
+            infoDirty = true;
+        }
+        framesInWindow = 0;
+        fpsWindowStart = now;
+    }
+    drawInfo();
+}
+
+/**
+ * @brief Minden várakozó blokk decimálása és átvétele az átlapolt keret pufferbe
+ */
+void AnalyzerScreen::consumeBlocks() {
+    const AudioBlock *block;
+    while ((block = audioCapture.peekBlock(blockConsumer)) != nullptr) {
+
+        // Sávszélesség váltás után a régi mintavételi frekvenciájú blokkok eldobódnak
+        if (block->sampleRate != getCaptureRate()) {
+            audioCapture.releaseBlock(blockConsumer);
+            frames.reset();
+            continue;
+        }
+
+        // Kimaradt blokk (túlcsordulás) után a régi minták és a szűrő állapota már nem folytonos
+        if (block->sequence != lastSequence + 1) {
+            frames.reset();
+            decimator.reset();
+        }
+        lastSequence = block->sequence;
+        agcGainQ8 = block->agcGainQ8;
+
+        uint16_t count = decimator.process(block->samples, AUDIO_CAPTURE_BLOCK_SIZE, decimated);
+        audioCapture.releaseBlock(blockConsumer);
+        frames.write(decimated, count);
+    }
+}
+
+/**
+ * @brief Referencia szint (a kijelző teteje) az erősítés beállítás szerint
+ * @details Teljes kivezérlésű szinusz FFT csúcsa ablakozva: 32767 * koherens erősítés, azaz Q15-ben maga a koherens erősítés.
+ * @return A 0 dB-nek megfelelő magnitúdó (auto gain: az AudioAgc erősítése szerint)
+ */
+float AnalyzerScreen::computeReference() const {
+    return window.getCoherentGainQ15() / AudioAgc::getEffectiveGain(config.data.miniAudioFftConfigAnalyzer, agcGainQ8);
+}
+
+/**
+ * @brief FFT és oszloponkénti dB szintek (a dinamika tartományon belül 0..255)
+ */
+void AnalyzerScreen::processFrame() {
+    window.configure(windowType, fftSize);
+    window.apply(frames.getFrame(), fftInput);
+    fft.computeMagnitudes(fftInput, fftSize, magnitudes);
+
+    uint16_t bins = fftSize / 2;
+    int32_t referenceLog2 = log2Q8(std::max<uint32_t>(static_cast<uint32_t>(computeReference()), 1));
+
+    // Szint = 255 + dB * 255 / DISPLAY_RANGE_DB, ahol dB = log2 * 6.02; a szorzó Q16-ban (a log2 1/256 egységben van)
+    constexpr int32_t LEVEL_PER_LOG2_Q16 = static_cast<int32_t>(6.0206f * 255 / DISPLAY_RANGE_DB * 256 + 0.5f);
+
+    for (uint16_t x = 0; x < AREA_WIDTH; x++) {
+        uint16_t firstBin = 1 + (static_cast<uint32_t>(x) * (bins - 1)) / AREA_WIDTH;
+        uint16_t lastBin = 1 + (static_cast<uint32_t>(x + 1) * (bins - 1)) / AREA_WIDTH;
+        uint16_t value = 0;
+        for (uint16_t bin = firstBin; bin < std::max<uint16_t>(lastBin, firstBin + 1); bin++) {
+            value = std::max(value, magnitudes[bin]);
+        }
+        int32_t level = 255 + (((log2Q8(value) - referenceLog2) * LEVEL_PER_LOG2_Q16) >> 16);
+        levels[x] = value == 0 ? 0 : constrain(level, 0, 255);
+    }
+}
+
+/**
+ * @brief Spektrum sprite: dB rács, kitöltött spektrum, csúcstartó vonal
+ */
+void AnalyzerScreen::renderSpectrum() {
+    const SpanOption &span = SPAN_OPTIONS[spanIndex];
+    uint16_t maxHeight = SPECTRUM_HEIGHT - 1;
+
+    spectrumSprite->fillSprite(TFT_BLACK);
+    for (uint8_t db = GRID_STEP_DB; db < DISPLAY_RANGE_DB; db += GRID_STEP_DB) {
+        spectrumSprite->drawFastHLine(0, static_cast<uint32_t>(db) * maxHeight / DISPLAY_RANGE_DB, AREA_WIDTH, GRID_COLOR);
+    }
+    for (uint16_t frequency = span.labelStepHz; frequency < span.maxFrequencyHz; frequency += span.labelStepHz) {
+        spectrumSprite->drawFastVLine(static_cast<uint32_t>(frequency) * (AREA_WIDTH - 1) / span.maxFrequencyHz, 0, SPECTRUM_HEIGHT, GRID_COLOR);
+    }
+
+    for (uint16_t x = 0; x < AREA_WIDTH; x++) {
+        uint8_t height = static_cast<uint16_t>(levels[x]) * maxHeight / 255;
+        if (height > 0) {
+            spectrumSprite->drawFastVLine(x, SPECTRUM_HEIGHT - height, height, SPECTRUM_COLOR);
+        }
+
+        if (peakHoldEnabled) {
+            peakHold[x] = std::max<int16_t>(height, static_cast<int16_t>(peakHold[x]) - PEAK_HOLD_DECAY);
+            if (peakHold[x] > 0) {
+                spectrumSprite->drawPixel(x, SPECTRUM_HEIGHT - peakHold[x], PEAK_HOLD_COLOR);
+            }
+        }
+    }
+
+    tftDma.pushSprite(*spectrumSprite, AREA_X, SPECTRUM_Y);
+}
+
+/**
+ * @brief Az új waterfall sor kitolása a gördülő sor pozícióra, a legújabb sor jelölőjének léptetése
+ * @details A sor összeállítása még a spektrum kitolása alatt fut; a jelölő (közvetlen rajzolás) a sor előtt
+ * kerül ki, így a sor kitolása alatt a CPU már továbbhalad.
+ */
+void AnalyzerScreen::pushWaterfallLine() {
+    for (uint16_t x = 0; x < AREA_WIDTH; x++) {
+        waterfallSprite->drawPixel(x, 0, waterfallPalette[levels[x] * WATERFALL_COLORS / 256]);
+    }
+
+    constexpr int16_t markerX = AREA_X - 2 - WATERFALL_MARKER_WIDTH;
+    uint16_t previousRow = waterfallRow == 0 ? WATERFALL_HEIGHT - 1 : waterfallRow - 1;
+    tftDma.fence();
+    tft.drawFastHLine(markerX, WATERFALL_Y + previousRow, WATERFALL_MARKER_WIDTH, TFT_BLACK);
+    tft.drawFastHLine(markerX, WATERFALL_Y + waterfallRow, WATERFALL_MARKER_WIDTH, MARKER_COLOR);
+
+    tftDma.pushSprite(*waterfallSprite, AREA_X, WATERFALL_Y + waterfallRow);
+
+    waterfallRow = (waterfallRow + 1) % WATERFALL_HEIGHT;
+}
+
+/**
+ * @brief Size gomb: FFT méret léptetése (AUDIO_FFT_SIZE_MIN..MAX_FFT_SIZE), a konfigurációba is visszaírjuk
+ */
+void AnalyzerScreen::cycleFftSize() {
+    fftSize = fftSize >= MAX_FFT_SIZE ? AUDIO_FFT_SIZE_MIN : fftSize * 2;
+    config.data.audioFftSize = fftSize;
+    if (buffersAvailable) {
+        frames.configure(fftSize);
+    }
+    infoDirty = true;
+}
+
+/**
+ * @brief Span gomb: megjelenített sávszélesség léptetése, a mintavételezés új frekvenciával indul
+ */
+void AnalyzerScreen::cycleSpan() {
+    spanIndex = (spanIndex + 1) % SPAN_OPTION_COUNT;
+    if (buffersAvailable) {
+        restartCapture();
+        memset(peakHold, 0, AREA_WIDTH);
+    }
+    drawFrequencyScale();
+    infoDirty = true;
+}
+
+/**
+ * @brief Hold gomb: csúcstartás be/ki (tiszta lappal indul)
+ */
+void AnalyzerScreen::setPeakHold(bool enabled) {
+    peakHoldEnabled = enabled;
+    if (peakHold) {
+        memset(peakHold, 0, AREA_WIDTH);
+    }
+}
+
+/**
+ * @brief Win gomb: ablak típus léptetése (a csúcstartás tiszta lappal indul)
+ */
+void AnalyzerScreen::cycleWindow() {
+    windowType = static_cast<AudioWindow::Type>((static_cast<uint8_t>(windowType) + 1) % static_cast<uint8_t>(AudioWindow::Type::Count));
+    if (peakHold) {
+        memset(peakHold, 0, AREA_WIDTH);
+    }
+    infoDirty = true;
+}
+
+/**
+ * @brief Rotary: erősítés állítás (Auto -> kézi lépések), klikk: vissza auto módba
+ */
+bool AnalyzerScreen::handleRotary(const RotaryEvent &event) {
+    float &gain = config.data.miniAudioFftConfigAnalyzer;
+
+    if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
+        gain = 0.0f;
+        infoDirty = true;
+        return true;
+    }
+
+    if (event.direction == RotaryEvent::Direction::Up) {
+        gain = gain > 0.0f ? std::min(gain + MANUAL_GAIN_STEP, MANUAL_GAIN_MAX) : 1.0f;
+        infoDirty = true;
+        return true;
+    }
+
+    if (event.direction == RotaryEvent::Direction::Down) {
+        if (gain > 1.0f) {
+            gain = std::max(gain - MANUAL_GAIN_STEP, 1.0f);
+        } else {
+            gain = 0.0f; // Az 1x alatti lépés az auto mód
+        }
+        infoDirty = true;
+        return true;
+    }
+
+    return UIScreen::handleRotary(event);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file AudioAgc.cpp
+ * @brief Audio AGC implementáció
+ */
+
+#include "AudioAgc.h"
+
+/**
+ * @brief Konstruktor
+ */
+AudioAgc::AudioAgc() : envelopeQ8(TARGET_LEVEL << 8), gainQ8(UNITY_GAIN_Q8), envelope(TARGET_LEVEL) {}
+
+/**
+ * @brief Alapállapot: a burkoló a célértéken, 1x erősítés
+ */
+void AudioAgc::reset() {
+    envelopeQ8 = TARGET_LEVEL << 8;
+    envelope.store(TARGET_LEVEL, std::memory_order_relaxed);
+    gainQ8.store(UNITY_GAIN_Q8, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Burkoló és erősítés frissítése egy blokk alapján
+ * @details Blokkonként egy csúcskeresés, egy léptetéses szűrő lépés és egy osztás; a minták nem módosulnak.
+ */
+void AudioAgc::processBlock(const int16_t *samples, uint16_t count) {
+    int32_t peak = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t magnitude = samples[i] < 0 ? -static_cast<int32_t>(samples[i]) : samples[i];
+        if (magnitude > peak) {
+            peak = magnitude;
+        }
+    }
+
+    int32_t peakQ8 = peak << 8;
+    if (peakQ8 > envelopeQ8) {
+        envelopeQ8 += (peakQ8 - envelopeQ8) >> ATTACK_SHIFT;
+    } else {
+        envelopeQ8 -= (envelopeQ8 - peakQ8) >> DECAY_SHIFT;
+    }
+
+    // gain = TARGET / envelope, Q8-ban: (TARGET << 16) / envelopeQ8
+    uint32_t gain = (static_cast<uint32_t>(TARGET_LEVEL) << 16) / static_cast<uint32_t>(envelopeQ8 > 0 ? envelopeQ8 : 1);
+    gain = constrain(gain, static_cast<uint32_t>(MIN_GAIN_Q8), static_cast<uint32_t>(MAX_GAIN_Q8));
+
+    envelope.store(static_cast<uint16_t>(envelopeQ8 >> 8), std::memory_order_relaxed);
+    gainQ8.store(static_cast<uint16_t>(gain), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Konfigurációs gain érték Q8 erősítéssé alakítása (0: auto)
+ */
+uint16_t AudioAgc::toManualGainQ8(float gainConfig) {
+    if (gainConfig <= 0.0f) {
+        return 0;
+    }
+    return constrain(static_cast<uint32_t>(gainConfig * UNITY_GAIN_Q8 + 0.5f), static_cast<uint32_t>(MIN_GAIN_Q8), static_cast<uint32_t>(MAX_GAIN_Q8));
+}
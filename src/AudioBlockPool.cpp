@@ -0,0 +1,140 @@
+/**
+ * @file AudioBlockPool.cpp
+ * @brief Közös audio blokk pool implementáció
+ */
+
+#include "AudioBlockPool.h"
+
+/**
+ * @brief Konstruktor
+ */
+AudioBlockPool::AudioBlockPool() : requestedMask(0), activeMask(0), exhaustedCount(0), nextSlot(0) {
+    for (uint8_t slot = 0; slot < AUDIO_CAPTURE_POOL_BLOCKS; slot++) {
+        for (uint8_t consumer = 0; consumer < AUDIO_CAPTURE_MAX_CONSUMERS; consumer++) {
+            held[slot][consumer].store(false, std::memory_order_relaxed);
+        }
+    }
+    for (uint8_t consumer = 0; consumer < AUDIO_CAPTURE_MAX_CONSUMERS; consumer++) {
+        dropCounts[consumer].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Új fogyasztó regisztrálása
+ * @details Csak olyan hely adható ki, amit az író sem használ már (a korábbi leiratkozás átvéve).
+ */
+uint8_t AudioBlockPool::registerConsumer() {
+    uint8_t used = requestedMask.load(std::memory_order_relaxed) | activeMask.load(std::memory_order_acquire);
+    for (uint8_t consumer = 0; consumer < AUDIO_CAPTURE_MAX_CONSUMERS; consumer++) {
+        if (used & (1u << consumer)) {
+            continue;
+        }
+        flush(consumer);
+        dropCounts[consumer].store(0, std::memory_order_relaxed);
+        requestedMask.store(requestedMask.load(std::memory_order_relaxed) | (1u << consumer), std::memory_order_release);
+        return consumer;
+    }
+
+    DEBUG("AudioBlockPool: no free consumer slot\n");
+    return INVALID_CONSUMER;
+}
+
+/**
+ * @brief Fogyasztó leiratkozásának kérése
+ */
+void AudioBlockPool::unregisterConsumer(uint8_t consumer) {
+    if (consumer >= AUDIO_CAPTURE_MAX_CONSUMERS) {
+        return;
+    }
+    requestedMask.store(requestedMask.load(std::memory_order_relaxed) & ~(1u << consumer), std::memory_order_release);
+}
+
+/**
+ * @brief A peek()-kel kapott blokk elengedése
+ */
+void AudioBlockPool::release(uint8_t consumer) {
+    const uint8_t *slot = queues[consumer].peek();
+    if (slot == nullptr) {
+        return;
+    }
+    // Előbb a jelző: a sor helye utána újra írható, a blokkot pedig az író csak a jelző törlése után foglalja újra
+    held[*slot][consumer].store(false, std::memory_order_release);
+    queues[consumer].release();
+}
+
+/**
+ * @brief A fogyasztó minden várakozó blokkjának elengedése
+ */
+void AudioBlockPool::flush(uint8_t consumer) {
+    while (queues[consumer].peek() != nullptr) {
+        release(consumer);
+    }
+}
+
+/**
+ * @brief Legalább egy fogyasztó által tartott blokkok száma
+ */
+uint8_t AudioBlockPool::getBlocksInUse() const {
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < AUDIO_CAPTURE_POOL_BLOCKS; slot++) {
+        if (!isFree(slot)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Szabad-e a blokk (egyik fogyasztó sem tartja)
+ */
+bool AudioBlockPool::isFree(uint8_t slot) const {
+    for (uint8_t consumer = 0; consumer < AUDIO_CAPTURE_MAX_CONSUMERS; consumer++) {
+        if (held[slot][consumer].load(std::memory_order_acquire)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Egy szabad blokk kérése írásra (körbejáró keresés, így a legrégebben elengedett blokk kerül sorra)
+ */
+AudioBlock *AudioBlockPool::acquire() {
+    for (uint8_t i = 0; i < AUDIO_CAPTURE_POOL_BLOCKS; i++) {
+        uint8_t slot = (nextSlot + i) % AUDIO_CAPTURE_POOL_BLOCKS;
+        if (isFree(slot)) {
+            nextSlot = (slot + 1) % AUDIO_CAPTURE_POOL_BLOCKS;
+            return &blocks[slot];
+        }
+    }
+
+    // Egyetlen író: nem kell atomi read-modify-write
+    exhaustedCount.store(exhaustedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+/**
+ * @brief A kitöltött blokk átadása minden aktív fogyasztónak
+ */
+void AudioBlockPool::publish(const AudioBlock *block) {
+    uint8_t slot = static_cast<uint8_t>(block - blocks);
+    uint8_t mask = activeMask.load(std::memory_order_relaxed);
+
+    for (uint8_t consumer = 0; consumer < AUDIO_CAPTURE_MAX_CONSUMERS; consumer++) {
+        if (!(mask & (1u << consumer))) {
+            continue;
+        }
+
+        uint8_t *entry = queues[consumer].beginWrite();
+        if (entry == nullptr) {
+            // Ez a fogyasztó nem győzi: csak ő veszíti el a blokkot
+            dropCounts[consumer].store(dropCounts[consumer].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // A jelző a sorba tétel előtt: a commitWrite() release sorrendje miatt a fogyasztó már beállítva látja
+        held[slot][consumer].store(true, std::memory_order_relaxed);
+        *entry = slot;
+        queues[consumer].commitWrite();
+    }
+}
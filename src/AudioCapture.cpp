@@ -0,0 +1,277 @@
+/**
+ * @file AudioCapture.cpp
+ * @brief Audio mintavételező motor implementáció (ADC + DMA, core1)
+ */
+
+#include "AudioCapture.h"
+#include "pins.h"
+
+#include <hardware/adc.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+
+// Globális példány
+AudioCapture audioCapture;
+
+namespace {
+constexpr uint32_t ADC_CLOCK_HZ = 48000000; // Az ADC órajele (USB PLL)
+constexpr int16_t ADC_MIDPOINT = 2048;      // 12 bites ADC középértéke (DC előfeszítés)
+
+/**
+ * @brief DMA_IRQ_1 kezelő (a core1 regisztrálja, így ott is fut)
+ */
+void audioCaptureDmaIrqHandler() { audioCapture.handleDmaIrq(); }
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+AudioCapture::AudioCapture()
+    : requestedSampleRate(0), activeSampleRate(0), requestedProcessor(nullptr), activeProcessor(nullptr), sustainedSampleRate(0), capturedSamples(0), statsWindowStart(0),
+      statsWindowSamples(0), dmaChannels{-1, -1}, blockSequence(0) {}
+
+/**
+ * @brief Mintavételezés indításának kérése
+ */
+void AudioCapture::start(uint32_t sampleRate) {
+    sampleRate = constrain(sampleRate, (uint32_t)AUDIO_CAPTURE_SAMPLE_RATE_MIN, (uint32_t)AUDIO_CAPTURE_SAMPLE_RATE_MAX);
+    requestedSampleRate.store(sampleRate, std::memory_order_release);
+}
+
+/**
+ * @brief Mintavételezés leállításának kérése
+ */
+void AudioCapture::stop() { requestedSampleRate.store(0, std::memory_order_release); }
+
+/**
+ * @brief Core1 blokk feldolgozó beállítása
+ */
+void AudioCapture::setBlockProcessor(AudioBlockProcessor *processor) {
+    requestedProcessor.store(processor, std::memory_order_release);
+
+    // Leállított mintavételezésnél nincs megszakítás, ami használná
+    if (!isRunning()) {
+        activeProcessor.store(processor, std::memory_order_release);
+        return;
+    }
+
+    // A következő blokk megszakítása veszi át; addig a korábbi még futhat
+    uint32_t start = millis();
+    while (activeProcessor.load(std::memory_order_acquire) != processor && isRunning()) {
+        if (millis() - start > PROCESSOR_SWITCH_TIMEOUT_MS) {
+            DEBUG("AudioCapture: block processor switch timeout\n");
+            break;
+        }
+        tight_loop_contents();
+    }
+}
+
+/**
+ * @brief Blokk fogyasztó regisztrálása
+ */
+uint8_t AudioCapture::registerConsumer() {
+    uint8_t consumer = blockPool.registerConsumer();
+
+    // Leállított mintavételezésnél nincs megszakítás, ami átvenné
+    if (!isRunning()) {
+        blockPool.syncConsumers();
+    }
+    return consumer;
+}
+
+/**
+ * @brief Blokk fogyasztó leiratkozása
+ */
+void AudioCapture::unregisterConsumer(uint8_t consumer) {
+    if (consumer == INVALID_CONSUMER) {
+        return;
+    }
+    blockPool.unregisterConsumer(consumer);
+
+    // A következő blokk megszakítása veszi át; addig még kaphat blokkot
+    uint32_t start = millis();
+    while (blockPool.isConsumerAttached(consumer) && isRunning()) {
+        if (millis() - start > PROCESSOR_SWITCH_TIMEOUT_MS) {
+            DEBUG("AudioCapture: block consumer detach timeout\n");
+            break;
+        }
+        tight_loop_contents();
+    }
+    if (!isRunning()) {
+        blockPool.syncConsumers();
+    }
+
+    blockPool.flush(consumer);
+}
+
+/**
+ * @brief Core1 inicializálás
+ */
+void AudioCapture::setupCore1() {
+    irq_set_exclusive_handler(DMA_IRQ_1, audioCaptureDmaIrqHandler);
+    statsWindowStart = millis();
+}
+
+/**
+ * @brief Core1 ciklus: a core0 kéréseinek alkalmazása és a statisztika frissítése
+ */
+void AudioCapture::loopCore1() {
+    uint32_t requested = requestedSampleRate.load(std::memory_order_acquire);
+    if (requested != activeSampleRate.load(std::memory_order_relaxed)) {
+        stopHardware();
+        if (requested != 0) {
+            startHardware(requested);
+        }
+    }
+
+    updateStats();
+}
+
+/**
+ * @brief ADC szabadon futó mód és a két láncolt DMA csatorna indítása
+ */
+void AudioCapture::startHardware(uint32_t sampleRate) {
+    adc_init();
+    adc_gpio_init(PIN_AUDIO_INPUT);
+    adc_select_input(PIN_AUDIO_INPUT - A0);
+    adc_fifo_setup(true,   // Eredmények a FIFO-ba
+                   true,   // DREQ engedélyezése a DMA-nak
+                   1,      // DREQ már egy mintánál
+                   false,  // Hiba bit nélkül
+                   false); // 12 bites minták (nincs 8 bitre vágás)
+    adc_set_clkdiv(static_cast<float>(ADC_CLOCK_HZ) / sampleRate - 1.0f);
+    adc_fifo_drain();
+
+    // Két csatorna felváltva (ping-pong): a befejeződő csatorna elindítja a másikat
+    for (uint8_t i = 0; i < 2; i++) {
+        dmaChannels[i] = dma_claim_unused_channel(true);
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        dma_channel_config cfg = dma_channel_get_default_config(dmaChannels[i]);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+        channel_config_set_read_increment(&cfg, false);
+        channel_config_set_write_increment(&cfg, true);
+        channel_config_set_dreq(&cfg, DREQ_ADC);
+        channel_config_set_chain_to(&cfg, dmaChannels[i ^ 1]);
+        dma_channel_configure(dmaChannels[i], &cfg, dmaBuffers[i], &adc_hw->fifo, AUDIO_CAPTURE_BLOCK_SIZE, false);
+        dma_channel_set_irq1_enabled(dmaChannels[i], true);
+    }
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    blockSequence = 0;
+    agc.reset();
+    activeSampleRate.store(sampleRate, std::memory_order_release);
+
+    dma_channel_start(dmaChannels[0]);
+    adc_run(true);
+
+    DEBUG("AudioCapture: started at %lu Hz (block: %u samples)\n", sampleRate, AUDIO_CAPTURE_BLOCK_SIZE);
+}
+
+/**
+ * @brief ADC és DMA leállítása, a csatornák felszabadítása
+ * @details Ezután a core0 analogRead() hívásai (VBUS, hőmérséklet) ismét használhatják az ADC-t.
+ */
+void AudioCapture::stopHardware() {
+    if (activeSampleRate.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    adc_run(false);
+    irq_set_enabled(DMA_IRQ_1, false);
+    for (uint8_t i = 0; i < 2; i++) {
+        dma_channel_set_irq1_enabled(dmaChannels[i], false);
+        dma_hw->ints1 = 1u << dmaChannels[i];
+    }
+    // Láncolt csatornáknál mindkettőt meg kell szakítani, különben az egyik újraindíthatja a másikat
+    dma_hw->abort = (1u << dmaChannels[0]) | (1u << dmaChannels[1]);
+    while (dma_hw->abort & ((1u << dmaChannels[0]) | (1u << dmaChannels[1]))) {
+        tight_loop_contents();
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        dma_channel_unclaim(dmaChannels[i]);
+        dmaChannels[i] = -1;
+    }
+
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+
+    activeSampleRate.store(0, std::memory_order_release);
+    DEBUG("AudioCapture: stopped (overruns: %lu)\n", blockPool.getExhaustedCount());
+}
+
+/**
+ * @brief DMA megszakítás: a kész puffer átadása, a csatorna újraélesítése
+ * @details A befejezett csatorna már elindította a másikat (chain), így csak a cím visszaállítása kell
+ * a következő körhöz; ez egy teljes blokknyi időn belül biztosan megtörténik.
+ */
+void AudioCapture::handleDmaIrq() {
+    for (uint8_t i = 0; i < 2; i++) {
+        uint32_t mask = 1u << dmaChannels[i];
+        if (dma_hw->ints1 & mask) {
+            dma_hw->ints1 = mask;
+            dma_channel_set_write_addr(dmaChannels[i], dmaBuffers[i], false);
+            deliverBuffer(i);
+        }
+    }
+}
+
+/**
+ * @brief A kész DMA puffer konvertálása egy pool blokkba és átadása a fogyasztóknak
+ */
+void AudioCapture::deliverBuffer(uint8_t bufferIndex) {
+    uint32_t sequence = blockSequence++;
+    uint32_t sampleRate = activeSampleRate.load(std::memory_order_relaxed);
+
+    // Blokkhatáron vesszük át a core0 által kért feldolgozót és fogyasztókat (a setBlockProcessor() és az unregisterConsumer() erre vár)
+    AudioBlockProcessor *processor = requestedProcessor.load(std::memory_order_acquire);
+    activeProcessor.store(processor, std::memory_order_release);
+    blockPool.syncConsumers();
+
+    // Nincs szabad blokk: a fogyasztók nem győzik, a blokk elveszik (a pool számolja)
+    AudioBlock *block = blockPool.acquire();
+    if (block == nullptr && processor == nullptr) {
+        return;
+    }
+
+    int16_t *samples = block ? block->samples : processorScratch;
+    const uint16_t *src = dmaBuffers[bufferIndex];
+    for (uint16_t i = 0; i < AUDIO_CAPTURE_BLOCK_SIZE; i++) {
+        samples[i] = static_cast<int16_t>((static_cast<int16_t>(src[i] & 0x0FFF) - ADC_MIDPOINT) << 4);
+    }
+
+    // Az AGC blokkonként egyszer fut, minden fogyasztó ezt az erősítést kapja
+    agc.processBlock(samples, AUDIO_CAPTURE_BLOCK_SIZE);
+    uint16_t agcGainQ8 = agc.getGainQ8();
+
+    if (block) {
+        block->sequence = sequence;
+        block->sampleRate = sampleRate;
+        block->agcGainQ8 = agcGainQ8;
+        blockPool.publish(block);
+    }
+
+    // A core0 közben már olvashatja a blokkot; a feldolgozó is csak olvassa (újra csak a következő megszakítás foglalhatja)
+    if (processor) {
+        processor->processBlock(samples, AUDIO_CAPTURE_BLOCK_SIZE, sampleRate, agcGainQ8);
+    }
+
+    capturedSamples = capturedSamples + AUDIO_CAPTURE_BLOCK_SIZE;
+}
+
+/**
+ * @brief Ténylegesen leadott minták/s számítása egy másodperces ablakban
+ */
+void AudioCapture::updateStats() {
+    uint32_t now = millis();
+    uint32_t elapsed = now - statsWindowStart;
+    if (elapsed < STATS_WINDOW_MS) {
+        return;
+    }
+
+    uint32_t samples = capturedSamples;
+    uint32_t rate = static_cast<uint32_t>((static_cast<uint64_t>(samples - statsWindowSamples) * 1000) / elapsed);
+    sustainedSampleRate.store(rate, std::memory_order_relaxed);
+    statsWindowSamples = samples;
+    statsWindowStart = now;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file AudioDspStages.cpp
+ * @brief Fixpontos audio előfeldolgozó lépcsők implementáció
+ */
+
+#include "AudioDspStages.h"
+
+#include <algorithm>
+#include <new>
+
+// ===================================================================
+// AudioWindow
+// ===================================================================
+
+/**
+ * @brief Konstruktor
+ */
+AudioWindow::AudioWindow(uint16_t maxSize) : table(nullptr), maxSize(maxSize), size(0), type(Type::Hann), coherentGainQ15(0) {
+    table = new (std::nothrow) int16_t[maxSize];
+    if (!table) {
+        DEBUG("AudioWindow: memória foglalás sikertelen (%u)\n", maxSize);
+    }
+}
+
+/**
+ * @brief Destruktor
+ */
+AudioWindow::~AudioWindow() { delete[] table; }
+
+/**
+ * @brief Típus és méret beállítása, a tábla (periodikus ablak) számítása változáskor
+ */
+bool AudioWindow::configure(Type newType, uint16_t newSize) {
+    if (!table || newSize > maxSize || newSize == 0) {
+        return false;
+    }
+    if (newType == type && newSize == size) {
+        return true;
+    }
+
+    int32_t sum = 0;
+    for (uint16_t i = 0; i < newSize; i++) {
+        float phase = TWO_PI * i / newSize;
+        float value;
+        if (newType == Type::BlackmanHarris) {
+            value = 0.35875f - 0.48829f * cosf(phase) + 0.14128f * cosf(2.0f * phase) - 0.01168f * cosf(3.0f * phase);
+        } else {
+            value = 0.5f - 0.5f * cosf(phase);
+        }
+        table[i] = static_cast<int16_t>(32767.0f * value);
+        sum += table[i];
+    }
+
+    type = newType;
+    size = newSize;
+    coherentGainQ15 = static_cast<uint16_t>(sum / newSize);
+    return true;
+}
+
+/**
+ * @brief Ablakozás
+ */
+void AudioWindow::apply(const int16_t *input, int16_t *output) const {
+    for (uint16_t i = 0; i < size; i++) {
+        output[i] = static_cast<int16_t>((static_cast<int32_t>(input[i]) * table[i]) >> 15);
+    }
+}
+
+/**
+ * @brief Rövid név kijelzéshez
+ */
+const char *AudioWindow::getTypeName(Type type) {
+    switch (type) {
+        case Type::Hann:
+            return "Hann";
+        case Type::BlackmanHarris:
+            return "BH4";
+        default:
+            return "?";
+    }
+}
+
+// ===================================================================
+// AudioOverlapBuffer
+// ===================================================================
+
+/**
+ * @brief Konstruktor
+ */
+AudioOverlapBuffer::AudioOverlapBuffer(uint16_t maxFrameSize)
+    : buffer(nullptr), maxFrameSize(maxFrameSize), frameSize(maxFrameSize), writePos(0), filled(0), newSamples(0) {
+    buffer = new (std::nothrow) int16_t[maxFrameSize * 2];
+    if (!buffer) {
+        DEBUG("AudioOverlapBuffer: memória foglalás sikertelen (%u)\n", maxFrameSize);
+    }
+}
+
+/**
+ * @brief Destruktor
+ */
+AudioOverlapBuffer::~AudioOverlapBuffer() { delete[] buffer; }
+
+/**
+ * @brief Keret méret beállítása
+ */
+bool AudioOverlapBuffer::configure(uint16_t newFrameSize) {
+    if (newFrameSize > maxFrameSize || newFrameSize < 2) {
+        return false;
+    }
+    frameSize = newFrameSize;
+    reset();
+    return true;
+}
+
+/**
+ * @brief A puffer ürítése
+ */
+void AudioOverlapBuffer::reset() {
+    writePos = 0;
+    filled = 0;
+    newSamples = 0;
+}
+
+/**
+ * @brief Minták hozzáfűzése a tükrözött gyűrűpufferbe
+ */
+void AudioOverlapBuffer::write(const int16_t *samples, uint16_t count) {
+    if (!buffer) {
+        return;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        buffer[writePos] = samples[i];
+        buffer[writePos + maxFrameSize] = samples[i];
+        writePos = writePos + 1 == maxFrameSize ? 0 : writePos + 1;
+    }
+    filled = std::min<uint32_t>(static_cast<uint32_t>(filled) + count, maxFrameSize);
+    newSamples = std::min<uint32_t>(static_cast<uint32_t>(newSamples) + count, maxFrameSize);
+}
+
+// ===================================================================
+// AudioDecimator
+// ===================================================================
+
+/**
+ * @brief Konstruktor (1-es arány: átengedés)
+ */
+AudioDecimator::AudioDecimator() : factor(1), phase(0), delayPos(0), accumulator(0), coefficients{}, delayLines{} {}
+
+/**
+ * @brief Decimálási arány beállítása, az aluláteresztő együtthatók számítása
+ * @details Blackman ablakos sinc, a vágás (-6 dB) a kimeneti Nyquist frekvencia 82%-a: az átmeneti sáv a Nyquist
+ * frekvenciánál véget ér (ott már > 67 dB elnyomás), így a Nyquist feletti jel nem hajlik vissza a kijelzett sávba.
+ * Az áteresztő sáv a Nyquist 70%-áig -0.2 dB-en belül, 80%-nál -4 dB. Az együtthatók összege Q15-ben 32767,
+ * az abszolút összegük ~1.8, így a 32 bites akkumulátor egy teljes kivezérlésű jelnél sem csordul túl.
+ */
+bool AudioDecimator::configure(uint8_t newFactor) {
+    if (newFactor != 1 && newFactor != 2 && newFactor != 4 && newFactor != 8) {
+        return false;
+    }
+
+    if (newFactor != factor && newFactor > 1) {
+        const uint16_t length = static_cast<uint16_t>(newFactor) * TAPS_PER_PHASE;
+        const float cutoff = 0.82f * 0.5f / newFactor; // A bemeneti mintavételi frekvenciához képest
+        const float center = (length - 1) / 2.0f;
+
+        float taps[MAX_FACTOR * TAPS_PER_PHASE];
+        float sum = 0.0f;
+        for (uint16_t k = 0; k < length; k++) {
+            float t = k - center;
+            float sinc = t == 0.0f ? 2.0f * cutoff : sinf(TWO_PI * cutoff * t) / (PI * t);
+            float window = 0.42f - 0.5f * cosf(TWO_PI * k / (length - 1)) + 0.08f * cosf(2.0f * TWO_PI * k / (length - 1));
+            taps[k] = sinc * window;
+            sum += taps[k];
+        }
+        for (uint16_t k = 0; k < length; k++) {
+            coefficients[k % newFactor][k / newFactor] = static_cast<int16_t>(lroundf(taps[k] / sum * 32767.0f));
+        }
+    }
+
+    factor = newFactor;
+    reset();
+    return true;
+}
+
+/**
+ * @brief A késleltető vonalak törlése
+ */
+void AudioDecimator::reset() {
+    memset(delayLines, 0, sizeof(delayLines));
+    phase = factor - 1;
+    delayPos = 0;
+    accumulator = 0;
+}
+
+/**
+ * @brief Egy blokk decimálása
+ * @details A kimenet m. mintája: y[m] = sum(p, j) h[j * factor + p] * x[(m - j) * factor - p]. A minták
+ * érkezési sorrendjében a p. fázis ág a factor-1. fázistól a 0.-ig kapja az x[m * factor - p] mintát, és a
+ * saját késleltető vonalával vett skaláris szorzata a kimenet részösszegéhez adódik.
+ */
+uint16_t AudioDecimator::process(const int16_t *input, uint16_t count, int16_t *output) {
+    if (factor == 1) {
+        memcpy(output, input, count * sizeof(int16_t));
+        return count;
+    }
+
+    uint16_t produced = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        // Új kimeneti ciklus: minden ág késleltető vonala egy hellyel öregszik
+        if (phase == factor - 1) {
+            delayPos = delayPos == 0 ? TAPS_PER_PHASE - 1 : delayPos - 1;
+        }
+
+        int16_t *line = delayLines[phase];
+        line[delayPos] = input[i];
+        line[delayPos + TAPS_PER_PHASE] = input[i];
+
+        const int16_t *history = line + delayPos; // history[j] = a j. legutóbbi minta ezen az ágon
+        const int16_t *taps = coefficients[phase];
+        int32_t partial = 0;
+        for (uint8_t j = 0; j < TAPS_PER_PHASE; j++) {
+            partial += static_cast<int32_t>(history[j]) * taps[j];
+        }
+        accumulator += partial;
+
+        if (phase == 0) {
+            output[produced++] = static_cast<int16_t>(constrain((accumulator + (1 << 14)) >> 15, -32768, 32767));
+            accumulator = 0;
+            phase = factor - 1;
+        } else {
+            phase--;
+        }
+    }
+    return produced;
+}
@@ -0,0 +1,375 @@
+/**
+ * @file AudioFft.cpp
+ * @brief Audio FFT magnitúdó spektrum implementáció
+ */
+
+#include "AudioFft.h"
+
+#include <new>
+
+#if AUDIO_FFT_IMPLEMENTATION == AUDIO_FFT_IMPLEMENTATION_ARDUINO
+#include <arduinoFFT.h>
+#endif
+
+/**
+ * @brief Támogatott-e a méret
+ */
+bool AudioFft::isSupportedSize(uint16_t size) { return size >= AUDIO_FFT_SIZE_MIN && size <= AUDIO_FFT_SIZE_MAX && (size & (size - 1)) == 0; }
+
+#if AUDIO_FFT_IMPLEMENTATION == AUDIO_FFT_IMPLEMENTATION_FIXED
+
+// ===================================================================
+// Q15 fixpontos radix-4 implementáció
+// ===================================================================
+
+namespace {
+
+constexpr uint16_t SINE_TABLE_PERIOD = AUDIO_FFT_SIZE_MAX;   // A teljes kör felbontása (a legnagyobb valós FFT N-je)
+constexpr uint16_t SINE_QUARTER = SINE_TABLE_PERIOD / 4;     // Negyed periódus
+constexpr uint8_t RADIX4_INPUT_BITS = 12;                    // Radix-4 lépcső bemenete < 2^12 (a kimenet legfeljebb ~5.7x)
+constexpr uint8_t RADIX2_INPUT_BITS = 14;                    // Radix-2 lépcső bemenete < 2^14 (a kimenet legfeljebb 2x)
+static_assert((SINE_TABLE_PERIOD & (SINE_TABLE_PERIOD - 1)) == 0, "AUDIO_FFT_SIZE_MAX must be a power of two");
+
+/**
+ * @brief sin(x) Taylor sorral, fordítási időben (0 <= x <= pi/2)
+ */
+constexpr double constexprSin(double x) {
+    double term = x;
+    double sum = x;
+    for (int i = 1; i < 12; i++) {
+        term *= -x * x / ((2.0 * i) * (2.0 * i + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Negyed periódusú Q15 szinusz tábla (a többi negyed szimmetriából adódik)
+ */
+struct SineTable {
+    int16_t values[SINE_QUARTER + 1];
+};
+
+constexpr SineTable makeSineTable() {
+    SineTable table{};
+    for (uint16_t i = 0; i <= SINE_QUARTER; i++) {
+        double value = constexprSin(3.14159265358979323846 * 2.0 * i / SINE_TABLE_PERIOD) * 32767.0;
+        table.values[i] = static_cast<int16_t>(value + 0.5);
+    }
+    return table;
+}
+
+constexpr SineTable SINE_TABLE = makeSineTable();
+
+/**
+ * @brief sin(2*pi*k/SINE_TABLE_PERIOD) Q15-ben, k tetszőleges (modulo periódus)
+ */
+inline int16_t sinQ15(uint16_t k) {
+    k &= SINE_TABLE_PERIOD - 1;
+    uint16_t r = k & (SINE_QUARTER - 1);
+    switch (k / SINE_QUARTER) {
+        case 0:
+            return SINE_TABLE.values[r];
+        case 1:
+            return SINE_TABLE.values[SINE_QUARTER - r];
+        case 2:
+            return -SINE_TABLE.values[r];
+        default:
+            return -SINE_TABLE.values[SINE_QUARTER - r];
+    }
+}
+
+/**
+ * @brief cos(2*pi*k/SINE_TABLE_PERIOD) Q15-ben
+ */
+inline int16_t cosQ15(uint16_t k) { return sinQ15(k + SINE_QUARTER); }
+
+/**
+ * @brief Ennyi bittel kell jobbra léptetni, hogy a maximum (felső korlátja) beférjen a megadott bitszámba
+ */
+inline uint8_t headroomShift(uint32_t absBound, uint8_t allowedBits) {
+    if (absBound == 0) {
+        return 0;
+    }
+    uint8_t bits = 32 - __builtin_clz(absBound);
+    return bits > allowedBits ? bits - allowedBits : 0;
+}
+
+/**
+ * @brief Egész négyzetgyök
+ */
+inline uint32_t isqrt32(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+inline uint32_t absValue(int32_t value) { return value < 0 ? -value : value; }
+
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+AudioFft::AudioFft(uint16_t maxSize) : maxSize(maxSize), work(nullptr) {
+    if (!isSupportedSize(maxSize)) {
+        DEBUG("AudioFft: nem támogatott méret: %u\n", maxSize);
+        return;
+    }
+    work = new (std::nothrow) int16_t[maxSize];
+    if (!work) {
+        DEBUG("AudioFft: memória foglalás sikertelen (%u)\n", maxSize);
+    }
+}
+
+/**
+ * @brief Destruktor
+ */
+AudioFft::~AudioFft() { delete[] work; }
+
+bool AudioFft::isAvailable() const { return work != nullptr; }
+
+const char *AudioFft::getImplementationName() { return "Q15 radix-4"; }
+
+/**
+ * @brief Helyben végzett komplex FFT (DIF, radix-4 lépcsők + szükség esetén egy radix-2)
+ * @details Blokk lebegőpontos skálázás: minden lépcső előtt annyi bittel léptetünk jobbra, amennyi a túlcsorduláshoz
+ * hiányzik; a léptetések összege a visszaadott kitevő. A radix-4 lépcső kimeneteit a j+q és j+2q helyen felcserélve
+ * tároljuk (radix-2^2 sorrend), így a végeredmény sima bit-fordított sorrendű, és a radix-2 záró lépcső is illeszkedik.
+ * @return A skálázási kitevő (eredmény = valódi FFT / 2^kitevő)
+ */
+int8_t AudioFft::complexFft(uint16_t points, uint8_t log2Points) {
+    int16_t *x = work;
+    int8_t exponent = 0;
+
+    // A bemenet felső korlátja
+    uint32_t absBound = 0;
+    for (uint16_t i = 0; i < points * 2; i++) {
+        absBound |= absValue(x[i]);
+    }
+
+    uint16_t span = points;
+    for (uint8_t stage = 0; stage < log2Points / 2; stage++) {
+        uint8_t shift = headroomShift(absBound, RADIX4_INPUT_BITS);
+        exponent += shift;
+        absBound = 0;
+
+        uint16_t quarter = span / 4;
+        uint16_t tableStep = SINE_TABLE_PERIOD / span; // W_span^j táblaindexe: j * tableStep
+
+        for (uint16_t j = 0; j < quarter; j++) {
+            uint16_t k1 = j * tableStep;
+            int32_t w1r = cosQ15(k1), w1i = sinQ15(k1);
+            int32_t w2r = cosQ15(2 * k1), w2i = sinQ15(2 * k1);
+            int32_t w3r = cosQ15(3 * k1), w3i = sinQ15(3 * k1);
+
+            for (uint16_t g = j; g < points; g += span) {
+                int16_t *pa = x + 2 * g;
+                int16_t *pb = pa + 2 * quarter;
+                int16_t *pc = pb + 2 * quarter;
+                int16_t *pd = pc + 2 * quarter;
+
+                int32_t ar = pa[0] >> shift, ai = pa[1] >> shift;
+                int32_t br = pb[0] >> shift, bi = pb[1] >> shift;
+                int32_t cr = pc[0] >> shift, ci = pc[1] >> shift;
+                int32_t dr = pd[0] >> shift, di = pd[1] >> shift;
+
+                int32_t t0r = ar + cr, t0i = ai + ci;
+                int32_t t1r = ar - cr, t1i = ai - ci;
+                int32_t t2r = br + dr, t2i = bi + di;
+                int32_t t3r = br - dr, t3i = bi - di;
+
+                // y0 = t0 + t2, y2 = t0 - t2, y1 = t1 - j*t3, y3 = t1 + j*t3
+                int32_t y0r = t0r + t2r, y0i = t0i + t2i;
+                int32_t y2r = t0r - t2r, y2i = t0i - t2i;
+                int32_t y1r = t1r + t3i, y1i = t1i - t3r;
+                int32_t y3r = t1r - t3i, y3i = t1i + t3r;
+
+                // Forgató tényezők: y * (cos - j*sin)
+                int32_t z1r = (y1r * w1r + y1i * w1i) >> 15, z1i = (y1i * w1r - y1r * w1i) >> 15;
+                int32_t z2r = (y2r * w2r + y2i * w2i) >> 15, z2i = (y2i * w2r - y2r * w2i) >> 15;
+                int32_t z3r = (y3r * w3r + y3i * w3i) >> 15, z3i = (y3i * w3r - y3r * w3i) >> 15;
+
+                pa[0] = y0r;
+                pa[1] = y0i;
+                pb[0] = z2r; // radix-2^2 sorrend: a b helyre az y2
+                pb[1] = z2i;
+                pc[0] = z1r;
+                pc[1] = z1i;
+                pd[0] = z3r;
+                pd[1] = z3i;
+
+                absBound |= absValue(y0r) | absValue(y0i) | absValue(z1r) | absValue(z1i) | absValue(z2r) | absValue(z2i) | absValue(z3r) | absValue(z3i);
+            }
+        }
+        span /= 4;
+    }
+
+    // Páratlan log2 esetén egy záró radix-2 lépcső (2 pontos pillangók, forgató tényező nélkül)
+    if (log2Points & 1) {
+        uint8_t shift = headroomShift(absBound, RADIX2_INPUT_BITS);
+        exponent += shift;
+        for (uint16_t g = 0; g < points; g += 2) {
+            int16_t *pa = x + 2 * g;
+            int32_t ar = pa[0] >> shift, ai = pa[1] >> shift;
+            int32_t br = pa[2] >> shift, bi = pa[3] >> shift;
+            pa[0] = ar + br;
+            pa[1] = ai + bi;
+            pa[2] = ar - br;
+            pa[3] = ai - bi;
+        }
+    }
+
+    bitReverse(points);
+    return exponent;
+}
+
+/**
+ * @brief Bit-fordított sorrend visszarendezése természetes sorrendbe
+ */
+void AudioFft::bitReverse(uint16_t points) {
+    uint32_t *x = reinterpret_cast<uint32_t *>(work); // Egy komplex pont = 2 x int16
+    uint16_t r = 0;
+    for (uint16_t i = 0; i < points; i++) {
+        if (r > i) {
+            uint32_t tmp = x[i];
+            x[i] = x[r];
+            x[r] = tmp;
+        }
+        // r bit-fordított növelése
+        uint16_t bit = points >> 1;
+        while (bit && (r & bit)) {
+            r ^= bit;
+            bit >>= 1;
+        }
+        r |= bit;
+    }
+}
+
+/**
+ * @brief Magnitúdó spektrum: valós bemenet N/2 pontos komplex FFT-be csomagolva
+ * @details z[n] = x[2n] + j*x[2n+1]; Z = FFT(z). A valós spektrum:
+ * X[k] = (Z[k] + Z*[M-k]) / 2 + W_N^k * (Z[k] - Z*[M-k]) / 2j, M = N/2.
+ */
+bool AudioFft::computeMagnitudes(const int16_t *samples, uint16_t size, uint16_t *magnitudes) {
+    if (!work || !isSupportedSize(size) || size > maxSize) {
+        return false;
+    }
+
+    uint16_t points = size / 2;
+    uint8_t log2Size = 31 - __builtin_clz(size);
+    uint8_t log2Points = log2Size - 1;
+
+    memcpy(work, samples, size * sizeof(int16_t)); // A páros/páratlan minták épp a re/im helyekre esnek
+    int8_t exponent = complexFft(points, log2Points);
+
+    // Normalizálás: |X| * 2/N, a blokk skálázás visszaszorzásával
+    int8_t outShift = exponent + 1 - log2Size;
+    uint16_t tableStep = SINE_TABLE_PERIOD / size;
+
+    for (uint16_t k = 0; k < points; k++) {
+        int32_t xr, xi;
+        if (k == 0) {
+            xr = static_cast<int32_t>(work[0]) + work[1];
+            xi = 0;
+        } else {
+            int32_t z1r = work[2 * k], z1i = work[2 * k + 1];
+            int32_t z2r = work[2 * (points - k)], z2i = -work[2 * (points - k) + 1]; // konjugált
+
+            int32_t fer = (z1r + z2r) >> 1, fei = (z1i + z2i) >> 1;
+            int32_t for_ = (z1i - z2i) >> 1, foi = -((z1r - z2r) >> 1); // (Z1 - Z2) / 2j
+
+            int32_t wr = cosQ15(k * tableStep), wi = sinQ15(k * tableStep);
+            xr = fer + ((for_ * wr) >> 15) + ((foi * wi) >> 15);
+            xi = fei + ((foi * wr) >> 15) - ((for_ * wi) >> 15);
+        }
+
+        // |X| 32 biten: a négyzetösszeg előtt 2 bittel lejjebb skálázunk (|xr|, |xi| < 2^17)
+        uint32_t mr = absValue(xr) >> 2, mi = absValue(xi) >> 2;
+        uint32_t magnitude = isqrt32(mr * mr + mi * mi) << 2;
+
+        if (outShift >= 0) {
+            magnitude = magnitude > (0xFFFFUL >> outShift) ? 0xFFFF : magnitude << outShift;
+        } else {
+            magnitude >>= -outShift;
+        }
+        magnitudes[k] = magnitude > 0xFFFF ? 0xFFFF : magnitude;
+    }
+    return true;
+}
+
+#elif AUDIO_FFT_IMPLEMENTATION == AUDIO_FFT_IMPLEMENTATION_ARDUINO
+
+// ===================================================================
+// arduinoFFT (float) implementáció
+// ===================================================================
+
+/**
+ * @brief Konstruktor
+ */
+AudioFft::AudioFft(uint16_t maxSize) : maxSize(maxSize), vReal(nullptr), vImag(nullptr) {
+    if (!isSupportedSize(maxSize)) {
+        DEBUG("AudioFft: nem támogatott méret: %u\n", maxSize);
+        return;
+    }
+    vReal = new (std::nothrow) float[maxSize];
+    vImag = new (std::nothrow) float[maxSize];
+    if (!vReal || !vImag) {
+        DEBUG("AudioFft: memória foglalás sikertelen (%u)\n", maxSize);
+        delete[] vReal;
+        delete[] vImag;
+        vReal = nullptr;
+        vImag = nullptr;
+    }
+}
+
+/**
+ * @brief Destruktor
+ */
+AudioFft::~AudioFft() {
+    delete[] vReal;
+    delete[] vImag;
+}
+
+bool AudioFft::isAvailable() const { return vReal != nullptr; }
+
+const char *AudioFft::getImplementationName() { return "arduinoFFT"; }
+
+/**
+ * @brief Magnitúdó spektrum arduinoFFT-vel
+ */
+bool AudioFft::computeMagnitudes(const int16_t *samples, uint16_t size, uint16_t *magnitudes) {
+    if (!vReal || !isSupportedSize(size) || size > maxSize) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < size; i++) {
+        vReal[i] = samples[i];
+        vImag[i] = 0.0f;
+    }
+
+    ArduinoFFT<float> fft(vReal, vImag, size, 1.0f); // A mintavételi frekvencia itt nem számít
+    fft.compute(FFTDirection::Forward);
+    fft.complexToMagnitude();
+
+    float scale = 2.0f / size;
+    for (uint16_t k = 0; k < size / 2; k++) {
+        float magnitude = vReal[k] * scale;
+        magnitudes[k] = magnitude >= 65535.0f ? 0xFFFF : static_cast<uint16_t>(magnitude);
+    }
+    return true;
+}
+
+#endif
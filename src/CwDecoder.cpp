@@ -0,0 +1,291 @@
+/**
+ * @file CwDecoder.cpp
+ * @brief CW (Morse) dekóder implementáció
+ */
+
+#include "CwDecoder.h"
+
+namespace {
+
+constexpr float SIGNAL_ATTACK = 0.5f;                           // Jelszint követés felfelé (gyors)
+constexpr float SIGNAL_TRACK = 0.05f;                           // Jelszint követés lenyomott billentyűnél
+constexpr float SIGNAL_DECAY = 0.002f;                          // Jelszint lecsengés szünetben (~2 s)
+constexpr float NOISE_TRACK = 0.05f;                            // Zajszint követés (szünetben)
+constexpr float KEY_DOWN_THRESHOLD = 0.5f;                      // Lenyomás küszöb a zaj és jel szint között
+constexpr float KEY_UP_THRESHOLD = 0.3f;                        // Felengedés küszöb (hiszterézis)
+constexpr float MIN_MARK_MS = 1200.0f / CW_DECODER_MAX_WPM / 3; // Ennél rövidebb jel zavar, eldobjuk
+constexpr float DAH_THRESHOLD = 2.0f;                           // Jel: pont/vonás határ (pont hosszban)
+constexpr float CHAR_GAP_THRESHOLD = 2.0f;                      // Szünet: elemköz/karakterköz határ
+constexpr float WORD_GAP_THRESHOLD = 5.0f;                      // Szünet: karakterköz/szóköz határ
+
+/**
+ * @brief Morse jelsorozatok (a fa index ebből fordítási időben készül)
+ */
+struct MorseCode {
+    char c;
+    const char *code;
+};
+
+constexpr MorseCode MORSE_CODES[] = {
+    {'A', ".-"},     {'B', "-..."},   {'C', "-.-."},   {'D', "-.."},     {'E', "."},      {'F', "..-."},    {'G', "--."},    {'H', "...."},   {'I', ".."},
+    {'J', ".---"},   {'K', "-.-"},    {'L', ".-.."},   {'M', "--"},      {'N', "-."},     {'O', "---"},     {'P', ".--."},   {'Q', "--.-"},   {'R', ".-."},
+    {'S', "..."},    {'T', "-"},      {'U', "..-"},    {'V', "...-"},    {'W', ".--"},    {'X', "-..-"},    {'Y', "-.--"},   {'Z', "--.."},   {'0', "-----"},
+    {'1', ".----"},  {'2', "..---"},  {'3', "...--"},  {'4', "....-"},   {'5', "....."},  {'6', "-...."},   {'7', "--..."},  {'8', "---.."},  {'9', "----."},
+    {'.', ".-.-.-"}, {',', "--..--"}, {'?', "..--.."}, {'\'', ".----."}, {'!', "-.-.--"}, {'/', "-..-."},   {'(', "-.--."},  {')', "-.--.-"}, {'&', ".-..."},
+    {':', "---..."}, {';', "-.-.-."}, {'=', "-...-"},  {'+', ".-.-."},   {'-', "-....-"}, {'_', "..--.-"},  {'"', ".-..-."}, {'$', "...-..-"}, {'@', ".--.-."},
+};
+
+/**
+ * @brief Fa index -> karakter tábla (legfeljebb 7 elem, így az index < 256)
+ */
+struct MorseTable {
+    char chars[256];
+};
+
+constexpr MorseTable makeMorseTable() {
+    MorseTable table{};
+    for (const MorseCode &entry : MORSE_CODES) {
+        uint16_t index = 1;
+        for (const char *p = entry.code; *p != '\0'; p++) {
+            index = index * 2 + (*p == '-' ? 1 : 0);
+        }
+        table.chars[index] = entry.c;
+    }
+    return table;
+}
+
+constexpr MorseTable MORSE_TABLE = makeMorseTable();
+
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+CwDecoder::CwDecoder()
+    : requestedFrequency(CW_DECODER_DEFAULT_FREQUENCY), manualGainQ8(0), resetRequested(false), wpm(CW_DECODER_DEFAULT_WPM), keyDown(false), toneFrequency(0), sampleRate(0),
+      frameSamples(0), frameFill(0), coeffQ14(0), s1(0), s2(0), frameMs(0.0f), gain(1.0f) {
+    resetDecoder();
+}
+
+/**
+ * @brief A figyelt hang frekvencia beállítása
+ */
+void CwDecoder::setToneFrequency(uint16_t frequencyHz) {
+    requestedFrequency.store(constrain(frequencyHz, CW_DECODER_MIN_FREQUENCY, CW_DECODER_MAX_FREQUENCY), std::memory_order_release);
+}
+
+/**
+ * @brief A következő dekódolt karakter kivétele (core0)
+ */
+bool CwDecoder::popChar(char &c) {
+    const char *next = textQueue.peek();
+    if (next == nullptr) {
+        return false;
+    }
+    c = *next;
+    textQueue.release();
+    return true;
+}
+
+/**
+ * @brief Goertzel együttható és ablakméret számítása
+ */
+void CwDecoder::configureDetector(uint16_t frequencyHz, uint32_t rate) {
+    toneFrequency = frequencyHz;
+    sampleRate = rate;
+
+    uint32_t samples = (static_cast<uint32_t>(DETECTOR_FRAME_US) * rate) / 1000000UL;
+    frameSamples = constrain(samples, 16UL, static_cast<uint32_t>(MAX_FRAME_SAMPLES));
+    frameMs = frameSamples * 1000.0f / rate;
+    coeffQ14 = static_cast<int32_t>(2.0f * cosf(TWO_PI * frequencyHz / rate) * 16384.0f);
+
+    frameFill = 0;
+    s1 = s2 = 0;
+
+    // A pont hossz ablakokban mért becslése az új ablakmérethez igazodik
+    setDitFrames(1200.0f / wpm.load(std::memory_order_relaxed) / frameMs);
+}
+
+/**
+ * @brief A dekódolási állapot törlése (a detektor beállításai maradnak)
+ */
+void CwDecoder::resetDecoder() {
+    signalLevel = 0.0f;
+    noiseLevel = -1.0f;
+    rawKey = false;
+    key = false;
+    debounceCount = 0;
+    stateFrames = 0;
+    symbol = 1;
+    symbolOverflow = false;
+    wordSpacePending = false;
+    keyDown.store(false, std::memory_order_relaxed);
+    wpm.store(CW_DECODER_DEFAULT_WPM, std::memory_order_relaxed);
+    ditFrames = frameMs > 0.0f ? 1200.0f / CW_DECODER_DEFAULT_WPM / frameMs : 0.0f;
+}
+
+/**
+ * @brief Egy audio blokk feldolgozása (core1)
+ * @details A Goertzel szűrő fixpontos: 12 bites minták, Q14 együttható, 64 bites szorzat. A szint számítás
+ * ablakonként egyszer, lebegőpontosan történik.
+ */
+void CwDecoder::processBlock(const int16_t *samples, uint16_t count, uint32_t blockSampleRate, uint16_t agcGainQ8) {
+    uint16_t frequency = requestedFrequency.load(std::memory_order_acquire);
+    if (frequency != toneFrequency || blockSampleRate != sampleRate) {
+        configureDetector(frequency, blockSampleRate);
+    }
+    if (resetRequested.load(std::memory_order_acquire)) {
+        resetRequested.store(false, std::memory_order_relaxed);
+        resetDecoder();
+        frameFill = 0;
+        s1 = s2 = 0;
+    }
+    gain = static_cast<float>(AudioAgc::getEffectiveGainQ8(manualGainQ8.load(std::memory_order_relaxed), agcGainQ8)) / AudioAgc::UNITY_GAIN_Q8;
+
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t s0 = (samples[i] >> 4) + static_cast<int32_t>((static_cast<int64_t>(coeffQ14) * s1) >> 14) - s2;
+        s2 = s1;
+        s1 = s0;
+
+        if (++frameFill < frameSamples) {
+            continue;
+        }
+
+        // Ablak vége: amplitúdó a Goertzel teljesítményből
+        float f1 = s1, f2 = s2;
+        float power = f1 * f1 + f2 * f2 - f1 * f2 * (coeffQ14 / 16384.0f);
+        float level = power > 0.0f ? sqrtf(power) * 2.0f / frameSamples : 0.0f;
+        processFrame(level);
+
+        frameFill = 0;
+        s1 = s2 = 0;
+    }
+}
+
+/**
+ * @brief Egy detektor ablak szintjének kiértékelése: küszöbök, billentyű állapot, időzítés
+ */
+void CwDecoder::processFrame(float level) {
+
+    // Az első ablak adja a kiinduló szinteket, így induláskor a zaj nem tűnik jelnek
+    if (noiseLevel < 0.0f) {
+        noiseLevel = signalLevel = level;
+    }
+
+    // Jelszint: gyors felfutás (a zaj csúcsai nem számítanak), lenyomott billentyűnél követés, szünetben lassú lecsengés
+    if (level > signalLevel && level >= noiseLevel * MIN_SNR) {
+        signalLevel += (level - signalLevel) * SIGNAL_ATTACK;
+    } else {
+        signalLevel += (level - signalLevel) * (key ? SIGNAL_TRACK : SIGNAL_DECAY);
+    }
+
+    // Zajszint: a szünetek átlaga; lenyomott billentyűnél csak lefelé követ
+    if (!key || level < noiseLevel) {
+        noiseLevel += (level - noiseLevel) * NOISE_TRACK;
+    }
+
+    // Nyers billentyű állapot hiszterézissel; túl gyenge jelnél nincs lenyomás
+    float span = signalLevel - noiseLevel;
+    bool usable = signalLevel * gain >= MIN_SIGNAL_LEVEL && signalLevel >= noiseLevel * MIN_SNR;
+    if (rawKey) {
+        rawKey = usable && level > noiseLevel + span * KEY_UP_THRESHOLD;
+    } else {
+        rawKey = usable && level > noiseLevel + span * KEY_DOWN_THRESHOLD;
+    }
+
+    // Pergésmentesítés: mindkét él ugyanannyit késik, így a hosszak nem torzulnak
+    if (stateFrames < UINT16_MAX) {
+        stateFrames++;
+    }
+    if (rawKey != key) {
+        if (++debounceCount < DEBOUNCE_FRAMES) {
+            if (!key) {
+                onSpaceFrame();
+            }
+            return;
+        }
+        uint16_t frames = stateFrames - (DEBOUNCE_FRAMES - 1);
+        key = rawKey;
+        debounceCount = 0;
+        stateFrames = DEBOUNCE_FRAMES - 1;
+        keyDown.store(key, std::memory_order_relaxed);
+        if (!key) {
+            onKeyUp(frames);
+        }
+        return;
+    }
+    debounceCount = 0;
+
+    if (!key) {
+        onSpaceFrame();
+    }
+}
+
+/**
+ * @brief Jel vége: pont/vonás döntés és a pont hossz követése
+ * @details A becslés a rövid jelek felé gyorsan, a hosszabbak felé lassan mozdul, így gyorsuló adónál
+ * a vonások nem "húzzák fel" a pont becslést, lassulónál pedig a túl hosszú jelek gyorsan korrigálnak.
+ */
+void CwDecoder::onKeyUp(uint16_t markFrames) {
+    float mark = markFrames;
+    if (mark * frameMs < MIN_MARK_MS) {
+        return; // Zavar impulzus
+    }
+
+    bool dah = mark >= ditFrames * DAH_THRESHOLD;
+    if (dah) {
+        float ditFromDah = mark / 3.0f;
+        setDitFrames(mark > ditFrames * 6.0f ? (ditFrames + ditFromDah) / 2.0f : ditFrames * 0.8f + ditFromDah * 0.2f);
+    } else {
+        setDitFrames(mark < ditFrames ? (ditFrames + mark) / 2.0f : ditFrames * 0.8f + mark * 0.2f);
+    }
+
+    if (symbol >= 0x80) {
+        symbolOverflow = true;
+    } else {
+        symbol = symbol * 2 + (dah ? 1 : 0);
+    }
+}
+
+/**
+ * @brief Szünet ablak: karakter és szó határ felismerése még a következő jel előtt
+ */
+void CwDecoder::onSpaceFrame() {
+    if (symbol != 1 && stateFrames >= ditFrames * CHAR_GAP_THRESHOLD) {
+        char c = symbolOverflow ? UNKNOWN_CHAR : lookupSymbol(symbol);
+        emitChar(c != '\0' ? c : UNKNOWN_CHAR);
+        symbol = 1;
+        symbolOverflow = false;
+        wordSpacePending = true;
+    }
+    if (wordSpacePending && stateFrames >= ditFrames * WORD_GAP_THRESHOLD) {
+        emitChar(' ');
+        wordSpacePending = false;
+    }
+}
+
+/**
+ * @brief A pont hossz becslés beállítása a követett WPM tartományon belül
+ */
+void CwDecoder::setDitFrames(float frames) {
+    float minFrames = 1200.0f / CW_DECODER_MAX_WPM / frameMs;
+    float maxFrames = 1200.0f / CW_DECODER_MIN_WPM / frameMs;
+    ditFrames = constrain(frames, minFrames, maxFrames);
+    wpm.store(static_cast<uint8_t>(1200.0f / (ditFrames * frameMs) + 0.5f), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Karakter átadása a core0-nak (tele sornál elveszik)
+ */
+void CwDecoder::emitChar(char c) {
+    char *slot = textQueue.beginWrite();
+    if (slot) {
+        *slot = c;
+        textQueue.commitWrite();
+    }
+}
+
+/**
+ * @brief Fa index -> karakter ('\0', ha nem ismert)
+ */
+char CwDecoder::lookupSymbol(uint8_t symbol) { return MORSE_TABLE.chars[symbol]; }
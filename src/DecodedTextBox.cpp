@@ -0,0 +1,169 @@
+/**
+ * @file DecodedTextBox.cpp
+ * @brief Dekódolt szöveg doboz implementáció
+ */
+
+#include "DecodedTextBox.h"
+#include <algorithm>
+
+namespace {
+constexpr uint16_t STATUS_COLOR = TFT_CYAN; // Állapotsor színe
+}                                           // namespace
+
+/**
+ * @brief Konstruktor
+ */
+DecodedTextBox::DecodedTextBox(TFT_eSPI &tft, const Rect &bounds, const ColorScheme &colors)
+    : UIComponent(tft, bounds, colors), cursorColumn(0), lastLineDirty(false), allLinesDirty(false), statusDirty(false), fullRedraw(true) {
+
+    int16_t textHeight = static_cast<int16_t>(bounds.height) - STATUS_HEIGHT - 2 * PADDING;
+    int16_t textWidth = static_cast<int16_t>(bounds.width) - 2 * PADDING;
+    visibleLines = constrain(textHeight / LINE_HEIGHT, 1, MAX_LINES);
+    columns = constrain(textWidth / CHAR_WIDTH, 1, MAX_COLUMNS);
+
+    memset(lines, 0, sizeof(lines));
+    status[0] = '\0';
+}
+
+/**
+ * @brief Egy dekódolt karakter hozzáfűzése
+ */
+void DecodedTextBox::appendChar(char c) {
+    if (c == '\n' || c == '\r') {
+        newLine();
+        return;
+    }
+    if (c < ' ' || c > '~') {
+        return;
+    }
+    // Sor elején a szóköz felesleges
+    if (c == ' ' && cursorColumn == 0) {
+        return;
+    }
+    if (cursorColumn >= columns) {
+        newLine();
+        if (c == ' ') {
+            return;
+        }
+    }
+
+    char *line = lines[visibleLines - 1];
+    line[cursorColumn++] = c;
+    line[cursorColumn] = '\0';
+    lastLineDirty = true;
+    needsRedraw = true;
+}
+
+/**
+ * @brief A szöveg törlése
+ */
+void DecodedTextBox::clear() {
+    memset(lines, 0, sizeof(lines));
+    cursorColumn = 0;
+    markForRedraw();
+}
+
+/**
+ * @brief Az állapotsor szövegének beállítása
+ */
+void DecodedTextBox::setStatus(const char *newStatus) {
+    if (strncmp(status, newStatus, STATUS_LENGTH - 1) == 0) {
+        return;
+    }
+    strncpy(status, newStatus, STATUS_LENGTH - 1);
+    status[STATUS_LENGTH - 1] = '\0';
+    statusDirty = true;
+    needsRedraw = true;
+}
+
+/**
+ * @brief Érintés: a beállított kezelő hívása
+ */
+void DecodedTextBox::onClick(const TouchEvent &event) {
+    if (clickCallback) {
+        clickCallback();
+    }
+}
+
+/**
+ * @brief Görgetés egy sorral feljebb, az utolsó sor üres lesz
+ */
+void DecodedTextBox::newLine() {
+    for (uint8_t i = 1; i < visibleLines; i++) {
+        memcpy(lines[i - 1], lines[i], sizeof(lines[i]));
+    }
+    lines[visibleLines - 1][0] = '\0';
+    cursorColumn = 0;
+    allLinesDirty = true;
+    needsRedraw = true;
+}
+
+/**
+ * @brief Teljes újrarajzolás kérése (pl. dialógus bezárása után)
+ */
+void DecodedTextBox::markForRedraw(bool markChildren) {
+    fullRedraw = true;
+    UIComponent::markForRedraw(markChildren);
+}
+
+/**
+ * @brief Kirajzolás: első alkalommal a teljes doboz, görgetéskor a sorok, egyébként csak a változott rész
+ */
+void DecodedTextBox::draw() {
+    if (!needsRedraw) {
+        return;
+    }
+
+    tft.setFreeFont();
+    tft.setTextDatum(TL_DATUM);
+
+    if (fullRedraw) {
+        tft.fillRect(bounds.x, bounds.y, bounds.width, bounds.height, colors.screenBackground);
+        tft.drawRect(bounds.x, bounds.y, bounds.width, bounds.height, colors.border);
+        drawStatus();
+        for (uint8_t i = 0; i < visibleLines; i++) {
+            drawLine(i);
+        }
+    } else {
+        if (statusDirty) {
+            drawStatus();
+        }
+        if (allLinesDirty) {
+            for (uint8_t i = 0; i < visibleLines; i++) {
+                drawLine(i);
+            }
+        } else if (lastLineDirty) {
+            drawLine(visibleLines - 1);
+        }
+    }
+
+    fullRedraw = allLinesDirty = lastLineDirty = statusDirty = false;
+    needsRedraw = false;
+}
+
+/**
+ * @brief Az állapotsor kirajzolása (kis betűvel, a doboz tetején)
+ */
+void DecodedTextBox::drawStatus() {
+    tft.fillRect(bounds.x + 1, bounds.y + 1, bounds.width - 2, STATUS_HEIGHT, colors.screenBackground);
+    tft.setTextSize(1);
+    tft.setTextColor(STATUS_COLOR, colors.screenBackground);
+    tft.drawString(status, bounds.x + PADDING, bounds.y + PADDING);
+}
+
+/**
+ * @brief Egy szöveg sor kirajzolása (a sor hátralévő része törlődik)
+ */
+void DecodedTextBox::drawLine(uint8_t line) {
+    int16_t x = bounds.x + PADDING;
+    int16_t y = bounds.y + PADDING + STATUS_HEIGHT + line * LINE_HEIGHT;
+
+    tft.setTextSize(TEXT_SIZE);
+    tft.setTextColor(colors.foreground, colors.screenBackground);
+    int16_t textWidth = tft.drawString(lines[line], x, y);
+
+    int16_t clearWidth = columns * CHAR_WIDTH - textWidth;
+    if (clearWidth > 0) {
+        tft.fillRect(x + textWidth, y, clearWidth, LINE_HEIGHT, colors.screenBackground);
+    }
+}
@@ -104,6 +104,13 @@ void FMScreen::layoutComponents() {
     Rect smeterBounds(2, currentY, SMeterConstants::SMETER_WIDTH, 60);
     createSMeterComponent(smeterBounds);
 
+    // ===================================================================
+    // Mini audio kijelző az S-Meter mellett (FM: 15kHz hang sávszélesség)
+    // ===================================================================
+    Rect miniAudioFftBounds(SMeterConstants::SMETER_WIDTH + 10, currentY, 160, 60);
+    miniAudioFft = std::make_shared<MiniAudioFft>(tft, miniAudioFftBounds, config.data.miniAudioFftModeFm, config.data.miniAudioFftConfigFm, 15000);
+    addChild(miniAudioFft);
+
     // ===================================================================
     // Gombsorok létrehozása - Event-driven architektúra
     // ===================================================================
@@ -128,6 +135,11 @@ void FMScreen::layoutComponents() {
  */
 bool FMScreen::handleRotary(const RotaryEvent &event) {
 
+    // Seek közben a klikk megszakítja a keresést, a forgatás nem hangol
+    if (!isDialogActive() && abortSeekOnRotary(event)) {
+        return true;
+    }
+
     // Biztonsági ellenőrzés: csak aktív dialógus nélkül és nem klikk eseménykor
     if (!isDialogActive() && event.buttonState != RotaryEvent::ButtonState::Clicked) {
 
@@ -173,23 +185,24 @@ bool FMScreen::handleRotary(const RotaryEvent &event) {
  */
 void FMScreen::handleOwnLoop() {
 
+    // ===================================================================
+    // Futó seek követése (nem blokkoló)
+    // ===================================================================
+    bool seeking = processSeek();
+
     // ===================================================================
     // S-Meter (jelerősség) időzített frissítése - Közös RadioScreen implementáció
     // ===================================================================
     updateSMeter(true /* FM mód */);
 
     // ===================================================================
-    // RDS adatok valós idejű frissítése
+    // RDS adatok valós idejű frissítése (seek közben nincs értelme)
+    // A chip FIFO ürítése minden ciklusban (belül időzített, csak adat jelzésekor olvas csoportot),
+    // a dekódolás és a rajzolás már I2C forgalom nélkül a csoport pufferből dolgozik
     // ===================================================================
-    if (rdsComponent) {
-        static uint32_t lastRdsCall = 0;
-        uint32_t currentTime = millis();
-
-        // 500ms frissítési időköz az RDS adatokhoz
-        if (currentTime - lastRdsCall >= 500) {
-            rdsComponent->updateRDS();
-            lastRdsCall = currentTime;
-        }
+    if (rdsComponent && !seeking) {
+        pSi4735Manager->drainRdsFifo();
+        rdsComponent->updateRDS();
     }
 
     // Néhány adatot csak ritkábban frissítünk
@@ -354,12 +367,8 @@ void FMScreen::handleSeekDownButton(const UIButton::ButtonEvent &event) {
     if (event.state == UIButton::EventButtonState::Clicked) {
         if (pSi4735Manager) {
             // RDS cache törlése seek indítása előtt
-            clearRDSCache(); // Seek lefelé a RadioScreen metódusával
+            clearRDSCache(); // Seek lefelé a RadioScreen metódusával (a befejezést a handleOwnLoop() követi)
             seekStationDown();
-
-            // Seek befejezése után: RDS és memória státusz frissítése
-            clearRDSCache();
-            checkAndUpdateMemoryStatus();
         }
     }
 }
@@ -375,12 +384,8 @@ void FMScreen::handleSeekUpButton(const UIButton::ButtonEvent &event) {
     if (event.state == UIButton::EventButtonState::Clicked) {
         if (pSi4735Manager) {
             // RDS cache törlése seek indítása előtt
-            clearRDSCache(); // Seek felfelé a RadioScreen metódusával
+            clearRDSCache(); // Seek felfelé a RadioScreen metódusával (a befejezést a handleOwnLoop() követi)
             seekStationUp();
-
-            // Seek befejezése után: RDS és memória státusz frissítése
-            clearRDSCache();
-            checkAndUpdateMemoryStatus();
         }
     }
 }
@@ -452,5 +457,5 @@ void FMScreen::createCommonVerticalButtonsWithCustomMemo() {
     }
 
     // Gombok létrehozása és elhelyezése
-    ButtonsGroupManager<FMScreen>::layoutVerticalButtonGroup(customDefs, &createdVerticalButtons, 0, 0, 5, 60, 32, 3, 4);
+    ButtonsGroupManager<FMScreen>::layoutVerticalButtonGroup(customDefs, &createdVerticalButtons, 0, 0, 5, 60, 32, 3, 3);
 }
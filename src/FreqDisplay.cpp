@@ -11,9 +11,15 @@
 
 #include "FreqDisplay.h"
 #include "DSEG7_Classic_Mini_Regular_34.h"
+#include "SevenSegmentGlyphCache.h"
+#include "SpritePool.h"
+#include "TftDma.h"
 #include "UIColorPalette.h"
 #include "defines.h"
 
+// A 7-szegmenses glyph atlasz: a font bitképe egyszer kicsomagolva, minden FreqDisplay példány közösen használja
+static SevenSegmentGlyphCache glyphCache(DSEG7_Classic_Mini_Regular_34);
+
 // === Globális színkonfigurációk ===
 const FreqSegmentColors defaultNormalColors = UIColorPalette::createNormalFreqColors();
 const FreqSegmentColors defaultBfoColors = UIColorPalette::createBfoFreqColors();
@@ -29,8 +35,9 @@ constexpr static int CHAR_WIDTH_DASH = 23;  // '-' karakter szélessége
  * @brief FreqDisplay konstruktor - inicializálja a frekvencia kijelző komponenst
  */
 FreqDisplay::FreqDisplay(TFT_eSPI &tft_param, const Rect &bounds_param, Si4735Manager *pSi4735Manager)
-    : UIComponent(tft_param, bounds_param), pSi4735Manager(pSi4735Manager), spr(&(this->tft)), normalColors(defaultNormalColors), bfoColors(defaultBfoColors),
-      customColors(defaultNormalColors), useCustomColors(false), currentDisplayFrequency(0), hideUnderline(false), lastUpdateTime(0), needsFullClear(true) {
+    : UIComponent(tft_param, bounds_param), pSi4735Manager(pSi4735Manager), normalColors(defaultNormalColors), bfoColors(defaultBfoColors),
+      customColors(defaultNormalColors), useCustomColors(false), currentDisplayFrequency(0), hideUnderline(false), lastUpdateTime(0), needsFullClear(true), lastDrawMicros(0),
+      zeroBeatShown(false), zeroBeatTone(false), zeroBeatOffsetHz(0), zeroBeatDirty(false) {
 
     // Alapértelmezett háttérszín beállítása
     this->colors.background = TFT_COLOR_BACKGROUND; // Érintési területek inicializálása
@@ -56,7 +63,7 @@ void FreqDisplay::setFrequency(uint16_t freq, bool forceRedraw) {
 
             currentDisplayFrequency = freq;
             lastUpdateTime = currentTime;
-            markForRedraw();
+            UIComponent::markForRedraw(); // A kijelzőn lévő kép érvényes: csak a változott digitek rajzolódnak
         } else {
             // Csak a frekvencia értéket frissítjük, de nem rajzolunk újra azonnal
             currentDisplayFrequency = freq;
@@ -248,27 +255,7 @@ void FreqDisplay::drawFmAmLwStyle(const FrequencyDisplayData &data) {
 
     int freqSpriteX = bounds.x; // nincs margin a bal szélétől
     int freqSpriteY = bounds.y; // Frekvencia sprite létrehozása és rajzolása
-    spr.createSprite(freqSpriteWidth, FREQ_7SEGMENT_HEIGHT);
-    spr.fillSprite(this->colors.background);
-    spr.setTextSize(1);
-    spr.setTextPadding(0);
-    spr.setFreeFont(&DSEG7_Classic_Mini_Regular_34);
-
-    // Inaktív számjegyek rajzolása (ha engedélyezve van) - JOBBRA igazítva a maszkhoz
-    if (config.data.tftDigitLigth) {
-        spr.setTextColor(colors.inactive);
-        spr.setTextDatum(BR_DATUM);                                       // Jobb alsó sarokhoz igazítás
-        spr.drawString(data.mask, freqSpriteWidth, FREQ_7SEGMENT_HEIGHT); // Jobb szélre igazítva
-    }
-
-    // Aktív frekvencia számok rajzolása - JOBBRA igazítva a maszkhoz
-    spr.setTextColor(colors.active);
-    spr.setTextDatum(BR_DATUM);                                          // Jobb alsó sarokhoz igazítás
-    spr.drawString(data.freqStr, freqSpriteWidth, FREQ_7SEGMENT_HEIGHT); // Jobb szélre igazítva
-
-    // Sprite kirajzolása és memória felszabadítása
-    spr.pushSprite(freqSpriteX, freqSpriteY);
-    spr.deleteSprite();
+    drawFrequencySpriteWithSpaces(data, freqSpriteX, freqSpriteY, freqSpriteWidth);
 
     // 2. Mértékegység pozicionálása: frekvencia sprite után jobbra
     int unitX = freqSpriteX + freqSpriteWidth + 8; // 8 pixel gap a frekvencia után
@@ -378,30 +365,62 @@ int FreqDisplay::calculateFixedSpriteWidth(const String &mask) { // Konstans ér
 
 /**
  * @brief Rajzolja a frekvencia sprite-ot space karakterekkel
+ * @details Elsősorban a glyph atlaszból: az előző kép ismeretében csak a megváltozott digitek oszlopai kerülnek ki
+ * (tekerési lépésenként jellemzően 1-2 digit a teljes ~208x38-as terület helyett). Ha az atlasz nem tudja kirajzolni
+ * (pl. "ERROR" szöveg), a sprite a közös poolból jön (4 bites, palettás); ha a pool sem tud sprite-ot adni,
+ * közvetlenül a kijelzőre rajzol (villoghat, de a frekvencia látszik).
  */
 void FreqDisplay::drawFrequencySpriteWithSpaces(const FrequencyDisplayData &data, int x, int y, int width) {
-    const FreqSegmentColors &colors = getSegmentColors(); // Sprite létrehozása
-    spr.createSprite(width, FREQ_7SEGMENT_HEIGHT);
-    spr.fillSprite(this->colors.background);
-    spr.setTextSize(1);
-    spr.setTextPadding(0);
-    spr.setFreeFont(&DSEG7_Classic_Mini_Regular_34);
+    const FreqSegmentColors &colors = getSegmentColors();
+
+    SevenSegmentGlyphCache::Colors glyphColors = {this->colors.background, colors.inactive, colors.active};
+    if (glyphCache.draw(glyphFrame, x, y, width, FREQ_7SEGMENT_HEIGHT, data.mask, data.freqStr.c_str(), glyphColors, config.data.tftDigitLigth)) {
+        tftDma.fence(); // A hívó közvetlenül rajzol tovább (mértékegység, aláhúzás)
+        return;
+    }
+
+    TFT_eSprite *spr = spritePool.lease(width, FREQ_7SEGMENT_HEIGHT, 4);
+    if (spr == nullptr) {
+        tft.fillRect(x, y, width, FREQ_7SEGMENT_HEIGHT, this->colors.background);
+        tft.setTextSize(1);
+        tft.setTextPadding(0);
+        tft.setFreeFont(&DSEG7_Classic_Mini_Regular_34);
+        tft.setTextDatum(BR_DATUM);
+        if (config.data.tftDigitLigth) {
+            tft.setTextColor(colors.inactive);
+            tft.drawString(data.mask, x + width, y + FREQ_7SEGMENT_HEIGHT);
+        }
+        tft.setTextColor(colors.active);
+        tft.drawString(data.freqStr, x + width, y + FREQ_7SEGMENT_HEIGHT);
+        return;
+    }
+
+    // Paletta: a sprite színei ennek indexei
+    spr->setPaletteColor(SPRITE_BACKGROUND_INDEX, this->colors.background);
+    spr->setPaletteColor(SPRITE_INACTIVE_INDEX, colors.inactive);
+    spr->setPaletteColor(SPRITE_ACTIVE_INDEX, colors.active);
+
+    spr->fillSprite(SPRITE_BACKGROUND_INDEX);
+    spr->setTextSize(1);
+    spr->setTextPadding(0);
+    spr->setFreeFont(&DSEG7_Classic_Mini_Regular_34);
 
     // Inaktív számjegyek rajzolása (ha engedélyezve van) - JOBBRA igazítva a maszkhoz
     if (config.data.tftDigitLigth) {
-        spr.setTextColor(colors.inactive);
-        spr.setTextDatum(BR_DATUM);                             // Jobb alsó sarokhoz igazítás
-        spr.drawString(data.mask, width, FREQ_7SEGMENT_HEIGHT); // Jobb szélre igazítva
+        spr->setTextColor(SPRITE_INACTIVE_INDEX);
+        spr->setTextDatum(BR_DATUM);                             // Jobb alsó sarokhoz igazítás
+        spr->drawString(data.mask, width, FREQ_7SEGMENT_HEIGHT); // Jobb szélre igazítva
     }
 
     // Aktív frekvencia számok rajzolása - JOBBRA igazítva a maszkhoz
-    spr.setTextColor(colors.active);
-    spr.setTextDatum(BR_DATUM);                                // Jobb alsó sarokhoz igazítás
-    spr.drawString(data.freqStr, width, FREQ_7SEGMENT_HEIGHT); // Jobb szélre igazítva
-
-    // Sprite kirajzolása és memória felszabadítása
-    spr.pushSprite(x, y);
-    spr.deleteSprite();
+    spr->setTextColor(SPRITE_ACTIVE_INDEX);
+    spr->setTextDatum(BR_DATUM);                                // Jobb alsó sarokhoz igazítás
+    spr->drawString(data.freqStr, width, FREQ_7SEGMENT_HEIGHT); // Jobb szélre igazítva
+
+    // Sprite kirajzolása és visszaadása a poolnak (a puffer megmarad; a kitolás staging pufferből megy)
+    tftDma.pushSprite(*spr, x, y);
+    spritePool.release(spr);
+    tftDma.fence();
 }
 
 /**
@@ -479,6 +498,10 @@ void FreqDisplay::drawFrequencyDisplay(const FrequencyDisplayData &data) {
  */
 void FreqDisplay::draw() {
     if (!needsRedraw) {
+        // Csak a zero-beat jelző változott: a frekvencia nem rajzolódik újra
+        if (zeroBeatDirty) {
+            drawZeroBeat();
+        }
         return;
     }
 
@@ -492,18 +515,25 @@ void FreqDisplay::draw() {
     // Csak akkor töröljük a hátteret, ha szükséges (pl. első rajzolás, mód váltás)
     if (needsFullClear) {
         tft.fillRect(bounds.x, bounds.y, bounds.width, bounds.height, this->colors.background);
+        glyphFrame.invalidate();
         needsFullClear = false; // Reset a flag
     }
 
+    uint32_t start = micros();
+
     // Frekvencia adatok meghatározása
     FrequencyDisplayData data = getFrequencyDisplayData(currentDisplayFrequency);
 
     // Frekvencia rajzolása
     drawFrequencyDisplay(data);
+    if (zeroBeatShown || zeroBeatDirty) {
+        drawZeroBeat();
+    }
 
     // Debug keret - segít az optimalizálásban és pozíciók ellenőrzésében
     // tft.drawRect(bounds.x, bounds.y, bounds.width, bounds.height, TFT_RED);
 
+    lastDrawMicros = micros() - start;
     needsRedraw = false;
 }
 
@@ -511,6 +541,15 @@ void FreqDisplay::draw() {
  * @brief Érintési esemény kezelése
  */
 bool FreqDisplay::handleTouch(const TouchEvent &event) {
+    // Zero-beat jelző érintése (BFO módban is)
+    if (zeroBeatShown && zeroBeatHandler && event.pressed && pSi4735Manager->isCurrentDemodSSBorCW()) {
+        Rect zeroBeatArea(bounds.x + ZERO_BEAT_X_OFFSET, bounds.y + ZERO_BEAT_Y_OFFSET, ZERO_BEAT_WIDTH, ZERO_BEAT_HEIGHT);
+        if (zeroBeatArea.contains(event.x, event.y)) {
+            zeroBeatHandler();
+            return true;
+        }
+    }
+
     // Csak SSB/CW módban és ha nincs elrejtve az aláhúzás
     if (!pSi4735Manager->isCurrentDemodSSBorCW() || hideUnderline || rtv::bfoOn) {
         return false;
@@ -599,27 +638,8 @@ void FreqDisplay::drawBfoStyle(const FrequencyDisplayData &data) {
     int bfoSpriteX = bounds.x + BfoSpriteRightMargin - bfoSpriteWidth;
     int bfoSpriteY = bounds.y;
 
-    // BFO frekvencia sprite létrehozása
-    spr.createSprite(bfoSpriteWidth, FREQ_7SEGMENT_HEIGHT);
-    spr.fillSprite(this->colors.background);
-    spr.setTextSize(1);
-    spr.setTextPadding(0);
-    spr.setFreeFont(&DSEG7_Classic_Mini_Regular_34);
-    spr.setTextDatum(BR_DATUM);
-
-    // Inaktív számjegyek rajzolása (ha engedélyezve van)
-    if (config.data.tftDigitLigth) {
-        spr.setTextColor(colors.inactive);
-        spr.drawString(data.mask, bfoSpriteWidth, FREQ_7SEGMENT_HEIGHT);
-    }
-
-    // Aktív BFO érték rajzolása
-    spr.setTextColor(colors.active);
-    spr.drawString(data.freqStr, bfoSpriteWidth, FREQ_7SEGMENT_HEIGHT);
-
-    // Sprite kirajzolása és törlése
-    spr.pushSprite(bfoSpriteX, bfoSpriteY);
-    spr.deleteSprite();
+    // BFO frekvencia sprite rajzolása
+    drawFrequencySpriteWithSpaces(data, bfoSpriteX, bfoSpriteY, bfoSpriteWidth);
 
     // 2. BFO "Hz" felirat rajzolása
     drawText("Hz", bounds.x + BfoHzLabelXOffset, bounds.y + BfoHzLabelYOffset, UNIT_TEXT_SIZE, BL_DATUM, colors.indicator);
@@ -702,6 +722,19 @@ void FreqDisplay::handleBfoAnimation() {
     tft.fillRect(bounds.x, bounds.y, bounds.width, bounds.height, this->colors.background);
 }
 
+/**
+ * @brief Újrarajzolásra jelölés kívülről - a 7-szegmenses terület teljesen újrarajzolódik
+ */
+void FreqDisplay::markForRedraw(bool markChildren) {
+    UIComponent::markForRedraw(markChildren);
+    glyphFrame.invalidate();
+}
+
+/**
+ * @brief A közös 7-szegmenses glyph atlasz
+ */
+const SevenSegmentGlyphCache &FreqDisplay::getGlyphCache() { return glyphCache; }
+
 /**
  * @brief Kényszeríti a teljes újrarajzolást (BFO módváltáskor)
  */
@@ -732,3 +765,56 @@ void FreqDisplay::setWidth(uint16_t newWidth) {
         markForRedraw();
     }
 }
+
+/**
+ * @brief Beállítja a zero-beat jelző értékét
+ */
+void FreqDisplay::setZeroBeat(bool hasTone, int16_t offsetHz) {
+    if (!zeroBeatShown || zeroBeatTone != hasTone || zeroBeatOffsetHz != offsetHz) {
+        zeroBeatShown = true;
+        zeroBeatTone = hasTone;
+        zeroBeatOffsetHz = offsetHz;
+        zeroBeatDirty = true;
+    }
+}
+
+/**
+ * @brief Elrejti a zero-beat jelzőt
+ */
+void FreqDisplay::hideZeroBeat() {
+    if (zeroBeatShown) {
+        zeroBeatShown = false;
+        zeroBeatDirty = true;
+    }
+}
+
+/**
+ * @brief Rajzolja a zero-beat jelzőt
+ * @details A célhangon (tűrésen belül) zöld, egyébként az indikátor színű; mért hang nélkül halvány "---".
+ * Elrejtéskor (vagy nem SSB/CW módban) csak törli a területét; képernyővédő színekkel nem rajzol.
+ */
+void FreqDisplay::drawZeroBeat() {
+    zeroBeatDirty = false;
+    if (useCustomColors) {
+        return;
+    }
+
+    int x = bounds.x + ZERO_BEAT_X_OFFSET;
+    int y = bounds.y + ZERO_BEAT_Y_OFFSET;
+    tft.fillRect(x, y, ZERO_BEAT_WIDTH, ZERO_BEAT_HEIGHT, this->colors.background);
+    if (!zeroBeatShown || !pSi4735Manager->isCurrentDemodSSBorCW()) {
+        return;
+    }
+
+    const FreqSegmentColors &colors = getSegmentColors();
+    char text[16];
+    uint16_t color;
+    if (zeroBeatTone) {
+        snprintf(text, sizeof(text), "ZB %+d Hz", zeroBeatOffsetHz);
+        color = abs(zeroBeatOffsetHz) <= ZERO_BEAT_TOLERANCE_HZ ? TFT_GREEN : colors.indicator;
+    } else {
+        snprintf(text, sizeof(text), "ZB --- Hz");
+        color = colors.inactive;
+    }
+    drawText(text, x, y, UNIT_TEXT_SIZE, TL_DATUM, color);
+}
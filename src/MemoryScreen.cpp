@@ -562,7 +562,7 @@ StationData MemoryScreen::getCurrentStationData() {
         station.bandIndex = config.data.currentBandIdx; // Band index a config-ból
         station.frequency = currentBand.currFreq;
         station.modulation = currentBand.currDemod;
-        station.bandwidthIndex = 0; // TODO: Ha van bandwidth index tárolás
+        station.bandwidthIndex = pSi4735Manager->getCurrentBandwidthIndex();
     }
 
     return station;
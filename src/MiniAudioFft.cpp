@@ -0,0 +1,382 @@
+/**
+ * @file MiniAudioFft.cpp
+ * @brief Mini audio kijelző komponens implementáció
+ */
+
+#include "MiniAudioFft.h"
+#include "AudioCapture.h"
+#include "TftDma.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+constexpr uint16_t SPECTRUM_LOW_RES_COLOR = TFT_GREEN;
+constexpr uint16_t SPECTRUM_HIGH_RES_COLOR = TFT_CYAN;
+constexpr uint16_t OSCILLOSCOPE_COLOR = TFT_YELLOW;
+constexpr uint16_t ENVELOPE_COLOR = TFT_ORANGE;
+constexpr uint16_t GRID_COLOR = TFT_DARKGREY;
+constexpr uint16_t LABEL_COLOR = TFT_SILVER;
+
+const char *MODE_LABELS[] = {"FFT", "FFT HR", "Scope", "Env"};
+static_assert(ARRAY_ITEM_COUNT(MODE_LABELS) == static_cast<uint8_t>(MiniAudioFft::DisplayMode::Count), "MODE_LABELS mismatch");
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+MiniAudioFft::MiniAudioFft(TFT_eSPI &tft, const Rect &bounds, uint8_t &modeRef, float &gainConfigRef, uint16_t maxDisplayFrequencyHz)
+    : UIComponent(tft, bounds), modeRef(modeRef), gainConfigRef(gainConfigRef), maxDisplayFrequencyHz(maxDisplayFrequencyHz), mode(DisplayMode::SpectrumLowRes),
+      sprite(nullptr), spriteCreated(false), offScreenDrawn(false), fft(HIGH_RES_FFT_SIZE), window(HIGH_RES_FFT_SIZE), samples(nullptr), fftInput(nullptr), magnitudes(nullptr),
+      envelope(nullptr), envelopeHead(0), filledSamples(0), newSamples(0), lastSequence(0), lastFrameTime(0), processMicros(0), lastFrameMicros(0),
+      averageFrameMicros(0), agcGainQ8(AudioAgc::UNITY_GAIN_Q8), frameScale(0.0f), blockConsumer(AudioCapture::INVALID_CONSUMER),
+      captureStarted(false) {
+
+    if (modeRef < static_cast<uint8_t>(DisplayMode::Count)) {
+        mode = static_cast<DisplayMode>(modeRef);
+    }
+
+    if (isEnabled()) {
+        allocateBuffers();
+    }
+}
+
+/**
+ * @brief Destruktor
+ * @details A mintavételezést csak akkor állítja le, ha ő indította, és már senki más nem használja
+ * (pl. az AMScreen szöveg dekódere vagy a zero-beat detektor).
+ */
+MiniAudioFft::~MiniAudioFft() {
+    audioCapture.unregisterConsumer(blockConsumer);
+    if (captureStarted && !audioCapture.hasUsers()) {
+        audioCapture.stop();
+    }
+    releaseBuffers();
+}
+
+/**
+ * @brief Sprite és minta pufferek lefoglalása
+ * @details A sprite 8 bites színmélységű, így a komponens területének csak a felét foglalja a 16 biteshez képest.
+ */
+void MiniAudioFft::allocateBuffers() {
+    sprite = new (std::nothrow) TFT_eSprite(&tft);
+    if (sprite) {
+        sprite->setColorDepth(8);
+        spriteCreated = sprite->createSprite(bounds.width, bounds.height) != nullptr;
+    }
+
+    samples = new (std::nothrow) int16_t[HIGH_RES_FFT_SIZE];
+    fftInput = new (std::nothrow) int16_t[HIGH_RES_FFT_SIZE];
+    magnitudes = new (std::nothrow) uint16_t[HIGH_RES_FFT_SIZE / 2];
+    envelope = new (std::nothrow) uint8_t[bounds.width];
+
+    if (!spriteCreated || !fft.isAvailable() || !window.isAvailable() || !samples || !fftInput || !magnitudes || !envelope) {
+        DEBUG("MiniAudioFft: memória foglalás sikertelen, a komponens inaktív\n");
+        releaseBuffers();
+        return;
+    }
+
+    blockConsumer = audioCapture.registerConsumer();
+    if (blockConsumer == AudioCapture::INVALID_CONSUMER) {
+        releaseBuffers();
+        return;
+    }
+
+    memset(samples, 0, HIGH_RES_FFT_SIZE * sizeof(int16_t));
+    memset(envelope, 0, bounds.width);
+}
+
+/**
+ * @brief Sprite és pufferek felszabadítása
+ */
+void MiniAudioFft::releaseBuffers() {
+    if (sprite) {
+        if (spriteCreated) {
+            sprite->deleteSprite();
+        }
+        delete sprite;
+        sprite = nullptr;
+        spriteCreated = false;
+    }
+    delete[] samples;
+    delete[] fftInput;
+    delete[] magnitudes;
+    delete[] envelope;
+    samples = nullptr;
+    fftInput = nullptr;
+    magnitudes = nullptr;
+    envelope = nullptr;
+}
+
+/**
+ * @brief Érintés: váltás a következő módra (a konfigurációba is visszaírjuk)
+ */
+void MiniAudioFft::onClick(const TouchEvent &event) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    mode = static_cast<DisplayMode>((static_cast<uint8_t>(mode) + 1) % static_cast<uint8_t>(DisplayMode::Count));
+    modeRef = static_cast<uint8_t>(mode);
+    memset(envelope, 0, bounds.width);
+    envelopeHead = 0;
+    lastFrameTime = 0; // Az új mód azonnal megjelenik
+}
+
+/**
+ * @brief Loop: a beérkezett blokkok átvétele, képkocka időközönként a feldolgozás
+ */
+void MiniAudioFft::loop() {
+    if (!samples) {
+        return; // Kikapcsolva vagy nincs memória
+    }
+
+    if (!audioCapture.isAdcBusy()) {
+        filledSamples = 0;
+        audioCapture.flushBlocks(blockConsumer);
+        audioCapture.start(getSampleRate());
+        captureStarted = true;
+    }
+
+    consumeBlocks();
+
+    uint32_t now = millis();
+    if (now - lastFrameTime < FRAME_INTERVAL_MS) {
+        return;
+    }
+    lastFrameTime = now;
+
+    // Amíg a puffer nem telt meg (indulás, kimaradás után), üres képkocka megy ki
+    if (filledSamples == HIGH_RES_FFT_SIZE) {
+        uint32_t start = micros();
+        processFrame();
+        processMicros = micros() - start;
+    }
+    newSamples = 0;
+    markForRedraw();
+}
+
+/**
+ * @brief Minden várakozó blokk átvétele a mintapufferbe (a legújabb HIGH_RES_FFT_SIZE minta marad meg)
+ * @details Más frekvencián vett blokk (pl. egy másik fogyasztó indította a mintavételezést) hibás skálájú spektrumot
+ * adna, ezért eldobjuk, és a puffer újratöltődik.
+ */
+void MiniAudioFft::consumeBlocks() {
+    const AudioBlock *block;
+    while ((block = audioCapture.peekBlock(blockConsumer)) != nullptr) {
+
+        if (block->sampleRate != getSampleRate()) {
+            audioCapture.releaseBlock(blockConsumer);
+            filledSamples = 0;
+            continue;
+        }
+
+        // Kimaradt blokk (túlcsordulás) után a régi minták már nem folytonosak
+        if (filledSamples > 0 && block->sequence != lastSequence + 1) {
+            filledSamples = 0;
+        }
+        lastSequence = block->sequence;
+        agcGainQ8 = block->agcGainQ8;
+
+        memmove(samples, samples + AUDIO_CAPTURE_BLOCK_SIZE, (HIGH_RES_FFT_SIZE - AUDIO_CAPTURE_BLOCK_SIZE) * sizeof(int16_t));
+        memcpy(samples + HIGH_RES_FFT_SIZE - AUDIO_CAPTURE_BLOCK_SIZE, block->samples, AUDIO_CAPTURE_BLOCK_SIZE * sizeof(int16_t));
+        audioCapture.releaseBlock(blockConsumer);
+
+        filledSamples = std::min<uint16_t>(filledSamples + AUDIO_CAPTURE_BLOCK_SIZE, HIGH_RES_FFT_SIZE);
+        newSamples = std::min<uint16_t>(newSamples + AUDIO_CAPTURE_BLOCK_SIZE, HIGH_RES_FFT_SIZE);
+    }
+}
+
+/**
+ * @brief Skála számítása az erősítés beállítás szerint
+ * @param fullScale A teljes kivezérlés értéke
+ * @return Szorzó, amivel az értékek 0..1 közé képződnek (auto gain: az AGC a burkolót fél kivezérlésre hozza)
+ */
+float MiniAudioFft::computeScale(uint32_t fullScale) const { return AudioAgc::getEffectiveGain(gainConfigRef, agcGainQ8) / fullScale; }
+
+/**
+ * @brief Egy képkocka adatainak előállítása az aktuális mód szerint
+ */
+void MiniAudioFft::processFrame() {
+    switch (mode) {
+        case DisplayMode::SpectrumLowRes:
+        case DisplayMode::SpectrumHighRes: {
+            uint16_t size = getFftSize();
+            window.configure(AudioWindow::Type::Hann, size);
+            window.apply(samples + HIGH_RES_FFT_SIZE - size, fftInput);
+            fft.computeMagnitudes(fftInput, size, magnitudes);
+            frameScale = computeScale(window.getCoherentGainQ15()); // A Hann ablak a szinusz csúcsát felezi
+        } break;
+
+        case DisplayMode::Oscilloscope:
+            frameScale = computeScale(32768);
+            break;
+
+        case DisplayMode::Envelope: {
+            // Az előző képkocka óta érkezett minták csúcsa
+            uint32_t peak = 0;
+            for (uint16_t i = HIGH_RES_FFT_SIZE - newSamples; i < HIGH_RES_FFT_SIZE; i++) {
+                peak = std::max<uint32_t>(peak, abs(samples[i]));
+            }
+            frameScale = computeScale(32768);
+            uint16_t half = bounds.height / 2;
+            envelope[envelopeHead] = static_cast<uint8_t>(std::min<float>(peak * frameScale, 1.0f) * (half - 1));
+            envelopeHead = (envelopeHead + 1) % bounds.width;
+        } break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Komponens kirajzolása: a sprite újrarajzolása és kitolása
+ */
+void MiniAudioFft::draw() {
+    if (!needsRedraw) {
+        return;
+    }
+    needsRedraw = false;
+
+    if (!isEnabled() || !samples) {
+        if (!offScreenDrawn) {
+            renderOffState();
+            offScreenDrawn = true;
+        }
+        return;
+    }
+
+    uint32_t start = micros();
+
+    sprite->fillSprite(TFT_BLACK);
+    if (filledSamples == HIGH_RES_FFT_SIZE) {
+        switch (mode) {
+            case DisplayMode::SpectrumLowRes:
+                renderSpectrumLowRes();
+                break;
+            case DisplayMode::SpectrumHighRes:
+                renderSpectrumHighRes();
+                break;
+            case DisplayMode::Oscilloscope:
+                renderOscilloscope();
+                break;
+            case DisplayMode::Envelope:
+                renderEnvelope();
+                break;
+            default:
+                break;
+        }
+    }
+    drawModeLabel();
+    tftDma.pushSprite(*sprite, bounds.x, bounds.y); // Az utolsó csík kitolása alatt a CPU már továbbmegy
+
+    lastFrameMicros = processMicros + (micros() - start);
+    averageFrameMicros = averageFrameMicros == 0 ? lastFrameMicros : (averageFrameMicros * 7 + lastFrameMicros) / 8;
+}
+
+/**
+ * @brief Oszlopos spektrum: minden oszlop a hozzá tartozó binek maximuma
+ */
+void MiniAudioFft::renderSpectrumLowRes() {
+    uint16_t bins = LOW_RES_FFT_SIZE / 2;
+    uint16_t bars = bounds.width / LOW_RES_BAR_PITCH;
+    uint16_t maxHeight = bounds.height - 1;
+
+    for (uint16_t bar = 0; bar < bars; bar++) {
+        uint16_t firstBin = 1 + (static_cast<uint32_t>(bar) * (bins - 1)) / bars;
+        uint16_t lastBin = 1 + (static_cast<uint32_t>(bar + 1) * (bins - 1)) / bars;
+        uint16_t value = 0;
+        for (uint16_t bin = firstBin; bin < std::max<uint16_t>(lastBin, firstBin + 1); bin++) {
+            value = std::max(value, magnitudes[bin]);
+        }
+        uint16_t height = std::min<float>(value * frameScale, 1.0f) * maxHeight;
+        if (height > 0) {
+            sprite->fillRect(bar * LOW_RES_BAR_PITCH, bounds.height - height, LOW_RES_BAR_PITCH - 1, height, SPECTRUM_LOW_RES_COLOR);
+        }
+    }
+}
+
+/**
+ * @brief Pixelenkénti spektrum: oszloponként a hozzá tartozó binek maximuma
+ */
+void MiniAudioFft::renderSpectrumHighRes() {
+    uint16_t bins = HIGH_RES_FFT_SIZE / 2;
+    uint16_t maxHeight = bounds.height - 1;
+
+    for (uint16_t x = 0; x < bounds.width; x++) {
+        uint16_t firstBin = 1 + (static_cast<uint32_t>(x) * (bins - 1)) / bounds.width;
+        uint16_t lastBin = 1 + (static_cast<uint32_t>(x + 1) * (bins - 1)) / bounds.width;
+        uint16_t value = 0;
+        for (uint16_t bin = firstBin; bin < std::max<uint16_t>(lastBin, firstBin + 1); bin++) {
+            value = std::max(value, magnitudes[bin]);
+        }
+        uint16_t height = std::min<float>(value * frameScale, 1.0f) * maxHeight;
+        if (height > 0) {
+            sprite->drawFastVLine(x, bounds.height - height, height, SPECTRUM_HIGH_RES_COLOR);
+        }
+    }
+}
+
+/**
+ * @brief Oszcilloszkóp: a legutóbbi minták felfutó nullátmenetre triggerelve
+ */
+void MiniAudioFft::renderOscilloscope() {
+    int16_t center = bounds.height / 2;
+    sprite->drawFastHLine(0, center, bounds.width, GRID_COLOR);
+
+    // Trigger keresése a puffer utolsó 2*width mintájának első felében, hogy utána még width minta maradjon
+    uint16_t start = HIGH_RES_FFT_SIZE - bounds.width * 2;
+    uint16_t trigger = start + bounds.width;
+    for (uint16_t i = start + 1; i < start + bounds.width; i++) {
+        if (samples[i - 1] < 0 && samples[i] >= 0) {
+            trigger = i;
+            break;
+        }
+    }
+
+    float scale = frameScale * (center - 1);
+    int16_t prevY = center;
+    for (uint16_t x = 0; x < bounds.width; x++) {
+        float value = constrain(samples[trigger + x] * scale, -(center - 1), center - 1);
+        int16_t y = center - static_cast<int16_t>(value);
+        if (x > 0) {
+            sprite->drawLine(x - 1, prevY, x, y, OSCILLOSCOPE_COLOR);
+        }
+        prevY = y;
+    }
+}
+
+/**
+ * @brief Burkoló: a képkockánkénti csúcsok görgetve, a középvonalra tükrözve (a legújabb jobb oldalt)
+ */
+void MiniAudioFft::renderEnvelope() {
+    int16_t center = bounds.height / 2;
+    for (uint16_t x = 0; x < bounds.width; x++) {
+        uint8_t amplitude = envelope[(envelopeHead + x) % bounds.width];
+        sprite->drawFastVLine(x, center - amplitude, amplitude * 2 + 1, ENVELOPE_COLOR);
+    }
+}
+
+/**
+ * @brief A mód felirata a bal felső sarokban
+ */
+void MiniAudioFft::drawModeLabel() {
+    sprite->setFreeFont();
+    sprite->setTextSize(1);
+    sprite->setTextDatum(TL_DATUM);
+    sprite->setTextColor(LABEL_COLOR);
+    sprite->drawString(MODE_LABELS[static_cast<uint8_t>(mode)], 2, 2);
+}
+
+/**
+ * @brief Kikapcsolt (vagy memória hiányában inaktív) állapot kirajzolása közvetlenül a kijelzőre
+ */
+void MiniAudioFft::renderOffState() {
+    tft.fillRect(bounds.x, bounds.y, bounds.width, bounds.height, TFT_COLOR_BACKGROUND);
+    tft.drawRect(bounds.x, bounds.y, bounds.width, bounds.height, GRID_COLOR);
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextColor(GRID_COLOR, TFT_COLOR_BACKGROUND);
+    tft.drawString(isEnabled() ? "No memory" : "Audio off", bounds.centerX(), bounds.centerY());
+}
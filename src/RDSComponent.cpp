@@ -1,4 +1,6 @@
 #include "RDSComponent.h"
+#include "SpritePool.h"
+#include "TftDma.h"
 #include "defines.h"
 #include "utils.h"
 
@@ -159,9 +161,10 @@ void RDSComponent::setRdsColors(uint16_t stationColor, uint16_t typeColor, uint1
     dateTimeColor = timeColor;
     backgroundColor = bgColor;
 
-    // Ha már létezik scroll sprite, frissítjük a színeit
+    // Ha már létezik scroll sprite, frissítjük a palettáját
     if (scrollSprite && scrollSpriteCreated) {
-        scrollSprite->setTextColor(radioTextColor, backgroundColor);
+        scrollSprite->setPaletteColor(SCROLL_BACKGROUND_INDEX, backgroundColor);
+        scrollSprite->setPaletteColor(SCROLL_TEXT_INDEX, radioTextColor);
     }
 }
 
@@ -212,36 +215,35 @@ String RDSComponent::processRadioText(const String &radioText) {
 
 /**
  * @brief Scroll sprite inicializálása
+ * @details A sprite a közös poolból jön (4 bites, kétszínű palettával), és a komponens élete végéig nála marad;
+ * a puffer a képernyőváltás után is megmarad a poolban, így az FM képernyő újranyitásakor nincs új foglalás.
  */
 void RDSComponent::initializeScrollSprite() {
     if (scrollSprite || scrollSpriteCreated) {
         cleanupScrollSprite();
     }
     if (radioTextArea.width > 0 && radioTextArea.height > 0) {
-        scrollSprite = new TFT_eSprite(&tft);
-        if (scrollSprite->createSprite(radioTextArea.width, radioTextArea.height)) {
+        scrollSprite = spritePool.lease(radioTextArea.width, radioTextArea.height, 4);
+        if (scrollSprite) {
+            scrollSprite->setPaletteColor(SCROLL_BACKGROUND_INDEX, backgroundColor);
+            scrollSprite->setPaletteColor(SCROLL_TEXT_INDEX, radioTextColor);
             scrollSprite->setFreeFont(); // Alapértelmezett font
             scrollSprite->setTextSize(2);
-            scrollSprite->setTextColor(radioTextColor, backgroundColor);
+            scrollSprite->setTextColor(SCROLL_TEXT_INDEX, SCROLL_BACKGROUND_INDEX);
             scrollSprite->setTextDatum(TL_DATUM);
             scrollSpriteCreated = true;
         } else {
-            delete scrollSprite;
-            scrollSprite = nullptr;
             scrollSpriteCreated = false;
         }
     }
 }
 
 /**
- * @brief Scroll sprite felszabadítása
+ * @brief Scroll sprite visszaadása a poolnak
  */
 void RDSComponent::cleanupScrollSprite() {
     if (scrollSprite) {
-        if (scrollSpriteCreated) {
-            scrollSprite->deleteSprite();
-        }
-        delete scrollSprite;
+        spritePool.release(scrollSprite);
         scrollSprite = nullptr;
         scrollSpriteCreated = false;
     }
@@ -404,6 +406,7 @@ void RDSComponent::drawDateTime() {
 
 /**
  * @brief Radio text scroll kezelése
+ * @details A sprite kitolása DMA-val indul, de a függvény a végén bevárja (visszatéréskor a busz szabad).
  */
 void RDSComponent::handleRadioTextScroll() {
     if (!scrollSprite || !scrollSpriteCreated || !needsScrolling) {
@@ -417,7 +420,7 @@ void RDSComponent::handleRadioTextScroll() {
     lastScrollUpdate = currentTime;
 
     // Sprite törlése
-    scrollSprite->fillScreen(backgroundColor); // Aktuális radio text lekérése és feldolgozása
+    scrollSprite->fillScreen(SCROLL_BACKGROUND_INDEX); // Aktuális radio text lekérése és feldolgozása
     String radioText = si4735Manager.getCachedRadioText();
     String processedRadioText = processRadioText(radioText);
 
@@ -432,8 +435,8 @@ void RDSComponent::handleRadioTextScroll() {
         scrollSprite->drawString(processedRadioText, secondTextX, 0);
     }
 
-    // Sprite kirakása a képernyőre
-    scrollSprite->pushSprite(radioTextArea.x, radioTextArea.y);
+    // Sprite kirakása a képernyőre (DMA, a scroll léptetése már a kitolás alatt fut)
+    tftDma.pushSprite(*scrollSprite, radioTextArea.x, radioTextArea.y);
 
     // Scroll pozíció frissítése
     scrollOffset += SCROLL_STEP_PIXELS;
@@ -442,6 +445,9 @@ void RDSComponent::handleRadioTextScroll() {
     if (scrollOffset >= radioTextPixelWidth + gapPixels) {
         scrollOffset = 0;
     }
+
+    // A DMA kitolás bevárása: a hívók (dátum/idő, más komponensek) utána közvetlenül a tft-re rajzolnak
+    tftDma.fence();
 }
 
 // ===================================================================
@@ -482,7 +488,7 @@ void RDSComponent::markForRedraw(bool markChildren) {
  */
 void RDSComponent::updateRDS() {
 
-    // Adaptív frissítési időköz figyelembevételével frissítjük az RDS adatokat
+    // A pufferben várakozó RDS csoportok feldolgozása
     updateRdsData();
 
     // Ha a UIComponent szintjén újrarajzolás szükséges, akkor teljes újrarajzolás
@@ -549,8 +555,8 @@ void RDSComponent::clearRdsOnFrequencyChange() {
  * @brief Ellenőrzi, hogy van-e érvényes RDS adat
  */
 bool RDSComponent::hasValidRDS() const {
-    return si4735Manager.isRdsAvailable() && (!si4735Manager.getCachedStationName().isEmpty() || !si4735Manager.getCachedProgramType().isEmpty() ||
-                                              !si4735Manager.getCachedRadioText().isEmpty() || !si4735Manager.getCachedDateTime().isEmpty());
+    return si4735Manager.isRdsAvailable() && (si4735Manager.getCachedStationName()[0] != '\0' || si4735Manager.getCachedProgramType()[0] != '\0' ||
+                                              si4735Manager.getCachedRadioText()[0] != '\0' || si4735Manager.getCachedDateTime()[0] != '\0');
 }
 
 // ===================================================================
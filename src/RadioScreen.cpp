@@ -1,7 +1,7 @@
 /**
  * @file RadioScreen.cpp
  * @brief Rádió vezérlő képernyő alaposztály implementáció
- * @details Seek callback infrastruktúra és rádió-specifikus funkcionalitás
+ * @details Nem blokkoló seek kezelés és rádió-specifikus funkcionalitás
  */
 #include <memory>
 
@@ -61,25 +61,15 @@ void RadioScreen::activate() {
     }
 }
 
-// ===================================================================
-// Seek callback infrastruktúra
-// ===================================================================
-
-/// Static pointer az aktuális RadioScreen instance-ra (seek callback-hez)
-static RadioScreen *g_currentSeekingRadioScreen = nullptr;
-
 /**
- * @brief Callback függvény a SI4735::seekStationProgress számára
- * @param frequency Aktuális frekvencia a seek során
- *
- * @details C-style callback, ami frissíti a frekvencia kijelzőt seek közben.
- * A g_currentSeekingRadioScreen static pointer-en keresztül éri el az instance-t.
+ * @brief RadioScreen deaktiválása
+ * @details Képernyőváltáskor a futó seek-et megszakítjuk, különben a chip a háttérben tovább keresne.
  */
-void radioSeekProgressCallback(uint16_t frequency) {
-    if (g_currentSeekingRadioScreen && g_currentSeekingRadioScreen->freqDisplayComp) {
-        g_currentSeekingRadioScreen->freqDisplayComp->setFrequency(frequency);
-        g_currentSeekingRadioScreen->freqDisplayComp->draw(); // Azonnali frissítés a kijelzőn
+void RadioScreen::deactivate() {
+    if (pSi4735Manager && pSi4735Manager->isSeeking()) {
+        pSi4735Manager->cancelSeek();
     }
+    UIScreen::deactivate();
 }
 
 // ===================================================================
@@ -87,43 +77,76 @@ void radioSeekProgressCallback(uint16_t frequency) {
 // ===================================================================
 
 /**
- * @brief Seek keresés indítása lefelé valós idejű frekvencia frissítéssel
- * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+ * @brief Seek keresés indítása lefelé
  */
 void RadioScreen::seekStationDown() {
     if (pSi4735Manager) {
-        // Static pointer beállítása a callback számára
-        g_currentSeekingRadioScreen = this;
-
-        // Seek lefelé valós idejű frekvencia frissítéssel
-        pSi4735Manager->getSi4735().seekStationProgress(radioSeekProgressCallback, SEEK_DOWN);
-
-        // Static pointer nullázása
-        g_currentSeekingRadioScreen = nullptr;
-
-        // Seek befejezése után: konfiguráció és band tábla frissítése
-        saveCurrentFrequency();
+        if (pSi4735Manager->isSeeking()) {
+            pSi4735Manager->cancelSeek();
+            processSeek(); // Lezárás (kijelző, memória státusz)
+            return;
+        }
+        seekInProgress = pSi4735Manager->startSeek(false);
     }
 }
 
 /**
- * @brief Seek keresés indítása felfelé valós idejű frekvencia frissítéssel
- * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+ * @brief Seek keresés indítása felfelé
  */
 void RadioScreen::seekStationUp() {
     if (pSi4735Manager) {
-        // Static pointer beállítása a callback számára
-        g_currentSeekingRadioScreen = this;
+        if (pSi4735Manager->isSeeking()) {
+            pSi4735Manager->cancelSeek();
+            processSeek(); // Lezárás (kijelző, memória státusz)
+            return;
+        }
+        seekInProgress = pSi4735Manager->startSeek(true);
+    }
+}
 
-        // Seek felfelé valós idejű frekvencia frissítéssel
-        pSi4735Manager->getSi4735().seekStationProgress(radioSeekProgressCallback, SEEK_UP);
+/**
+ * @brief Futó seek követése
+ */
+bool RadioScreen::processSeek() {
+    if (!pSi4735Manager) {
+        return false;
+    }
 
-        // Static pointer nullázása
-        g_currentSeekingRadioScreen = nullptr;
+    // A megszakítás (cancelSeek) is lezárja a seek-et, ezt is itt dolgozzuk fel
+    bool wasSeeking = seekInProgress;
+    Si4735Manager::SeekEvent seekEvent = pSi4735Manager->pollSeek();
+    seekInProgress = pSi4735Manager->isSeeking();
 
-        // Seek befejezése után: konfiguráció és band tábla frissítése
+    if (seekEvent == Si4735Manager::SeekEvent::Progress) {
+        if (freqDisplayComp) {
+            freqDisplayComp->setFrequency(pSi4735Manager->getSeekFrequency());
+        }
+    } else if (wasSeeking && !seekInProgress) {
+        // Seek befejezése után: band tábla, kijelző és memória státusz frissítése
         saveCurrentFrequency();
+        if (freqDisplayComp) {
+            freqDisplayComp->setFrequency(pSi4735Manager->getSeekFrequency());
+        }
+        checkAndUpdateMemoryStatus();
+        onSeekFinished();
+    }
+
+    return seekInProgress;
+}
+
+/**
+ * @brief Futó seek megszakítása rotary eseményre
+ */
+bool RadioScreen::abortSeekOnRotary(const RotaryEvent &event) {
+    if (!pSi4735Manager || !pSi4735Manager->isSeeking()) {
+        return false;
+    }
+
+    if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
+        pSi4735Manager->cancelSeek();
+        processSeek();
     }
+    return true;
 }
 
 // ===================================================================
@@ -0,0 +1,322 @@
+/**
+ * @file RdsDecoder.cpp
+ * @brief Helyi RDS csoport dekóder implementáció
+ */
+
+#include "RdsDecoder.h"
+
+/**
+ * @brief Minden dekódolt adat és részleges szegmens törlése
+ */
+void RdsDecoder::reset() {
+    pi = 0;
+    pty = PTY_NONE;
+    ps[0] = '\0';
+    rt[0] = '\0';
+    ctValid = false;
+    ctYear = 0;
+    ctMonth = 0;
+    ctDay = 0;
+    ctHour = 0;
+    ctMinute = 0;
+
+    piCandidate = 0;
+    ptyCandidate = PTY_NONE;
+    memset(psCandidate, 0, sizeof(psCandidate));
+    psValidMask = 0;
+    resetRadioText();
+    rtAbFlag = 0xFF;
+    rtVersionB = false;
+}
+
+/**
+ * @brief A részleges Radio Text törlése (a publikált szöveg megmarad)
+ */
+void RdsDecoder::resetRadioText() {
+    memset(rtCandidate, 0, sizeof(rtCandidate));
+    rtValidMask = 0;
+    rtEndSegment = RT_SEGMENT_NONE;
+}
+
+/**
+ * @brief Nem megjeleníthető karakterek cseréje szóközre
+ */
+char RdsDecoder::toDisplayChar(uint8_t c) { return (c >= 0x20 && c < 0x7F) ? static_cast<char>(c) : ' '; }
+
+/**
+ * @brief Egy RDS csoport feldolgozása
+ */
+uint8_t RdsDecoder::decodeGroup(const uint16_t blocks[BLOCK_COUNT], const uint8_t errors[BLOCK_COUNT]) {
+
+    // A B blokk nélkül a csoport típusa sem ismert
+    if (errors[BLOCK_B] > BLE_CORRECTED) {
+        return 0;
+    }
+
+    uint16_t blockB = blocks[BLOCK_B];
+    uint8_t groupType = blockB >> 12;
+    bool versionB = blockB & 0x0800;
+
+    uint8_t changed = decodePi(blocks[BLOCK_A], errors[BLOCK_A]);
+    if (versionB) {
+        changed |= decodePi(blocks[BLOCK_C], errors[BLOCK_C]); // B verzióban a C blokk is a PI-t hordozza
+    }
+
+    // PTY minden csoportban jelen van, hibás B blokknál csak ismételt egyezés után fogadjuk el
+    uint8_t newPty = (blockB >> 5) & 0x1F;
+    if ((errors[BLOCK_B] == BLE_NONE || newPty == ptyCandidate) && newPty != pty) {
+        pty = newPty;
+        changed |= CHANGED_PTY;
+    }
+    ptyCandidate = newPty;
+
+    switch (groupType) {
+        case 0:
+            changed |= decodeProgramService(blockB, blocks[BLOCK_D], errors[BLOCK_D]);
+            break;
+        case 2:
+            changed |= decodeRadioText(versionB, blocks, errors);
+            break;
+        case 4:
+            if (!versionB) {
+                changed |= decodeClockTime(blocks, errors);
+            }
+            break;
+        default:
+            break;
+    }
+
+    return changed;
+}
+
+/**
+ * @brief PI kód követése
+ * @details Eltérő PI-t csak két egymást követő egyezés után fogadunk el; ismert PI után ez állomásváltás,
+ * ami minden korábbi adatot érvénytelenít.
+ */
+uint8_t RdsDecoder::decodePi(uint16_t blockPi, uint8_t error) {
+    if (error > BLE_CORRECTED) {
+        return 0;
+    }
+    if (blockPi == pi) {
+        piCandidate = blockPi;
+        return 0;
+    }
+    if (blockPi != piCandidate) {
+        piCandidate = blockPi;
+        return 0;
+    }
+
+    bool stationChanged = pi != 0;
+    if (stationChanged) {
+        reset();
+    }
+    pi = blockPi;
+    piCandidate = blockPi;
+    return stationChanged ? CHANGED_PI : 0;
+}
+
+/**
+ * @brief 0A/0B csoport: Program Service név 2 karakteres szegmense
+ */
+uint8_t RdsDecoder::decodeProgramService(uint16_t blockB, uint16_t blockD, uint8_t error) {
+    if (error > BLE_HEAVY) {
+        return 0;
+    }
+
+    uint8_t segment = blockB & 0x03;
+    uint8_t index = segment * 2;
+    char c0 = toDisplayChar(blockD >> 8);
+    char c1 = toDisplayChar(blockD & 0xFF);
+
+    // Hibátlan vétel, vagy az előzővel egyező tartalom teszi érvényessé a szegmenst
+    bool confirmed = error == BLE_NONE || (psCandidate[index] == c0 && psCandidate[index + 1] == c1);
+    psCandidate[index] = c0;
+    psCandidate[index + 1] = c1;
+
+    if (confirmed) {
+        psValidMask |= (1 << segment);
+    } else {
+        psValidMask &= ~(1 << segment);
+    }
+
+    if (psValidMask != (1 << PS_SEGMENTS) - 1 || memcmp(ps, psCandidate, PS_LENGTH) == 0) {
+        return 0;
+    }
+    memcpy(ps, psCandidate, PS_LENGTH);
+    ps[PS_LENGTH] = '\0';
+    return CHANGED_PS;
+}
+
+/**
+ * @brief 2A/2B csoport: Radio Text szegmens (2A: 4 karakter a C és D blokkban, 2B: 2 karakter a D blokkban)
+ */
+uint8_t RdsDecoder::decodeRadioText(bool versionB, const uint16_t blocks[BLOCK_COUNT], const uint8_t errors[BLOCK_COUNT]) {
+    uint16_t blockB = blocks[BLOCK_B];
+
+    // A/B jelző váltás (vagy 2A <-> 2B váltás): új szöveg kezdődik, a részleges tartalom eldobható.
+    // A publikált szöveg addig marad, amíg az új teljesen össze nem áll.
+    uint8_t abFlag = (blockB >> 4) & 0x01;
+    if (abFlag != rtAbFlag || versionB != rtVersionB) {
+        resetRadioText();
+        rtAbFlag = abFlag;
+        rtVersionB = versionB;
+    }
+
+    uint8_t raw[4];
+    uint8_t count;
+    uint8_t error;
+    if (versionB) {
+        raw[0] = blocks[BLOCK_D] >> 8;
+        raw[1] = blocks[BLOCK_D] & 0xFF;
+        count = 2;
+        error = errors[BLOCK_D];
+    } else {
+        raw[0] = blocks[BLOCK_C] >> 8;
+        raw[1] = blocks[BLOCK_C] & 0xFF;
+        raw[2] = blocks[BLOCK_D] >> 8;
+        raw[3] = blocks[BLOCK_D] & 0xFF;
+        count = 4;
+        error = errors[BLOCK_C] > errors[BLOCK_D] ? errors[BLOCK_C] : errors[BLOCK_D];
+    }
+    if (error > BLE_HEAVY) {
+        return 0;
+    }
+
+    uint8_t segment = blockB & 0x0F;
+    char *dest = rtCandidate + segment * count;
+    bool same = true;
+    bool hasEnd = false;
+    for (uint8_t i = 0; i < count; i++) {
+        char c = raw[i] == RT_END_MARK ? static_cast<char>(RT_END_MARK) : toDisplayChar(raw[i]);
+        hasEnd |= raw[i] == RT_END_MARK;
+        same &= dest[i] == c;
+        dest[i] = c;
+    }
+
+    if (error == BLE_NONE || same) {
+        rtValidMask |= (1 << segment);
+    } else {
+        rtValidMask &= ~(1 << segment);
+    }
+
+    // A vége jel a szöveg hosszát rövidebbre zárja, a korábbi vége jel helyén érkező új tartalom feloldja
+    if (hasEnd) {
+        if (rtEndSegment == RT_SEGMENT_NONE || segment < rtEndSegment) {
+            rtEndSegment = segment;
+        }
+    } else if (segment == rtEndSegment) {
+        rtEndSegment = RT_SEGMENT_NONE;
+    }
+
+    return publishRadioText();
+}
+
+/**
+ * @brief A Radio Text publikálása, ha a vége jelig (vagy a teljes hosszig) minden szegmens érvényes
+ */
+uint8_t RdsDecoder::publishRadioText() {
+    uint8_t lastSegment = rtEndSegment != RT_SEGMENT_NONE ? rtEndSegment : RT_SEGMENTS - 1;
+    uint16_t requiredMask = static_cast<uint16_t>((1UL << (lastSegment + 1)) - 1);
+    if ((rtValidMask & requiredMask) != requiredMask) {
+        return 0;
+    }
+
+    uint8_t length = rtVersionB ? RT_LENGTH / 2 : RT_LENGTH;
+    char text[RT_LENGTH + 1];
+    uint8_t n = 0;
+    while (n < length && rtCandidate[n] != RT_END_MARK) {
+        text[n] = rtCandidate[n];
+        n++;
+    }
+    text[n] = '\0';
+
+    if (strcmp(text, rt) == 0) {
+        return 0;
+    }
+    memcpy(rt, text, n + 1);
+    return CHANGED_RT;
+}
+
+/**
+ * @brief 4A csoport: Clock Time (UTC + helyi eltérés)
+ * @details A hibás idő rosszabb, mint a hiányzó, ezért csak legfeljebb javított blokkokat fogadunk el.
+ */
+uint8_t RdsDecoder::decodeClockTime(const uint16_t blocks[BLOCK_COUNT], const uint8_t errors[BLOCK_COUNT]) {
+    if (errors[BLOCK_C] > BLE_CORRECTED || errors[BLOCK_D] > BLE_CORRECTED) {
+        return 0;
+    }
+
+    uint16_t blockB = blocks[BLOCK_B];
+    uint16_t blockC = blocks[BLOCK_C];
+    uint16_t blockD = blocks[BLOCK_D];
+
+    uint32_t mjd = (static_cast<uint32_t>(blockB & 0x03) << 15) | (blockC >> 1);
+    uint8_t utcHour = ((blockC & 0x01) << 4) | (blockD >> 12);
+    uint8_t utcMinute = (blockD >> 6) & 0x3F;
+    int16_t offsetMinutes = (blockD & 0x1F) * 30; // Helyi eltérés fél órákban
+    if (blockD & 0x20) {
+        offsetMinutes = -offsetMinutes;
+    }
+
+    if (mjd < MJD_MIN || utcHour > 23 || utcMinute > 59) {
+        return 0;
+    }
+
+    // Helyi idő, szükség esetén nap átfordulással
+    int16_t localMinutes = utcHour * 60 + utcMinute + offsetMinutes;
+    if (localMinutes < 0) {
+        localMinutes += 24 * 60;
+        mjd--;
+    } else if (localMinutes >= 24 * 60) {
+        localMinutes -= 24 * 60;
+        mjd++;
+    }
+
+    uint16_t year;
+    uint8_t month, day;
+    mjdToDate(mjd, year, month, day);
+    uint8_t hour = localMinutes / 60;
+    uint8_t minute = localMinutes % 60;
+
+    if (ctValid && ctYear == year && ctMonth == month && ctDay == day && ctHour == hour && ctMinute == minute) {
+        return 0;
+    }
+    ctYear = year;
+    ctMonth = month;
+    ctDay = day;
+    ctHour = hour;
+    ctMinute = minute;
+    ctValid = true;
+    return CHANGED_CT;
+}
+
+/**
+ * @brief Modified Julian Date -> naptári dátum (IEC 62106 képlet, egész aritmetikával)
+ * @details Y' = int((MJD - 15078.2) / 365.25), M' = int((MJD - 14956.1 - int(Y' * 365.25)) / 30.6001),
+ * a tört konstansok 10/100/10000-szeres skálázással egészre hozva.
+ */
+void RdsDecoder::mjdToDate(uint32_t mjd, uint16_t &year, uint8_t &month, uint8_t &day) {
+    uint32_t yp = (mjd * 100 - 1507820) / 36525;
+    uint32_t daysInYears = yp * 36525 / 100;
+    uint32_t mp = ((mjd - 14956 - daysInYears) * 10000 - 1000) / 306001;
+    day = mjd - 14956 - daysInYears - mp * 306001 / 10000;
+    uint8_t k = (mp == 14 || mp == 15) ? 1 : 0;
+    year = 1900 + yp + k;
+    month = mp - 1 - k * 12;
+}
+
+/**
+ * @brief Az utolsó érvényes CT (helyi idő)
+ */
+bool RdsDecoder::getDateTime(uint16_t &year, uint16_t &month, uint16_t &day, uint16_t &hour, uint16_t &minute) const {
+    if (!ctValid) {
+        return false;
+    }
+    year = ctYear;
+    month = ctMonth;
+    day = ctDay;
+    hour = ctHour;
+    minute = ctMinute;
+    return true;
+}
@@ -0,0 +1,341 @@
+/**
+ * @file RttyDecoder.cpp
+ * @brief RTTY (Baudot) dekóder implementáció
+ */
+
+#include "RttyDecoder.h"
+#include <algorithm>
+
+namespace {
+
+constexpr uint16_t BAUD_RATES_X100[] = {4545, 5000, 7500}; // BaudRate sorrendben, századokban
+const char *BAUD_RATE_LABELS[] = {"45.45", "50", "75"};
+
+constexpr uint8_t ITA2_LTRS = 0x1F;  // Betű váltás
+constexpr uint8_t ITA2_FIGS = 0x1B;  // Szám/jel váltás
+constexpr uint8_t ITA2_SPACE = 0x04; // Szóköz (USOS: utána betűk)
+
+constexpr uint8_t ENVELOPE_ATTACK_SHIFT = 3; // ATC követés a csúcs / alapszint felé (~8 minta)
+constexpr uint8_t ENVELOPE_DECAY_SHIFT = 11; // ATC csúcs lecsengés (~2048 minta, 12 kHz-en ~170 ms)
+constexpr uint8_t FLOOR_RISE_SHIFT = 14;     // ATC alapszint emelkedés (12 kHz-en ~1.4 s, hosszú mark szünetet is kibír)
+constexpr int32_t PRESENCE_ON_Q8 = 115;      // Jelenlét: |mark - space| / (mark + space) e fölött bekapcsol (Q8)
+constexpr int32_t PRESENCE_OFF_Q8 = 100;     // ... e alatt kikapcsol (hiszterézis)
+
+// ITA2 kód -> karakter ('\0': nincs megjeleníthető karakter; CR elhagyva, LF sorvége)
+// A számjel tábla az amatőr RTTY-ban szokásos US-TTY változat (0x05 BELL, 0x09 '$', 0x0B '\'', 0x14 '#')
+constexpr char ITA2_LETTERS[32] = {'\0', 'E', '\n', 'A', ' ', 'S', 'I', 'U', '\0', 'D', 'R', 'J', 'N', 'F', 'C', 'K',
+                                   'T',  'Z', 'L',  'W', 'H', 'Y', 'P', 'Q', 'O',  'B', 'G', '\0', 'M', 'X', 'V', '\0'};
+constexpr char ITA2_FIGURES[32] = {'\0', '3', '\n', '-', ' ', '\0', '8', '7', '\0', '$', '4', '\'', ',', '!', ':', '(',
+                                   '5',  '"', ')',  '2', '#', '6',  '0', '1', '9',  '?', '&', '\0', '.', '/', ';', '\0'};
+
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+RttyDecoder::RttyDecoder()
+    : requestedMark(RTTY_DEFAULT_MARKER_FREQUENCY), requestedShift(RTTY_DEFAULT_SHIFT_FREQUENCY), requestedBaud(static_cast<uint8_t>(BaudRate::Baud45)), requestedInverted(false),
+      manualGainQ8(0), resetRequested(false), signalPresent(false), charCount(0), framingErrorCount(0), markFrequency(0), shift(0), baud(0), inverted(false), sampleRate(0),
+      filterAlphaQ15(0), bitLengthQ8(0) {
+
+    for (uint16_t i = 0; i < SINE_TABLE_SIZE; i++) {
+        sineTable[i] = static_cast<int16_t>(sinf(TWO_PI * i / SINE_TABLE_SIZE) * 32767.0f);
+    }
+    resetDecoder();
+}
+
+/**
+ * @brief Mark frekvencia és shift beállítása
+ */
+void RttyDecoder::setTones(float markFrequencyHz, float shiftHz) {
+    if (markFrequencyHz < MIN_TONE_FREQUENCY || shiftHz < MIN_SHIFT || shiftHz > MAX_SHIFT) {
+        DEBUG("RttyDecoder: invalid tones (mark %d Hz, shift %d Hz), using defaults\n", static_cast<int>(markFrequencyHz), static_cast<int>(shiftHz));
+        markFrequencyHz = RTTY_DEFAULT_MARKER_FREQUENCY;
+        shiftHz = RTTY_DEFAULT_SHIFT_FREQUENCY;
+    }
+    requestedMark.store(static_cast<uint16_t>(markFrequencyHz + 0.5f), std::memory_order_release);
+    requestedShift.store(static_cast<uint16_t>(shiftHz + 0.5f), std::memory_order_release);
+}
+
+/**
+ * @brief Adási sebesség beállítása
+ */
+void RttyDecoder::setBaudRate(BaudRate baudRate) {
+    if (baudRate >= BaudRate::Count) {
+        baudRate = BaudRate::Baud45;
+    }
+    requestedBaud.store(static_cast<uint8_t>(baudRate), std::memory_order_release);
+}
+
+/**
+ * @brief A sebesség megjelenítendő neve
+ */
+const char *RttyDecoder::getBaudRateLabel(BaudRate baudRate) { return baudRate < BaudRate::Count ? BAUD_RATE_LABELS[static_cast<uint8_t>(baudRate)] : ""; }
+
+/**
+ * @brief A következő dekódolt karakter kivétele (core0)
+ */
+bool RttyDecoder::popChar(char &c) {
+    const char *next = textQueue.peek();
+    if (next == nullptr) {
+        return false;
+    }
+    c = *next;
+    textQueue.release();
+    return true;
+}
+
+/**
+ * @brief NCO lépések, szűrő együttható és bit hossz számítása a kért beállításokból
+ */
+void RttyDecoder::configure(uint32_t rate) {
+    markFrequency = requestedMark.load(std::memory_order_acquire);
+    shift = requestedShift.load(std::memory_order_acquire);
+    baud = requestedBaud.load(std::memory_order_acquire);
+    inverted = requestedInverted.load(std::memory_order_acquire);
+    sampleRate = rate;
+
+    // LSB vételnél a space a mark felett van, USB-n a két hang helyet cserél
+    uint32_t lowFrequency = markFrequency;
+    uint32_t highFrequency = markFrequency + shift;
+    if (highFrequency * 2 >= rate) {
+        DEBUG("RttyDecoder: %u Hz tone is above the Nyquist limit of %u Hz sampling\n", highFrequency, rate);
+    }
+    markFilter.phaseStep = static_cast<uint32_t>((static_cast<uint64_t>(inverted ? highFrequency : lowFrequency) << 32) / rate);
+    spaceFilter.phaseStep = static_cast<uint32_t>((static_cast<uint64_t>(inverted ? lowFrequency : highFrequency) << 32) / rate);
+
+    // Illesztett szűrő közelítés: két, a baud sebességre hangolt egypólusú fokozat
+    uint32_t baudX100 = BAUD_RATES_X100[baud];
+    filterAlphaQ15 = static_cast<int32_t>((1.0f - expf(-TWO_PI * baudX100 / 100.0f / rate)) * 32768.0f);
+    bitLengthQ8 = static_cast<int32_t>((static_cast<uint64_t>(rate) * 256 * 100) / baudX100);
+
+    resetDecoder();
+}
+
+/**
+ * @brief A szűrők és a keretezés alaphelyzetbe állítása (a beállítások maradnak)
+ */
+void RttyDecoder::resetDecoder() {
+    for (ToneFilter *filter : {&markFilter, &spaceFilter}) {
+        filter->phase = 0;
+        filter->i1 = filter->q1 = filter->i2 = filter->q2 = 0;
+        filter->peak = filter->floor = 0;
+    }
+    frameState = FrameState::WaitMark;
+    bitCounterQ8 = 0;
+    bitIndex = 0;
+    code = 0;
+    lastBit = false;
+    figures = false;
+    chars = 0;
+    framingErrors = 0;
+    qualityQ8 = 0;
+    signalPresent.store(false, std::memory_order_relaxed);
+    charCount.store(0, std::memory_order_relaxed);
+    framingErrorCount.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Egy audio blokk feldolgozása (core1)
+ */
+void RttyDecoder::processBlock(const int16_t *samples, uint16_t count, uint32_t blockSampleRate, uint16_t agcGainQ8) {
+    if (blockSampleRate != sampleRate || requestedMark.load(std::memory_order_acquire) != markFrequency || requestedShift.load(std::memory_order_acquire) != shift ||
+        requestedBaud.load(std::memory_order_acquire) != baud || requestedInverted.load(std::memory_order_acquire) != inverted) {
+        configure(blockSampleRate);
+    }
+    if (resetRequested.load(std::memory_order_acquire)) {
+        resetRequested.store(false, std::memory_order_relaxed);
+        resetDecoder();
+    }
+
+    bool present = signalPresent.load(std::memory_order_relaxed);
+    if (!present) {
+        frameState = FrameState::WaitMark;
+        bitCounterQ8 = 0;
+    }
+
+    int32_t differenceSum = 0;
+    int32_t levelSum = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t x = samples[i] >> 4;
+        int32_t mark = processTone(markFilter, x);
+        int32_t space = processTone(spaceFilter, x);
+        differenceSum += abs(mark - space) >> 8;
+        levelSum += (mark + space) >> 8;
+
+        // ATC: mindkét hangot a saját csúcs/alapszint középéhez mérjük
+        int32_t markLevel = mark - ((markFilter.peak + markFilter.floor) >> 1);
+        int32_t spaceLevel = space - ((spaceFilter.peak + spaceFilter.floor) >> 1);
+
+        if (present) {
+            processBit(markLevel > spaceLevel);
+        }
+    }
+
+    updatePresence(differenceSum, levelSum, AudioAgc::getEffectiveGainQ8(manualGainQ8.load(std::memory_order_relaxed), agcGainQ8));
+
+    charCount.store(chars, std::memory_order_relaxed);
+    framingErrorCount.store(framingErrors, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Jelenlét becslés a blokk mark/space szintjeiből
+ * @details FSK jelnél mindig csak az egyik hang szól, így a két szint különbsége közel akkora, mint az
+ * összegük; zajban a két független szint különbsége ennek csak töredéke. Az arány a jelszinttől független,
+ * és hosszú mark szünetben is magas marad.
+ */
+void RttyDecoder::updatePresence(int32_t differenceSum, int32_t levelSum, uint16_t gainQ8) {
+    constexpr int32_t MIN_PEAK = static_cast<int32_t>(MIN_SIGNAL_LEVEL) << 11; // Amplitúdó -> processTone() egység (/2 keverés, *16, << 8)
+    int32_t minPeak = (MIN_PEAK << AudioAgc::GAIN_SHIFT) / std::max<uint16_t>(gainQ8, 1); // A küszöb az erősítés előtti szintre vetítve
+
+    int32_t quality = levelSum > 0 ? static_cast<int32_t>((static_cast<int64_t>(differenceSum) << 8) / levelSum) : 0;
+    qualityQ8 += (quality - qualityQ8) >> 2;
+
+    bool present = signalPresent.load(std::memory_order_relaxed);
+    if (std::max(markFilter.peak, spaceFilter.peak) < minPeak) {
+        present = false;
+    } else if (qualityQ8 > PRESENCE_ON_Q8) {
+        present = true;
+    } else if (qualityQ8 < PRESENCE_OFF_Q8) {
+        present = false;
+    }
+    signalPresent.store(present, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Egy hang kvadratúra keverése, szűrése és amplitúdója (1/16 minta egység, << 8)
+ * @details A burkoló követők (peak / floor) is itt frissülnek.
+ */
+int32_t RttyDecoder::processTone(ToneFilter &filter, int32_t sample) {
+    uint8_t index = filter.phase >> 24;
+    filter.phase += filter.phaseStep;
+
+    int32_t i = (sample * sineTable[static_cast<uint8_t>(index + SINE_TABLE_SIZE / 4)]) >> 15;
+    int32_t q = (sample * sineTable[index]) >> 15;
+
+    filter.i1 += (((i << 16) - filter.i1) >> 15) * filterAlphaQ15;
+    filter.q1 += (((q << 16) - filter.q1) >> 15) * filterAlphaQ15;
+    filter.i2 += ((filter.i1 - filter.i2) >> 15) * filterAlphaQ15;
+    filter.q2 += ((filter.q1 - filter.q2) >> 15) * filterAlphaQ15;
+
+    // Amplitúdó közelítés: max + 3/8 min (~7% hiba, gyök nélkül)
+    int32_t a = abs(filter.i2 >> 12);
+    int32_t b = abs(filter.q2 >> 12);
+    int32_t magnitude = (a > b ? a + ((b * 3) >> 3) : b + ((a * 3) >> 3)) << 8;
+
+    filter.peak += (magnitude - filter.peak) >> (magnitude > filter.peak ? ENVELOPE_ATTACK_SHIFT : ENVELOPE_DECAY_SHIFT);
+    filter.floor += (magnitude - filter.floor) >> (magnitude < filter.floor ? ENVELOPE_ATTACK_SHIFT : FLOOR_RISE_SHIFT);
+
+    return magnitude;
+}
+
+/**
+ * @brief Egy minta bit döntésének feldolgozása: start él keresés, bit mintavétel, óra korrekció
+ * @param bit true: mark, false: space
+ */
+void RttyDecoder::processBit(bool bit) {
+    bool transition = bit != lastBit;
+    lastBit = bit;
+
+    switch (frameState) {
+        case FrameState::WaitMark:
+            // Legalább egy bitnyi folyamatos mark (stop bit / szünet) után jöhet start bit
+            bitCounterQ8 = bit ? bitCounterQ8 + 256 : 0;
+            if (bitCounterQ8 >= bitLengthQ8) {
+                frameState = FrameState::WaitStart;
+            }
+            return;
+
+        case FrameState::WaitStart:
+            if (!bit) {
+                // Start bit éle: az első mintavétel a start bit közepén
+                frameState = FrameState::StartBit;
+                bitCounterQ8 = bitLengthQ8 / 2;
+            }
+            return;
+
+        default:
+            break;
+    }
+
+    // Bit óra visszaállítás: az átmenetnek két mintavételi pont között félúton kell lennie
+    if (transition && frameState != FrameState::StartBit) {
+        int32_t phaseError = bitCounterQ8 - bitLengthQ8 / 2;
+        bitCounterQ8 -= phaseError >> CLOCK_CORRECTION_SHIFT;
+    }
+
+    bitCounterQ8 -= 256;
+    if (bitCounterQ8 > 0) {
+        return;
+    }
+    bitCounterQ8 += bitLengthQ8;
+
+    switch (frameState) {
+        case FrameState::StartBit:
+            if (bit) {
+                frameState = FrameState::WaitStart; // Zavar impulzus volt, nem start bit
+            } else {
+                frameState = FrameState::DataBits;
+                bitIndex = 0;
+                code = 0;
+            }
+            break;
+
+        case FrameState::DataBits:
+            if (bit) {
+                code |= 1 << bitIndex;
+            }
+            if (++bitIndex == 5) {
+                frameState = FrameState::StopBit;
+            }
+            break;
+
+        case FrameState::StopBit:
+            if (bit) {
+                chars++;
+                emitCode(code);
+                frameState = FrameState::WaitStart;
+            } else {
+                framingErrors++;
+                frameState = FrameState::WaitMark; // Újraszinkronizálás a következő mark szakasz után
+                bitCounterQ8 = 0;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Baudot kód -> karakter, LTRS/FIGS váltás kezelése
+ */
+void RttyDecoder::emitCode(uint8_t baudotCode) {
+    if (baudotCode == ITA2_LTRS) {
+        figures = false;
+        return;
+    }
+    if (baudotCode == ITA2_FIGS) {
+        figures = true;
+        return;
+    }
+
+    char c = figures ? ITA2_FIGURES[baudotCode] : ITA2_LETTERS[baudotCode];
+    if (baudotCode == ITA2_SPACE) {
+        figures = false; // USOS
+    }
+    if (c != '\0') {
+        emitChar(c);
+    }
+}
+
+/**
+ * @brief Karakter átadása a core0-nak (tele sornál elveszik)
+ */
+void RttyDecoder::emitChar(char c) {
+    char *slot = textQueue.beginWrite();
+    if (slot) {
+        *slot = c;
+        textQueue.commitWrite();
+    }
+}
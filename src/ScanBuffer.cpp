@@ -0,0 +1,116 @@
+/**
+ * @file ScanBuffer.cpp
+ * @brief Spektrum scan mérési adat tároló implementáció
+ */
+
+#include "ScanBuffer.h"
+
+/**
+ * @brief Minden mért adat és jelző törlése
+ */
+void ScanBuffer::clear() {
+    memset(rssi, 0, sizeof(rssi));
+    memset(snr, 0, sizeof(snr));
+    memset(validBits, 0, sizeof(validBits));
+    memset(markBits, 0, sizeof(markBits));
+    memset(scaleBits, 0, sizeof(scaleBits));
+}
+
+/**
+ * @brief Skála vonal jelzők törlése
+ */
+void ScanBuffer::clearScaleLines() { memset(scaleBits, 0, sizeof(scaleBits)); }
+
+/**
+ * @brief Egy pont adatainak másolása
+ */
+void ScanBuffer::copyEntry(uint16_t from, uint16_t to) {
+    rssi[to] = rssi[from];
+    snr[to] = snr[from];
+    setBit(validBits, to, getBit(validBits, from));
+    setBit(markBits, to, getBit(markBits, from));
+}
+
+/**
+ * @brief Egy pont adatainak törlése
+ */
+void ScanBuffer::clearEntry(uint16_t pos) {
+    rssi[pos] = 0;
+    snr[pos] = 0;
+    setBit(validBits, pos, false);
+    setBit(markBits, pos, false);
+}
+
+/**
+ * @brief Régi index számítása egy új indexhez
+ * @return A legközelebbi régi index, vagy -1 ha nincs elég közeli régi pont
+ */
+int16_t ScanBuffer::mapToOldPos(uint16_t newPos, uint32_t oldStartFreq, float oldStep, uint32_t newStartFreq, float newStep) {
+    uint32_t targetFreq = newStartFreq + (uint32_t)(newPos * newStep);
+    if (targetFreq < oldStartFreq) {
+        return -1;
+    }
+
+    int32_t oldPos = (int32_t)((float)(targetFreq - oldStartFreq) / oldStep + 0.5f); // Kerekítés
+    if (oldPos >= SIZE) {
+        return -1;
+    }
+
+    // Dupla ellenőrzés: a régi pont frekvenciája legfeljebb fél régi lépésköznyire lehet
+    uint32_t oldPosFreq = oldStartFreq + (uint32_t)(oldPos * oldStep);
+    uint32_t freqDiff = (targetFreq > oldPosFreq) ? (targetFreq - oldPosFreq) : (oldPosFreq - targetFreq);
+    if (freqDiff > (oldStep / 2)) {
+        return -1;
+    }
+
+    return (int16_t)oldPos;
+}
+
+/**
+ * @brief Adatok újramintavételezése szűkebb tartományra, helyben
+ *
+ * A régi index (oldPos(t)) monoton nem csökkenő, és meredeksége legfeljebb 1, így
+ * oldPos(t) - t csökkenő. Legyen c az első index, ahol oldPos(t) < t:
+ * - t >= c: a forrás balra van -> visszafelé haladva (N-1 .. c) nem írunk felül olvasandó adatot
+ * - t < c: a forrás jobbra van, de c alatt marad -> előre haladva (0 .. c-1)
+ * A visszafelé menetet kell előbb futtatni, mert az olvashat a c alatti tartományból.
+ */
+void ScanBuffer::resampleInPlace(uint32_t oldStartFreq, float oldStep, uint32_t newStartFreq, float newStep) {
+    clearScaleLines();
+
+    // Csak szűkítés (zoom in) támogatott, különben a helyben végzett leképezés nem biztonságos
+    if (newStep > oldStep || newStartFreq < oldStartFreq) {
+        clear();
+        return;
+    }
+
+    // Fixpont keresése
+    uint16_t crossover = SIZE;
+    for (uint16_t t = 0; t < SIZE; t++) {
+        int16_t oldPos = mapToOldPos(t, oldStartFreq, oldStep, newStartFreq, newStep);
+        if (oldPos >= 0 && oldPos < (int16_t)t) {
+            crossover = t;
+            break;
+        }
+    }
+
+    // Visszafelé menet: t = SIZE-1 .. crossover
+    for (int16_t t = SIZE - 1; t >= (int16_t)crossover; t--) {
+        int16_t oldPos = mapToOldPos(t, oldStartFreq, oldStep, newStartFreq, newStep);
+        if (oldPos < 0) {
+            clearEntry(t);
+        } else if (oldPos != t) {
+            copyEntry(oldPos, t);
+        }
+    }
+
+    // Előre menet: t = 0 .. crossover-1
+    for (uint16_t t = 0; t < crossover; t++) {
+        int16_t oldPos = mapToOldPos(t, oldStartFreq, oldStep, newStartFreq, newStep);
+        if (oldPos < 0) {
+            clearEntry(t);
+        } else if (oldPos != t) {
+            copyEntry(oldPos, t);
+        }
+    }
+}
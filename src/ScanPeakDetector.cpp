@@ -0,0 +1,179 @@
+/**
+ * @file ScanPeakDetector.cpp
+ * @brief Csúcskeresés a spektrum scan adataiban - implementáció
+ */
+
+#include "ScanPeakDetector.h"
+
+namespace {
+constexpr uint8_t MAX_CANDIDATES = ScanPeakDetector::MAX_PEAKS * 2; // Jelöltek a távolság szűrés előtt
+}
+
+/**
+ * @brief Csúcsok keresése
+ *
+ * 1. Lokális maximumok (platók esetén a plató közepe), a tartomány szélein nem
+ * 2. Prominencia és SNR szűrés
+ * 3. Távolság szűrés erősség szerinti sorrendben (egy széles vivőből egy csúcs marad)
+ */
+uint8_t ScanPeakDetector::findPeaks(const ScanBuffer &data, const Params &params, Peak *peaks, uint8_t maxPeaks) {
+    if (maxPeaks > MAX_PEAKS) {
+        maxPeaks = MAX_PEAKS;
+    }
+    uint16_t endPos = params.endPos > ScanBuffer::SIZE ? ScanBuffer::SIZE : params.endPos;
+    if (maxPeaks == 0 || params.beginPos + 2 >= endPos) {
+        return 0;
+    }
+
+    Peak candidates[MAX_CANDIDATES];
+    uint8_t candidateCount = 0;
+
+    for (uint16_t pos = params.beginPos + 1; pos < endPos - 1; pos++) {
+        if (!data.isValid(pos)) {
+            continue;
+        }
+        uint8_t rssi = data.getRssi(pos);
+
+        // Bal szomszéd: érvénytelen pont völgynek számít
+        if (data.isValid(pos - 1) && data.getRssi(pos - 1) >= rssi) {
+            continue;
+        }
+
+        // Plató vége
+        uint16_t plateauEnd = pos;
+        while (plateauEnd + 1 < endPos && data.isValid(plateauEnd + 1) && data.getRssi(plateauEnd + 1) == rssi) {
+            plateauEnd++;
+        }
+        uint16_t next = plateauEnd + 1;
+        if (next >= endPos || (data.isValid(next) && data.getRssi(next) > rssi)) {
+            pos = plateauEnd;
+            continue; // A tartomány széle vagy emelkedő szakasz - nem csúcs
+        }
+
+        uint16_t peakPos = (pos + plateauEnd) / 2;
+        pos = plateauEnd;
+
+        if (getProminence(data, params, peakPos) < params.minProminence) {
+            continue;
+        }
+        uint8_t snr = getPeakSnr(data, params, peakPos);
+        if (snr < params.minSnr) {
+            continue;
+        }
+
+        // Jelölt felvétele; tele tömbnél a leggyengébbet cseréljük
+        if (candidateCount < MAX_CANDIDATES) {
+            candidates[candidateCount++] = {peakPos, rssi, snr};
+        } else {
+            uint8_t weakest = 0;
+            for (uint8_t i = 1; i < candidateCount; i++) {
+                if (candidates[i].rssi < candidates[weakest].rssi) {
+                    weakest = i;
+                }
+            }
+            if (rssi > candidates[weakest].rssi) {
+                candidates[weakest] = {peakPos, rssi, snr};
+            }
+        }
+    }
+
+    // Erősség szerint csökkenő sorrend (beszúrásos rendezés, kevés elem)
+    for (uint8_t i = 1; i < candidateCount; i++) {
+        Peak key = candidates[i];
+        int8_t j = i - 1;
+        while (j >= 0 && candidates[j].rssi < key.rssi) {
+            candidates[j + 1] = candidates[j];
+            j--;
+        }
+        candidates[j + 1] = key;
+    }
+
+    // Távolság szűrés: a már elfogadott erősebb csúcsok közelében lévőket eldobjuk
+    uint8_t peakCount = 0;
+    for (uint8_t i = 0; i < candidateCount && peakCount < maxPeaks; i++) {
+        bool tooClose = false;
+        for (uint8_t k = 0; k < peakCount; k++) {
+            uint16_t distance = candidates[i].pos > peaks[k].pos ? candidates[i].pos - peaks[k].pos : peaks[k].pos - candidates[i].pos;
+            if (distance < params.minSpacing) {
+                tooClose = true;
+                break;
+            }
+        }
+        if (!tooClose) {
+            peaks[peakCount++] = candidates[i];
+        }
+    }
+
+    // Pozíció szerint növekvő sorrend
+    for (uint8_t i = 1; i < peakCount; i++) {
+        Peak key = peaks[i];
+        int8_t j = i - 1;
+        while (j >= 0 && peaks[j].pos > key.pos) {
+            peaks[j + 1] = peaks[j];
+            j--;
+        }
+        peaks[j + 1] = key;
+    }
+
+    return peakCount;
+}
+
+/**
+ * @brief Prominencia számítása
+ * @details Mindkét irányban a csúcsnál magasabb pontig (vagy a tartomány széléig / érvénytelen pontig)
+ * keressük a legmélyebb völgyet; a prominencia a csúcs és a két völgy közül a magasabbik különbsége.
+ */
+uint8_t ScanPeakDetector::getProminence(const ScanBuffer &data, const Params &params, uint16_t pos) {
+    uint8_t rssi = data.getRssi(pos);
+    uint16_t endPos = params.endPos > ScanBuffer::SIZE ? ScanBuffer::SIZE : params.endPos;
+
+    uint8_t leftMin = rssi;
+    for (int16_t i = pos - 1; i >= (int16_t)params.beginPos; i--) {
+        if (!data.isValid(i)) {
+            leftMin = 0;
+            break;
+        }
+        uint8_t value = data.getRssi(i);
+        if (value > rssi) {
+            break;
+        }
+        if (value < leftMin) {
+            leftMin = value;
+        }
+    }
+
+    uint8_t rightMin = rssi;
+    for (uint16_t i = pos + 1; i < endPos; i++) {
+        if (!data.isValid(i)) {
+            rightMin = 0;
+            break;
+        }
+        uint8_t value = data.getRssi(i);
+        if (value > rssi) {
+            break;
+        }
+        if (value < rightMin) {
+            rightMin = value;
+        }
+    }
+
+    return rssi - (leftMin > rightMin ? leftMin : rightMin);
+}
+
+/**
+ * @brief Legnagyobb SNR a csúcs környezetében
+ * @details Az SNR durvább felbontású és zajosabb mint az RSSI, ezért a csúcs +-minSpacing/2 környezetéből a maximumot vesszük.
+ */
+uint8_t ScanPeakDetector::getPeakSnr(const ScanBuffer &data, const Params &params, uint16_t pos) {
+    uint16_t halfSpacing = params.minSpacing / 2;
+    uint16_t from = pos > params.beginPos + halfSpacing ? pos - halfSpacing : params.beginPos;
+    uint16_t to = pos + halfSpacing < params.endPos ? pos + halfSpacing : params.endPos - 1;
+
+    uint8_t maxSnr = 0;
+    for (uint16_t i = from; i <= to && i < ScanBuffer::SIZE; i++) {
+        if (data.isValid(i) && data.getSnr(i) > maxSnr) {
+            maxSnr = data.getSnr(i);
+        }
+    }
+    return maxSnr;
+}
@@ -12,7 +12,11 @@
  */
 
 #include "ScanScreen.h"
+#include "MessageDialog.h"
+#include "ScanSnapshotStore.h"
 #include "ScreenManager.h"
+#include "StationStore.h"
+#include "UIProfiler.h"
 #include "defines.h"
 #include "rtVars.h"
 
@@ -28,7 +32,8 @@
  * Inicializálja az összes scan paraméter alapértelmezett értékével,
  * létrehozza a scan adattömböket és beállítja a UI komponenseket.
  */
-ScanScreen::ScanScreen(TFT_eSPI &tft, Si4735Manager *si4735Manager) : UIScreen(tft, SCREEN_NAME_SCAN, si4735Manager) { // Scan állapot inicializálása
+ScanScreen::ScanScreen(TFT_eSPI &tft, Si4735Manager *si4735Manager)
+    : UIScreen(tft, SCREEN_NAME_SCAN, si4735Manager), waterfall(SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT, SCAN_WATERFALL_MEMORY_BUDGET) { // Scan állapot inicializálása
     scanState = ScanState::Idle;
     scanMode = ScanMode::Spectrum;
     scanPaused = true;
@@ -48,22 +53,33 @@ ScanScreen::ScanScreen(TFT_eSPI &tft, Si4735Manager *si4735Manager) : UIScreen(t
     scanEndBand = SCAN_RESOLUTION;
     scanMarkSNR = 3;
     scanEmpty = true;
+    resumeAfterRestore = false;
 
     // Mérési konfiguráció
     countScanSignal = 3;
     signalScale = 2.0f;
 
+    // Sweep állapotgép inicializálása
+    resetSweepStateMachine();
+    sweepRateWindowStart = 0;
+    sweepPointsInWindow = 0;
+    sweepPointsPerSecond = 0;
+    lastInfoDrawTime = 0;
+    lastRssi = 0;
+    lastSnr = 0;
+    noiseFloorRssiQ4 = -1;
+    sweepSignalReads = 0;
+    sweepStartTime = 0;
+
     // UI cache inicializálása
     lastStatusText = "";
 
-    // Scan adattömbök inicializálása - minden érték üres állapotra
-    for (int i = 0; i < SCAN_RESOLUTION; i++) {
-        scanValueRSSI[i] = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Spektrum alján (nincs jel)
-        scanValueSNR[i] = 0;
-        scanMark[i] = false;
-        scanScaleLine[i] = 0;
-        scanDataValid[i] = false; // Nincs érvényes adat inicializáláskor
-    }
+    // A scanData a saját konstruktorában üres állapotra inicializálódik, az oszlop cache-t itt ürítjük
+    memset(spectrumColumns, 0, sizeof(spectrumColumns));
+
+    // Waterfall nézet alapállapota
+    waterfallView = false;
+    waterfallFillX = 0;
 
     // UI komponensek létrehozása
     layoutComponents();
@@ -79,17 +95,26 @@ ScanScreen::ScanScreen(TFT_eSPI &tft, Si4735Manager *si4735Manager) : UIScreen(t
  * Meghívódik amikor ez a képernyő aktívvá válik.
  * Inicializálja a scan paramétereket és visszaállítja az alapállapotot,
  * de megőrzi a meglévő scan adatokat ha vannak (pl. screensaver után).
+ * Ha a sávhoz van snapshot, abból azonnal kirajzolható a spektrum, a frissítés a háttérben indul.
  */
 void ScanScreen::activate() {
     UIScreen::activate();
     initializeScan();
+    if (scanEmpty) {
+        restoreSnapshot();
+    }
     calculateScanParameters();
+    updateScaleLines();
+    rebuildSpectrumColumns();
 
     // Csak akkor reseteljük a scant, ha még nincs érvényes adat
     // Ez megőrzi a scan állapotot screensaver után
     if (scanEmpty) {
         resetScan();
     }
+
+    // Info panel kezdeti értékei az aktuális frekvencián
+    getSignalQuality(lastRssi, lastSnr);
 }
 
 /**
@@ -99,6 +124,8 @@ void ScanScreen::activate() {
  * Leállítja a scant és felszabadítja az erőforrásokat.
  */
 void ScanScreen::deactivate() {
+    saveSnapshot();
+    scanSnapshotCache.persist(config.data.currentBandIdx); // EEPROM-ba csak képernyő elhagyáskor kerül (nem minden sweep után)
     stopScan();
     UIScreen::deactivate();
 }
@@ -116,14 +143,14 @@ void ScanScreen::layoutComponents() {
 /**
  * @brief Vízszintes gombsor létrehozása
  *
- * Létrehozza a Start/Pause, Zoom+, Zoom-, Reset és Back gombokat
+ * Létrehozza a Start/Pause, Zoom+, Zoom-, Reset, View, Store és Back gombokat
  * a képernyő alján megfelelő eseménykezelőkkel.
  */
 void ScanScreen::createHorizontalButtonBar() {
     constexpr int16_t margin = 5;
     uint16_t buttonHeight = UIButton::DEFAULT_BUTTON_HEIGHT;
     uint16_t buttonY = UIComponent::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT - margin;
-    uint16_t buttonWidth = 70;
+    uint16_t buttonWidth = 62;
     uint16_t buttonSpacing = 5;
 
     // Start/Pause gomb - scan indítása/megállítása
@@ -174,6 +201,29 @@ void ScanScreen::createHorizontalButtonBar() {
                                              });
     addChild(resetButton);
 
+    // View gomb - váltás spektrum és waterfall nézet között
+    uint16_t viewX = resetX + buttonWidth + buttonSpacing;
+    Rect viewRect(viewX, buttonY, buttonWidth, buttonHeight);
+    viewButton = std::make_shared<UIButton>(tft, VIEW_BUTTON_ID, viewRect, "Wfall", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off,
+                                            [this](const UIButton::ButtonEvent &event) {
+                                                if (event.state == UIButton::EventButtonState::Clicked) {
+                                                    toggleWaterfallView();
+                                                }
+                                            });
+    viewButton->setDisabled(!waterfall.isAvailable());
+    addChild(viewButton);
+
+    // Store gomb - a sweep csúcsainak mentése az állomás listába
+    uint16_t storeX = viewX + buttonWidth + buttonSpacing;
+    Rect storeRect(storeX, buttonY, buttonWidth, buttonHeight);
+    storeButton = std::make_shared<UIButton>(tft, STORE_BUTTON_ID, storeRect, "Store", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off,
+                                             [this](const UIButton::ButtonEvent &event) {
+                                                 if (event.state == UIButton::EventButtonState::Clicked) {
+                                                     storeDetectedStations();
+                                                 }
+                                             });
+    addChild(storeButton);
+
     // Back gomb - visszalépés a főmenübe (jobbra igazítva)
     uint16_t backButtonWidth = 60;
     uint16_t backButtonX = UIComponent::SCREEN_W - backButtonWidth - margin;
@@ -233,16 +283,19 @@ void ScanScreen::drawContent() {
 /**
  * @brief Főciklus kezelése
  *
- * 50ms-enként frissíti a scant ha aktív.
- * Ez biztosítja a folyamatos spektrum pásztázást.
+ * Minden hívásnál továbbléptetjük a sweep állapotgépet, ha a scan aktív.
+ * Az updateScan() korlátos munkát végez, így a loop() soha nem blokkolódik.
  */
 void ScanScreen::handleOwnLoop() {
+    // Snapshot-ból visszaállított spektrum frissítése (az első teljes kirajzolás után)
+    if (resumeAfterRestore) {
+        resumeAfterRestore = false;
+        startScan();
+    }
+
     if (scanState == ScanState::Scanning && !scanPaused) {
-        uint32_t currentTime = millis();
-        if (currentTime - lastScanTime > 50) { // 50ms késleltetés a mérések között
-            updateScan();
-            lastScanTime = currentTime;
-        }
+        updateScan();
+        lastScanTime = millis();
     }
 }
 
@@ -299,6 +352,7 @@ bool ScanScreen::handleTouch(const TouchEvent &event) {
             // Új pozíció frekvenciájának beállítása
             uint32_t newFreq = positionToFreq(currentScanPos);
             setFrequency(newFreq);
+            readCursorSignal();
 
             // Spektrum újrarajzolása a kurzor változás miatt
             if (oldPixelPos != newPixelPos) {
@@ -371,6 +425,7 @@ bool ScanScreen::handleRotary(const RotaryEvent &event) {
                     // Új pozíció frekvenciájának beállítása
                     uint32_t newFreq = positionToFreq(currentScanPos);
                     setFrequency(newFreq);
+                    readCursorSignal();
 
                     // Spektrum újrarajzolása a kurzor változás miatt
                     if (oldPixelPos != newPixelPos) {
@@ -390,6 +445,7 @@ bool ScanScreen::handleRotary(const RotaryEvent &event) {
                 if (newFreq <= scanEndFreq) {
                     currentScanFreq = newFreq;
                     setFrequency(currentScanFreq);
+                    readCursorSignal();
                     drawScanInfo();
                 }
             }
@@ -420,6 +476,7 @@ bool ScanScreen::handleRotary(const RotaryEvent &event) {
                     // Új pozíció frekvenciájának beállítása
                     uint32_t newFreq = positionToFreq(currentScanPos);
                     setFrequency(newFreq);
+                    readCursorSignal();
 
                     // Spektrum újrarajzolása a kurzor változás miatt
                     if (oldPixelPos != newPixelPos) {
@@ -439,6 +496,7 @@ bool ScanScreen::handleRotary(const RotaryEvent &event) {
                 if (newFreq >= scanStartFreq) {
                     currentScanFreq = newFreq;
                     setFrequency(currentScanFreq);
+                    readCursorSignal();
                     drawScanInfo();
                 }
             }
@@ -515,21 +573,30 @@ void ScanScreen::resetScan() {
     // UI cache visszaállítása
     lastStatusText = "";
 
+    // Sweep állapotgép visszaállítása
+    resetSweepStateMachine();
+    sweepPointsPerSecond = 0;
+    noiseFloorRssiQ4 = -1; // Új sávnál a zajszintet újra kell becsülni
+
     // Scan paraméterek újraszámítása
     calculateScanParameters();
 
-    // Összes mért adat törlése
-    for (int i = 0; i < SCAN_RESOLUTION; i++) {
-        scanValueRSSI[i] = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Spektrum alján (nincs jel)
-        scanValueSNR[i] = 0;
-        scanMark[i] = false;
-        scanScaleLine[i] = 0;
-        scanDataValid[i] = false; // Nincs érvényes adat
-    }
+    // Összes mért adat törlése, skála vonalak újraszámítása
+    scanData.clear();
+    updateScaleLines();
 
     // Sáv határok újraszámítása
     scanBeginBand = -1;
     scanEndBand = SCAN_RESOLUTION;
+    rebuildSpectrumColumns();
+
+    // A sáv snapshot-ja is elavult
+    scanSnapshotCache.invalidate(config.data.currentBandIdx);
+
+    // Waterfall előzmények törlése (más sáv / teljes tartomány)
+    waterfall.clear();
+    waterfall.restartLine(scanStartFreq, scanEndFreq);
+    waterfallFillX = 0;
 
     // Gomb állapot frissítése
     if (playPauseButton) {
@@ -559,9 +626,19 @@ void ScanScreen::startScan() {
     scanState = ScanState::Scanning;
     lastScanTime = millis();
 
+    // Az állapotgép mindig hangolással kezd (a félbehagyott pont mérését újrakezdjük)
+    resetSweepStateMachine();
+    sweepRateWindowStart = lastScanTime;
+    sweepPointsInWindow = 0;
+    // Sweep idő mérése csak elejéről induló sweep-nél (pause utáni folytatás részleges lenne)
+    sweepStartTime = currentScanPos == 0 ? lastScanTime : 0;
+    sweepSignalReads = 0;
+
     // Audio némítás a scan közben (gyors frekvencia váltások miatt)
     if (pSi4735Manager) {
         pSi4735Manager->getSi4735().setAudioMute(true);
+        // A library setFrequency() belső várakozását kikapcsoljuk, a settle időt az állapotgép kezeli
+        pSi4735Manager->getSi4735().setMaxDelaySetFrequency(0);
     }
     if (playPauseButton) {
         playPauseButton->setLabel("Pause"); // Scan közben Pause gomb
@@ -582,9 +659,12 @@ void ScanScreen::startScan() {
  */
 void ScanScreen::pauseScan() {
     scanPaused = true;
+    resetSweepStateMachine();
+    sweepStartTime = 0;
 
     // Hang visszakapcsolása pause módban, hogy hallhassuk az aktuális frekvenciát
     if (pSi4735Manager) {
+        pSi4735Manager->getSi4735().setMaxDelaySetFrequency(MAX_DELAY_AFTER_SET_FREQUENCY);
         pSi4735Manager->getSi4735().setAudioMute(false);
     }
     if (playPauseButton) {
@@ -604,6 +684,12 @@ void ScanScreen::pauseScan() {
 void ScanScreen::stopScan() {
     scanState = ScanState::Idle;
     scanPaused = true;
+    resetSweepStateMachine();
+
+    // A library alapértelmezett hangolási várakozásának visszaállítása
+    if (pSi4735Manager) {
+        pSi4735Manager->getSi4735().setMaxDelaySetFrequency(MAX_DELAY_AFTER_SET_FREQUENCY);
+    }
     if (playPauseButton) {
         playPauseButton->setLabel("Start"); // Stop után Start gomb
     }
@@ -613,41 +699,164 @@ void ScanScreen::stopScan() {
 }
 
 /**
- * @brief Scan frissítése (egy lépés)
+ * @brief Az aktuális sáv snapshot-jának visszaállítása
+ * @return true, ha volt snapshot
  *
- * Minden meghíváskor egy frekvencia pontot mér le:
- * - Beállítja a frekvenciát
- * - Mér RSSI és SNR értékeket
- * - Értékeli az állomás jelenlétét
- * - Frissíti a spektrum megjelenítést
- * - Léptet a következő pozícióra
+ * A ScreenManager minden képernyőváltáskor újra létrehozza a ScanScreen-t, így a mért adatok
+ * csak a globális snapshot gyorsítótárban élik túl a váltást.
+ */
+bool ScanScreen::restoreSnapshot() {
+    const ScanSnapshot *snapshot = scanSnapshotCache.find(config.data.currentBandIdx);
+    if (!snapshot) {
+        return false;
+    }
+
+    scanStartFreq = snapshot->data.startFreq;
+    scanEndFreq = snapshot->data.endFreq;
+    zoomLevel = snapshot->data.zoomLevel;
+    zoomGeneration = snapshot->data.zoomGeneration;
+    ScanSnapshotCache::unpack(snapshot->data, scanData);
+    currentScanPos = 0;
+    currentScanFreq = scanStartFreq;
+    scanEmpty = false;
+    resumeAfterRestore = true;
+
+    waterfall.restartLine(scanStartFreq, scanEndFreq);
+    waterfallFillX = 0;
+
+    DEBUG("ScanScreen: snapshot visszaállítva (band %u, zoom %.2f)\n", config.data.currentBandIdx, zoomLevel);
+    return true;
+}
+
+/**
+ * @brief Az aktuális scan mentése a snapshot gyorsítótárba (sweep végén és a képernyő elhagyásakor)
+ */
+void ScanScreen::saveSnapshot() {
+    if (scanEmpty) {
+        return;
+    }
+    scanSnapshotCache.store(config.data.currentBandIdx, scanStartFreq, scanEndFreq, zoomLevel, zoomGeneration, scanData);
+}
+
+/**
+ * @brief Scan frissítése (korlátos munka egy hívásban)
+ *
+ * Nem blokkoló állapotgép: Tune -> Settle -> Sample -> Advance.
+ * - Tune: frekvencia beállítása, settle határidő indítása
+ * - Settle: a minimális határidő után tune status polling (CANCEL nélkül) az STC bitig;
+ *   amíg nincs kész, visszaadjuk a vezérlést a loop()-nak
+ * - Sample: mintánként egyetlen RSSI/SNR olvasás, adaptív darabszámmal (lásd needsMoreSamples())
+ * - Advance: pont tárolása, állomás jelölés, rajzolás, léptetés
+ *
+ * Mivel minden pont után újra kell hangolni és várni, egy hívás legfeljebb egy pontot mér le;
+ * a munkaidőt SWEEP_LOOP_BUDGET_US korlátozza, így az érintés és a rotary kezelése nem akad meg.
  */
 void ScanScreen::updateScan() {
-    if (!pSi4735Manager || scanPaused || currentScanPos >= SCAN_RESOLUTION) {
+    if (!pSi4735Manager || scanPaused) {
         return;
     }
 
-    // Aktuális frekvencia számítása
-    uint32_t scanFreq = positionToFreq(currentScanPos);
-    setFrequency(scanFreq);
+    uint32_t loopStartUs = micros();
+    uint8_t pointsDone = 0;
+    bool yieldToLoop = false;
 
-    // Jel mérése - optimalizált: egyszerre RSSI és SNR
-    int16_t rssiY;
-    uint8_t snr;
-    getSignalQuality(rssiY, snr);
-    scanValueRSSI[currentScanPos] = rssiY;
-    scanValueSNR[currentScanPos] = snr;
-    scanDataValid[currentScanPos] = true; // Megjelöljük, hogy érvényes adat van itt
+    while (!yieldToLoop && (micros() - loopStartUs) < SWEEP_LOOP_BUDGET_US) {
+        switch (sweepPhase) {
+            case SweepPhase::Tune:
+                if (currentScanPos >= SCAN_RESOLUTION) {
+                    currentScanPos = 0;
+                }
+                tuneFrequency(positionToFreq(currentScanPos));
+                sweepSettleDeadline = micros() + SWEEP_SETTLE_TIME_US;
+                sweepRssiSum = 0;
+                sweepSnrSum = 0;
+                sweepSampleCount = 0;
+                sweepPhase = SweepPhase::Settle;
+                break;
+
+            case SweepPhase::Settle: {
+                // Előjeles különbség: micros() túlcsordulás esetén is helyes
+                int32_t sinceDeadline = (int32_t)(micros() - sweepSettleDeadline);
+                if (sinceDeadline < 0) {
+                    yieldToLoop = true; // A minimális settle idő még nem telt le
+                    break;
+                }
 
-    // Állomás jelzés SNR alapján - minden méréskor újra értékeljük
-    if (scanValueSNR[currentScanPos] >= scanMarkSNR && currentScanPos > scanBeginBand && currentScanPos < scanEndBand) {
-        scanMark[currentScanPos] = true;
-    } else {
-        scanMark[currentScanPos] = false; // Töröljük a régi jelzést ha már nincs elég jel
+                // Tune status olvasás INTACK és CANCEL nélkül: a hangolást nem szakítjuk meg
+                SI4735 &si4735 = pSi4735Manager->getSi4735();
+                si4735.getStatus(0, 0);
+                if (si4735.getTuneCompleteTriggered()) {
+                    si4735.getStatus(1, 0); // STC interrupt nyugtázása a következő hangolás előtt
+                    sweepPhase = SweepPhase::Sample;
+                } else if ((uint32_t)sinceDeadline >= SWEEP_TUNE_TIMEOUT_US) {
+                    DEBUG("ScanScreen: STC timeout at %lu\n", currentScanFreq);
+                    sweepPhase = SweepPhase::Sample;
+                } else {
+                    yieldToLoop = true; // Még hangol, majd a következő hívásban újra nézzük
+                }
+                break;
+            }
+
+            case SweepPhase::Sample: {
+                SignalQualityData signalQuality = pSi4735Manager->getSignalQualityRealtime();
+                sweepRssiSum += signalQuality.rssi;
+                sweepSnrSum += signalQuality.snr;
+                sweepSampleCount++;
+                sweepSignalReads++;
+                if (!needsMoreSamples()) {
+                    sweepPhase = SweepPhase::Advance;
+                }
+                break;
+            }
+
+            case SweepPhase::Advance: {
+                int16_t avgRssi = sweepRssiSum / sweepSampleCount;
+                uint8_t avgSnr = sweepSnrSum / sweepSampleCount;
+                updateNoiseFloor(avgRssi, avgSnr);
+                commitScanPoint(avgRssi, avgSnr);
+                pointsDone++;
+                sweepPhase = SweepPhase::Tune;
+                break;
+            }
+        }
+    }
+
+    uint32_t workTimeUs = micros() - loopStartUs;
+    if (workTimeUs > sweepMaxLoopTimeUs) {
+        sweepMaxLoopTimeUs = workTimeUs;
     }
 
-    // Spektrum vonal rajzolása (pixel pozícióra konvertálás)
+    updateSweepRate();
+
+    // Info panel frissítése ritkítva (a szöveg rajzolás drága)
+    uint32_t now = millis();
+    if (pointsDone > 0 && now - lastInfoDrawTime >= SWEEP_INFO_REFRESH_MS) {
+        drawScanInfo();
+        lastInfoDrawTime = now;
+    }
+}
+
+/**
+ * @brief Egy lemért pont tárolása és megjelenítése
+ * @param rssi Átlagolt RSSI (dBuV)
+ * @param snr Átlagolt SNR
+ */
+void ScanScreen::commitScanPoint(uint8_t rssi, uint8_t snr) {
+    scanData.set(currentScanPos, rssi, snr); // Érvényesnek is jelöli
+    lastRssi = rssi;
+    lastSnr = snr;
+
+    // Állomás jelzés SNR alapján - minden méréskor újra értékeljük (a régi jelzés törlődik, ha már nincs elég jel)
+    scanData.setMark(currentScanPos, snr >= scanMarkSNR && currentScanPos > scanBeginBand && currentScanPos < scanEndBand);
+
+    // Oszlop cache és waterfall head sor frissítése, spektrum vonal rajzolása (pixel pozícióra konvertálás)
     uint16_t pixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
+    updateSpectrumColumn(pixelPos);
+    const SpectrumColumn &column = spectrumColumns[pixelPos];
+    waterfall.setColumn(pixelPos, (column.flags & COLUMN_HAS_DATA) ? column.rssi : 0);
+    if (pixelPos >= waterfallFillX) {
+        waterfallFillX = pixelPos + 1;
+    }
     drawSpectrumLine(pixelPos);
 
     // Előző pozíció kurzorának törlése (ha volt)
@@ -661,15 +870,200 @@ void ScanScreen::updateScan() {
 
     // Pozíció léptetése
     currentScanPos++;
+    sweepPointsInWindow++;
 
     // Ha végére értünk, újrakezdés
     if (currentScanPos >= SCAN_RESOLUTION) {
         currentScanPos = 0;
         scanEmpty = false;
+
+        // Kész waterfall sor lezárása; nézetben csak a lezárt (kurzor törlése) és az új head sor rajzolódik újra
+        uint16_t finishedLine = waterfall.getHeadLine();
+        waterfall.commitLine(scanStartFreq, scanEndFreq);
+        waterfallFillX = 0;
+        if (waterfallView) {
+            drawWaterfallRow(finishedLine);
+            drawWaterfallRow(waterfall.getHeadLine());
+        }
+
+        saveSnapshot();
+
+        uint32_t now = millis();
+        if (sweepStartTime != 0) {
+            DEBUG("ScanScreen: sweep kész, %lu ms, %u pont/s, max loop munka: %lu us, I2C olvasás/pont: %lu.%02lu\n", now - sweepStartTime, sweepPointsPerSecond,
+                  sweepMaxLoopTimeUs, sweepSignalReads / SCAN_RESOLUTION, (sweepSignalReads % SCAN_RESOLUTION) * 100 / SCAN_RESOLUTION);
+        }
+        sweepStartTime = now;
+        sweepMaxLoopTimeUs = 0;
+        sweepSignalReads = 0;
     }
+}
 
-    // Információk frissítése
-    drawScanInfo();
+/**
+ * @brief Eldönti, kell-e még mérés az aktuális pontban (adaptív dwell)
+ * @return true, ha a pont még nem dönthető el egyértelműen és van még mérési keret
+ *
+ * - Zaj (SNR jóval a küszöb alatt, RSSI a zajszint közelében): 1 mérés után kilépünk
+ * - Erős jel (SNR jóval a küszöb felett): SAMPLE_MIN_STRONG_READS mérés elég
+ * - A scanMarkSNR küszöb közelében: countScanSignal mérésig átlagolunk
+ */
+bool ScanScreen::needsMoreSamples() const {
+    if (sweepSampleCount >= countScanSignal) {
+        return false;
+    }
+
+    int16_t avgRssi = sweepRssiSum / sweepSampleCount;
+    int16_t avgSnr = sweepSnrSum / sweepSampleCount;
+
+    // Egyértelműen zaj - csak akkor, ha már van zajszint becslésünk
+    if (noiseFloorRssiQ4 >= 0 && avgSnr + SAMPLE_SNR_DECISION_MARGIN <= scanMarkSNR && avgRssi * 16 <= noiseFloorRssiQ4 + SAMPLE_NOISE_RSSI_MARGIN * 16) {
+        return false;
+    }
+
+    // Egyértelműen erős jel
+    if (avgSnr >= scanMarkSNR + SAMPLE_SNR_DECISION_MARGIN && sweepSampleCount >= SAMPLE_MIN_STRONG_READS) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Zajszint becslés frissítése a jel nélküli pontokból
+ * @param rssi A pont átlagolt RSSI értéke (dBuV)
+ * @param snr A pont átlagolt SNR értéke
+ * @details Exponenciális átlag (1/8 súly) Q4 fixpontban; állomás jelölésű pontok nem számítanak bele.
+ */
+void ScanScreen::updateNoiseFloor(int16_t rssi, uint8_t snr) {
+    if (snr >= scanMarkSNR) {
+        return;
+    }
+    if (noiseFloorRssiQ4 < 0) {
+        noiseFloorRssiQ4 = rssi * 16; // Első becslés
+    } else {
+        noiseFloorRssiQ4 += (rssi * 16 - noiseFloorRssiQ4) / 8;
+    }
+}
+
+/**
+ * @brief Pont/másodperc áteresztőképesség számítása
+ */
+void ScanScreen::updateSweepRate() {
+    uint32_t now = millis();
+    uint32_t elapsed = now - sweepRateWindowStart;
+    if (elapsed >= SWEEP_RATE_WINDOW_MS) {
+        sweepPointsPerSecond = (uint32_t)sweepPointsInWindow * 1000 / elapsed;
+        sweepPointsInWindow = 0;
+        sweepRateWindowStart = now;
+    }
+}
+
+/**
+ * @brief Sweep állapotgép alapállapotba állítása
+ * @details A félbehagyott pont mérése elvész, a következő hívás újrahangol.
+ */
+void ScanScreen::resetSweepStateMachine() {
+    sweepPhase = SweepPhase::Tune;
+    sweepSettleDeadline = 0;
+    sweepRssiSum = 0;
+    sweepSnrSum = 0;
+    sweepSampleCount = 0;
+    sweepMaxLoopTimeUs = 0;
+}
+
+// ===================================================================
+// Állomás kinyerés (csúcskeresés)
+// ===================================================================
+
+/**
+ * @brief Csúcsok keresése az aktuális scan adatokban
+ * @param peaks Kimeneti tömb
+ * @param maxPeaks A kimeneti tömb mérete
+ * @return A talált csúcsok száma
+ *
+ * A minimális csúcstávolság az aktuális sáv lépésközéből adódik (pl. MW 9 kHz, FM 100 kHz),
+ * így egy széles AM vivő pontonkénti jelölései egyetlen állomássá olvadnak össze.
+ */
+uint8_t ScanScreen::detectPeaks(ScanPeakDetector::Peak *peaks, uint8_t maxPeaks) {
+    if (!pSi4735Manager || scanEmpty) {
+        return 0;
+    }
+
+    BandTable &currentBand = pSi4735Manager->getCurrentBand();
+    uint16_t stepPoints = (uint16_t)(currentBand.currStep * 10 / scanStep); // Sáv lépésköz pontokban (scan egység = sáv egység * 10)
+
+    ScanPeakDetector::Params params;
+    params.beginPos = scanBeginBand < 0 ? 0 : scanBeginBand + 1;
+    params.endPos = scanEndBand > SCAN_RESOLUTION ? SCAN_RESOLUTION : scanEndBand;
+    params.minSpacing = stepPoints > 0 ? stepPoints : 1;
+    params.minProminence = PEAK_MIN_PROMINENCE;
+    params.minSnr = scanMarkSNR;
+
+    uint8_t peakCount = ScanPeakDetector::findPeaks(scanData, params, peaks, maxPeaks);
+    DEBUG("ScanScreen: %u csúcs (távolság: %u pont, prominencia: %u dBuV)\n", peakCount, params.minSpacing, params.minProminence);
+    return peakCount;
+}
+
+/**
+ * @brief A sweep-ben talált állomások mentése az FM/AM állomás listába
+ *
+ * A csúcsok a sáv csatorna rácsára kerülnek (snapToChannel), a duplikátum szűrés (a cikluson belül és
+ * a tárolóval szemben) már a rácsra igazított frekvencián történik. Egyetlen tömeges hozzáadás (egy EEPROM mentés),
+ * a már tárolt frekvenciák kimaradnak. Az állomás neve a csúcs RSSI/SNR értékét tartalmazza.
+ */
+void ScanScreen::storeDetectedStations() {
+    if (!pSi4735Manager) {
+        return;
+    }
+
+    if (!scanPaused) {
+        pauseScan();
+    }
+
+    ScanPeakDetector::Peak peaks[ScanPeakDetector::MAX_PEAKS];
+    uint8_t peakCount = detectPeaks(peaks, ScanPeakDetector::MAX_PEAKS);
+
+    BandTable &currentBand = pSi4735Manager->getCurrentBand();
+    uint8_t bandwidthIndex = pSi4735Manager->getCurrentBandwidthIndex(); // Mint a MemoryScreen hozzáadásnál
+    StationData stations[ScanPeakDetector::MAX_PEAKS];
+    uint8_t stationCount = 0;
+    uint8_t lastRssi = 0; // Az utoljára felvett csatorna legerősebb csúcsa
+
+    for (uint8_t i = 0; i < peakCount; i++) {
+        uint16_t frequency = snapToChannel(positionToFreq(peaks[i].pos));
+
+        // Ugyanarra a csatornára eső csúcsok: az erősebb marad (pozíció szerint rendezett, a rács monoton, elég az előzővel összevetni)
+        if (stationCount > 0 && stations[stationCount - 1].frequency == frequency) {
+            if (peaks[i].rssi > lastRssi) {
+                lastRssi = peaks[i].rssi;
+                snprintf(stations[stationCount - 1].name, STATION_NAME_BUFFER_SIZE, "Scan R%u S%u", peaks[i].rssi, peaks[i].snr);
+            }
+            continue;
+        }
+
+        StationData &station = stations[stationCount++];
+        memset(&station, 0, sizeof(StationData));
+        station.bandIndex = config.data.currentBandIdx;
+        station.frequency = frequency;
+        station.modulation = currentBand.currDemod;
+        station.bandwidthIndex = bandwidthIndex;
+        snprintf(station.name, STATION_NAME_BUFFER_SIZE, "Scan R%u S%u", peaks[i].rssi, peaks[i].snr);
+        lastRssi = peaks[i].rssi;
+    }
+
+    uint8_t added = 0;
+    if (stationCount > 0) {
+        if (pSi4735Manager->isCurrentBandFM()) {
+            added = fmStationStore.addStations(stations, stationCount);
+        } else {
+            added = amStationStore.addStations(stations, stationCount);
+        }
+    }
+
+    char message[64];
+    snprintf(message, sizeof(message), "Found: %u stations\nStored: %u new", stationCount, added);
+    auto dialog = std::make_shared<MessageDialog>(this, tft, Rect(-1, -1, 260, 0), "Scan stations", message, MessageDialog::ButtonsType::Ok);
+    showDialog(dialog);
 }
 
 // ===================================================================
@@ -679,111 +1073,123 @@ void ScanScreen::updateScan() {
 /**
  * @brief Teljes spektrum kirajzolása
  *
- * Kirajzolja az összes spektrum vonalat pixel-enkénti felbontásban.
- * Minden pixel reprezentálja egy vagy több mérési pontot.
+ * Egyetlen menet az oszlop cache felett; minden oszlop a teljes magasságát kirajzolja,
+ * ezért előzetes területtörlés nem kell.
  */
 void ScanScreen::drawSpectrum() {
-    // Spektrum terület törlése
-    tft.fillRect(SCAN_AREA_X, SCAN_AREA_Y, SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT, TFT_COLOR_BACKGROUND);
+    if (waterfallView) {
+        drawWaterfall();
+        return;
+    }
+
+    UI_PROFILE_SCOPE(ScanSpectrum);
 
-    // Minden pixel spektrum vonalának kirajzolása
-    for (int x = 0; x < SCAN_AREA_WIDTH; x++) {
+    for (uint16_t x = 0; x < SCAN_AREA_WIDTH; x++) {
         drawSpectrumLine(x);
     }
 }
 
 /**
- * @brief Egy spektrum vonal kirajzolása
+ * @brief Egy pixel oszlop aggregátumának újraszámítása a scan adatokból
  * @param pixelX A vízszintes pixel pozíció (0-SCAN_AREA_WIDTH)
  *
- * Ez a függvény felelős egy vertikális spektrum vonal kirajzolásáért.
- * Több mérési pontot átlagol egy pixelre és különböző színekkel jeleníti meg:
- * - SNR alapú színkódolás (kék->narancs->piros)
- * - Skála vonalak (oliva háttér)
- * - Állomás jelzők (zöld pontok)
- * - Kurzor pozíció (piros vonal)
+ * Átlagolja az oszlopba eső érvényes mérési pontokat, összegyűjti az állomás és skála jelzőket,
+ * és az átlagfrekvencia alapján jelöli/rögzíti a sáv határokat.
  */
-void ScanScreen::drawSpectrumLine(uint16_t pixelX) {
+void ScanScreen::updateSpectrumColumn(uint16_t pixelX) {
     if (pixelX >= SCAN_AREA_WIDTH)
         return;
 
-    uint16_t screenX = SCAN_AREA_X + pixelX;
-
     // Mérési pontok tartományának meghatározása ehhez a pixelhez
     uint16_t dataStart = (pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
     uint16_t dataEnd = ((pixelX + 1) * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
 
-    // Átlagolási változók inicializálása
-    int16_t avgRSSI = 0;
-    uint8_t avgSNR = 0;
-    bool hasStation = false;
-    bool isMainScale = false;
+    uint16_t rssiSum = 0;
+    uint16_t snrSum = 0;
+    uint8_t validSamples = 0;
+    uint8_t flags = 0;
     uint32_t avgFreq = 0;
 
-    // Mérési pontok átlagolása ebben a pixelben
-    int validSamples = 0;
     for (uint16_t i = dataStart; i < dataEnd && i < SCAN_RESOLUTION; i++) {
         // Csak valós mért adatokat vesszük figyelembe
-        if (scanValueRSSI[i] < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-            avgRSSI += scanValueRSSI[i];
-            avgSNR += scanValueSNR[i];
+        if (scanData.isValid(i)) {
+            rssiSum += scanData.getRssi(i);
+            snrSum += scanData.getSnr(i);
             validSamples++;
         }
+        if (scanData.isMarked(i))
+            flags |= COLUMN_STATION;
+        if (scanData.isScaleLine(i))
+            flags |= COLUMN_SCALE;
 
-        // Állomás jelzés ellenőrzése
-        if (scanMark[i])
-            hasStation = true;
+        avgFreq += scanStartFreq + (uint32_t)(i * scanStep);
+    }
 
-        // Frekvencia számítás az adatponthoz
-        uint32_t freq = scanStartFreq + (uint32_t)(i * scanStep);
-        avgFreq += freq; // Skála vonalak ellenőrzése - dinamikus ritkítás zoom szint alapján
-        // MINDIG ellenőrizzük a skála vonalakat, függetlenül a mérési adatoktól
-        if (scanScaleLine[i] == 0) {
-            if (zoomLevel < 1.4f) {
-                // 1x zoom: minden 2 MHz-nél
-                if ((freq % 2000) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else if (zoomLevel < 2.5f) {
-                // 2x zoom: minden 1 MHz-nél
-                if ((freq % 1000) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else if (zoomLevel < 4.0f) {
-                // 3x zoom: minden 500 kHz-nél
-                if ((freq % 500) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else if (scanStep > 50) {
-                // Nagy zoom (4x+), de még nagy lépésköz: minden 200 kHz-nél
-                if ((freq % 200) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else {
-                // Nagyon nagy zoom: minden 100 kHz-nél
-                if ((freq % 100) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            }
+    SpectrumColumn &column = spectrumColumns[pixelX];
+    column.rssi = 0;
+    column.snr = 0;
+    if (validSamples > 0) {
+        column.rssi = rssiSum / validSamples;
+        column.snr = snrSum / validSamples;
+        flags |= COLUMN_HAS_DATA;
+    }
+
+    // Sáv határok ellenőrzése és jelölése
+    avgFreq /= (dataEnd - dataStart);
+    if (avgFreq > scanEndFreq || avgFreq < scanStartFreq) {
+        flags |= COLUMN_OUT_OF_BAND;
+        if (avgFreq > scanEndFreq && scanEndBand == SCAN_RESOLUTION) {
+            scanEndBand = dataStart;
+        }
+        if (avgFreq < scanStartFreq && scanBeginBand < (int16_t)dataStart) {
+            scanBeginBand = dataStart;
         }
-        if (scanScaleLine[i] == 2)
-            isMainScale = true;
     }
+    column.flags = flags;
+}
 
-    // Átlagok kiszámítása
-    if (validSamples > 0) {
-        avgRSSI /= validSamples;
-        avgSNR /= validSamples;
-    } else {
-        avgRSSI = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Nincs jel
-        avgSNR = 0;
+/**
+ * @brief A teljes oszlop cache újraépítése (zoom, reset, aktiválás után)
+ */
+void ScanScreen::rebuildSpectrumColumns() {
+    for (uint16_t x = 0; x < SCAN_AREA_WIDTH; x++) {
+        updateSpectrumColumn(x);
+    }
+}
+
+/**
+ * @brief Oszlop RSSI képernyő Y koordinátája (nincs adat: a spektrum alja)
+ */
+int16_t ScanScreen::columnToScreenY(const SpectrumColumn &column) const {
+    return (column.flags & COLUMN_HAS_DATA) ? rssiToScreenY(column.rssi) : SCAN_AREA_Y + SCAN_AREA_HEIGHT;
+}
+
+/**
+ * @brief Egy spektrum vonal kirajzolása
+ * @param pixelX A vízszintes pixel pozíció (0-SCAN_AREA_WIDTH)
+ *
+ * Ez a függvény felelős egy vertikális spektrum vonal kirajzolásáért az oszlop cache alapján
+ * (a mérési pontok átlagolása az updateSpectrumColumn()-ban történik):
+ * - SNR alapú színkódolás (kék->narancs->piros)
+ * - Skála vonalak (oliva háttér)
+ * - Állomás jelzők (zöld pontok)
+ * - Kurzor pozíció (piros vonal)
+ */
+void ScanScreen::drawSpectrumLine(uint16_t pixelX) {
+    if (pixelX >= SCAN_AREA_WIDTH)
+        return;
+
+    // Waterfall nézetben csak a head sor cellája változik
+    if (waterfallView) {
+        drawWaterfallCell(pixelX);
+        return;
     }
-    avgFreq /= (dataEnd - dataStart); // Színek meghatározása alapértelmezett értékekkel
+
+    uint16_t screenX = SCAN_AREA_X + pixelX;
+    const SpectrumColumn &column = spectrumColumns[pixelX];
+    bool isMainScale = column.flags & COLUMN_SCALE;
+
+    // Színek meghatározása alapértelmezett értékekkel
     uint16_t lineColor = TFT_NAVY;
     uint16_t bgColor = TFT_BLACK;
 
@@ -794,6 +1200,7 @@ void ScanScreen::drawSpectrumLine(uint16_t pixelX) {
     }
 
     // SNR alapú színkódolás a jel erősségének megjelenítéséhez
+    uint8_t avgSNR = column.snr;
     if (avgSNR > 0) {
         lineColor = TFT_NAVY;
         if (avgSNR < 16) {
@@ -811,77 +1218,193 @@ void ScanScreen::drawSpectrumLine(uint16_t pixelX) {
         }
     }
 
-    // Sáv határok ellenőrzése és jelölése
-    if (avgFreq > scanEndFreq || avgFreq < scanStartFreq) {
+    // Sáv határon kívüli oszlop
+    if (column.flags & COLUMN_OUT_OF_BAND) {
         lineColor = TFT_DARKGREY;
-        if (avgFreq > scanEndFreq && scanEndBand == SCAN_RESOLUTION) {
-            scanEndBand = dataStart;
-        }
-        if (avgFreq < scanStartFreq && scanBeginBand < (int16_t)dataStart) {
-            scanBeginBand = dataStart;
-        }
     }
 
-    // RSSI alapú spektrum háttér rajzolása
-    int16_t rssiY = avgRSSI;
+    // RSSI alapú spektrum háttér rajzolása (a teljes oszlopmagasságot lefedjük)
+    int16_t rssiY = columnToScreenY(column);
     if (rssiY >= SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
         // Nincs jel - használjuk a megfelelő háttérszínt (oliva vonalaknál TFT_OLIVE)
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, bgColor);
+        tft.drawFastVLine(screenX, SCAN_AREA_Y, SCAN_AREA_HEIGHT + 1, bgColor);
     } else {
         // Van mért jel, normál spektrum megjelenítés
-        if (rssiY < SCAN_AREA_Y + 10)
-            rssiY = SCAN_AREA_Y + 10;
-
-        tft.drawLine(screenX, rssiY + 1, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, lineColor);
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, rssiY - 1, bgColor);
-    }
-
-    // RSSI görbe rajzolása (simított) - az előző pixellel való összekötéshez
-    if (rssiY < SCAN_AREA_Y + SCAN_AREA_HEIGHT && pixelX > 0) {
-        // Előző pixel átlagolt RSSI értékének számítása
-        uint16_t prevDataStart = ((pixelX - 1) * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
-        uint16_t prevDataEnd = (pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
-
-        int16_t prevAvgRSSI = SCAN_AREA_Y + SCAN_AREA_HEIGHT;
-        int prevValidSamples = 0;
-        for (uint16_t i = prevDataStart; i < prevDataEnd && i < SCAN_RESOLUTION; i++) {
-            if (scanValueRSSI[i] < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-                prevAvgRSSI += scanValueRSSI[i];
-                prevValidSamples++;
+        tft.drawFastVLine(screenX, SCAN_AREA_Y, rssiY - SCAN_AREA_Y, bgColor);
+        tft.drawFastVLine(screenX, rssiY, SCAN_AREA_Y + SCAN_AREA_HEIGHT - rssiY + 1, lineColor);
+
+        // RSSI görbe rajzolása (simított) - az előző oszloppal való összekötéshez
+        if (pixelX > 0) {
+            int16_t prevRssiY = columnToScreenY(spectrumColumns[pixelX - 1]);
+            if (prevRssiY < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
+                tft.drawLine(screenX - 1, prevRssiY, screenX, rssiY, TFT_SILVER);
+            } else {
+                tft.drawPixel(screenX, rssiY, TFT_SILVER);
             }
         }
-        if (prevValidSamples > 0) {
-            prevAvgRSSI /= prevValidSamples;
-        }
-
-        // Simított vonal rajzolása az előző ponttal
-        if (prevAvgRSSI < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-            if (prevAvgRSSI < SCAN_AREA_Y + 10)
-                prevAvgRSSI = SCAN_AREA_Y + 10;
-            tft.drawLine(screenX - 1, prevAvgRSSI, screenX, rssiY, TFT_SILVER);
-        } else {
-            tft.drawPixel(screenX, rssiY, TFT_SILVER);
-        }
     }
 
     // Skála vonalak rajzolása - UTOLJÁRA, hogy mindig látszanak
     if (isMainScale) {
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + 15, TFT_OLIVE);
+        tft.drawFastVLine(screenX, SCAN_AREA_Y, 16, TFT_OLIVE);
     }
 
     // Aktuális kurzor pozíció jelzése (piros vonal)
     uint16_t currentPixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
     if (pixelX == currentPixelPos) {
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, TFT_RED);
+        tft.drawFastVLine(screenX, SCAN_AREA_Y, SCAN_AREA_HEIGHT + 1, TFT_RED);
     }
 
     // Állomás jelzők (zöld pontok)
-    if (hasStation) {
+    if (column.flags & COLUMN_STATION) {
         tft.drawPixel(screenX, SCAN_AREA_Y + 5, TFT_GREEN);
         tft.drawPixel(screenX, SCAN_AREA_Y + 10, TFT_GREEN);
     }
 }
 
+// ===================================================================
+// Waterfall nézet
+// ===================================================================
+
+/**
+ * @brief Váltás spektrum és waterfall nézet között
+ */
+void ScanScreen::toggleWaterfallView() {
+    if (!waterfall.isAvailable()) {
+        return;
+    }
+
+    waterfallView = !waterfallView;
+    if (viewButton) {
+        viewButton->setLabel(waterfallView ? "Spectr" : "Wfall");
+    }
+
+    drawSpectrum();
+    drawBandBoundaries();
+}
+
+/**
+ * @brief Egy waterfall sor magassága pixelben
+ */
+uint16_t ScanScreen::getWaterfallRowHeight() const {
+    uint16_t lines = waterfall.getLineCount();
+    return lines > 0 ? SCAN_AREA_HEIGHT / lines : SCAN_AREA_HEIGHT;
+}
+
+/**
+ * @brief Teljes waterfall kirajzolása (nézetváltáskor, zoom után)
+ *
+ * A sorok a gyűrűpuffer rögzített helyén jelennek meg, az írási pozíció körbeforog: a head sor (még nem mért
+ * része sötétszürke) alatt a legrégebbi, felette a legújabb lezárt sweep látszik. A panelen ebben az irányban
+ * nincs hardveres görgetés, így sweep végén csak két sor rajzolódik újra a teljes terület helyett.
+ */
+void ScanScreen::drawWaterfall() {
+    uint16_t rowHeight = getWaterfallRowHeight();
+    uint16_t lines = waterfall.getLineCount();
+
+    for (uint16_t line = 0; line < lines; line++) {
+        drawWaterfallRow(line);
+    }
+
+    // A sorok alatti maradék terület törlése
+    uint16_t usedHeight = lines * rowHeight;
+    if (usedHeight < SCAN_AREA_HEIGHT) {
+        tft.fillRect(SCAN_AREA_X, SCAN_AREA_Y + usedHeight, SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT - usedHeight, TFT_COLOR_BACKGROUND);
+    }
+}
+
+/**
+ * @brief Egy waterfall sor kirajzolása, azonos színű szakaszok összevonásával
+ * @param line A gyűrűpuffer sor indexe (egyben a képernyő sor is)
+ */
+void ScanScreen::drawWaterfallRow(uint16_t line) {
+    uint16_t rowHeight = getWaterfallRowHeight();
+    int16_t y = SCAN_AREA_Y + line * rowHeight;
+
+    uint16_t runStart = 0;
+    uint16_t runColor = getWaterfallCellColor(line, 0);
+    for (uint16_t x = 1; x <= SCAN_AREA_WIDTH; x++) {
+        uint16_t color = x < SCAN_AREA_WIDTH ? getWaterfallCellColor(line, x) : ~runColor;
+        if (color != runColor) {
+            tft.fillRect(SCAN_AREA_X + runStart, y, x - runStart, rowHeight, runColor);
+            runStart = x;
+            runColor = color;
+        }
+    }
+}
+
+/**
+ * @brief A head sor egy cellájának kirajzolása (sweep közben és kurzor mozgatáskor)
+ */
+void ScanScreen::drawWaterfallCell(uint16_t pixelX) {
+    uint16_t line = waterfall.getHeadLine();
+    uint16_t rowHeight = getWaterfallRowHeight();
+    tft.fillRect(SCAN_AREA_X + pixelX, SCAN_AREA_Y + line * rowHeight, 1, rowHeight, getWaterfallCellColor(line, pixelX));
+}
+
+/**
+ * @brief Egy waterfall cella színe
+ * @param line Gyűrűpuffer sor
+ * @param pixelX Képernyő oszlop (az aktuális scan tartományban)
+ *
+ * - Head sor: a már beírt oszlopok szint színe, a még nem mért rész sötétszürke, a kurzor piros
+ * - Előzmény sor: az oszlop frekvenciáját (positionToFreq) a sor saját tartományára képezzük le,
+ *   így zoom után is a helyes adat látszik; tartományon kívül háttér
+ */
+uint16_t ScanScreen::getWaterfallCellColor(uint16_t line, uint16_t pixelX) {
+    if (line == waterfall.getHeadLine()) {
+        if (pixelX == (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION) {
+            return TFT_RED;
+        }
+        return pixelX < waterfallFillX ? ScanWaterfall::levelToColor(waterfall.getLevel(line, pixelX)) : TFT_DARKGREY;
+    }
+
+    const ScanWaterfall::LineInfo &info = waterfall.getLineInfo(line);
+    if (info.endFreq <= info.startFreq) {
+        return TFT_COLOR_BACKGROUND; // Még nincs adat ebben a sorban
+    }
+
+    uint32_t freq = positionToFreq((pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH);
+    if (freq < info.startFreq || freq > info.endFreq) {
+        return TFT_COLOR_BACKGROUND;
+    }
+
+    uint32_t srcX = (uint32_t)(freq - info.startFreq) * SCAN_AREA_WIDTH / (info.endFreq - info.startFreq);
+    if (srcX >= SCAN_AREA_WIDTH) {
+        srcX = SCAN_AREA_WIDTH - 1;
+    }
+    return ScanWaterfall::levelToColor(waterfall.getLevel(line, srcX));
+}
+
+/**
+ * @brief Skála vonal jelzők kiszámítása az aktuális tartományhoz és zoom szinthez
+ *
+ * A ritkítás zoom szint függő: 1x: 2 MHz, 2x: 1 MHz, 3x: 500 kHz, 4x+: 200 kHz, nagyon nagy zoom: 100 kHz.
+ * Tartomány vagy zoom váltáskor egyszer fut le, így rajzoláskor már csak a jelzőt kell olvasni.
+ */
+void ScanScreen::updateScaleLines() {
+    uint32_t scaleDivider;
+    if (zoomLevel < 1.4f) {
+        scaleDivider = 2000;
+    } else if (zoomLevel < 2.5f) {
+        scaleDivider = 1000;
+    } else if (zoomLevel < 4.0f) {
+        scaleDivider = 500;
+    } else if (scanStep > 50) {
+        scaleDivider = 200;
+    } else {
+        scaleDivider = 100;
+    }
+
+    scanData.clearScaleLines();
+    for (uint16_t i = 0; i < SCAN_RESOLUTION; i++) {
+        uint32_t freq = scanStartFreq + (uint32_t)(i * scanStep);
+        if ((freq % scaleDivider) < scanStep) {
+            scanData.setScaleLine(i, true);
+        }
+    }
+}
+
 /**
  * @brief Frekvencia skála vonal rajzolása
  *
@@ -938,6 +1461,11 @@ void ScanScreen::drawFrequencyLabels() {
 }
 
 void ScanScreen::drawBandBoundaries() {
+    // Waterfall nézetben a feliratok eltakarnák az előzményeket
+    if (waterfallView) {
+        return;
+    }
+
     tft.setTextColor(TFT_YELLOW, TFT_BLACK);
     tft.setFreeFont();
     tft.setTextSize(1);
@@ -978,6 +1506,8 @@ void ScanScreen::drawScanInfoStatic() {
     tft.drawString("x", 70, INFO_AREA_Y + 15); // x egység fix helyen
 
     tft.drawString("Status: ", 170, INFO_AREA_Y);
+    tft.drawString("Rate: ", 170, INFO_AREA_Y + 15);
+    tft.drawString("pt/s", 250, INFO_AREA_Y + 15); // pont/s egység fix helyen
 
     // Statikus címkék a jel információkhoz
     tft.drawString("RSSI: ", 330, INFO_AREA_Y);
@@ -1023,17 +1553,17 @@ void ScanScreen::drawScanInfo() {
         lastStatusText = statusText; // Cache frissítése
     }
 
-    // RSSI érték - csak az érték részét frissítjük
-    int16_t rssi;
-    uint8_t snr;
-    getSignalQuality(rssi, snr);
-    int16_t rssiValue = (SCAN_AREA_Y + SCAN_AREA_HEIGHT - rssi) / signalScale;
-    String rssiText = String(rssiValue);
+    // Sweep áteresztőképesség
+    tft.fillRect(220, INFO_AREA_Y + 15, 25, FONT_HEIGHT, TFT_COLOR_BACKGROUND); // Régi érték törlése
+    tft.drawString(String(sweepPointsPerSecond), 220, INFO_AREA_Y + 15);
+
+    // RSSI érték - az utolsó mérés (sweep vagy kurzor) alapján, itt nem olvasunk a chipről
+    String rssiText = String(lastRssi);
     tft.fillRect(365, INFO_AREA_Y, 15, FONT_HEIGHT, TFT_COLOR_BACKGROUND); // Régi érték törlése
     tft.drawString(rssiText, 365, INFO_AREA_Y);
 
     // SNR érték - csak az érték részét frissítjük
-    String snrText = String(snr);
+    String snrText = String(lastSnr);
     tft.setTextColor(TFT_ORANGE, TFT_COLOR_BACKGROUND);
     tft.fillRect(365, INFO_AREA_Y + 15, 15, FONT_HEIGHT, TFT_COLOR_BACKGROUND); // Régi érték törlése
     tft.drawString(snrText, 365, INFO_AREA_Y + 15);
@@ -1044,9 +1574,9 @@ void ScanScreen::drawScanInfo() {
 // ===================================================================
 
 // Közös jel mérés - egyszerre RSSI és SNR
-void ScanScreen::getSignalQuality(int16_t &rssiY, uint8_t &snr) {
+void ScanScreen::getSignalQuality(uint8_t &rssi, uint8_t &snr) {
     if (!pSi4735Manager) {
-        rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - 20;
+        rssi = 0;
         snr = 0;
         return;
     }
@@ -1062,27 +1592,61 @@ void ScanScreen::getSignalQuality(int16_t &rssiY, uint8_t &snr) {
         snrSum += signalQuality.snr;
     }
 
-    // RSSI átlag és Y koordinátára konvertálás
-    int avgRssi = rssiSum / countScanSignal;
-    rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - (avgRssi * signalScale * 2);
+    // RSSI és SNR átlag
+    rssi = rssiSum / countScanSignal;
+    snr = snrSum / countScanSignal;
+}
+
+/**
+ * @brief RSSI (dBuV) konvertálása a spektrum terület Y koordinátájára
+ * @param rssi Átlagolt RSSI érték
+ * @return Korlátozott képernyő Y koordináta
+ */
+int16_t ScanScreen::rssiToScreenY(int rssi) const {
+    int16_t rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - (rssi * signalScale * 2);
 
     // RSSI korlátozás
     if (rssiY < SCAN_AREA_Y + 10)
         rssiY = SCAN_AREA_Y + 10;
     if (rssiY > SCAN_AREA_Y + SCAN_AREA_HEIGHT - 10)
-        rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - 10; // SNR átlag
-    snr = snrSum / countScanSignal;
+        rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - 10;
+    return rssiY;
+}
+
+/**
+ * @brief Kurzor pozíció jelének frissítése az info panelhez
+ * @details Ha van érvényes mért adat a pozíción, azt használjuk (egyezik a spektrummal),
+ * különben élő mérést végzünk az aktuális frekvencián.
+ */
+void ScanScreen::readCursorSignal() {
+    if (isDataValid(currentScanPos)) {
+        lastRssi = scanData.getRssi(currentScanPos);
+        lastSnr = scanData.getSnr(currentScanPos);
+    } else {
+        getSignalQuality(lastRssi, lastSnr);
+    }
 }
 
+/**
+ * @brief Frekvencia beállítása kurzor mozgatáskor (pause állapotban)
+ * @details A ráhangolódást a library setFrequency() saját várakozása biztosítja.
+ */
 void ScanScreen::setFrequency(uint32_t freq) {
     currentScanFreq = freq;
-    // Spektrum analizátor hangol át minden frekvenciára a méréshez!
     if (pSi4735Manager) {
         // frekvencia beállítás a Si4735 chipen
         pSi4735Manager->getSi4735().setFrequency(freq / 10); // Si4735 10kHz egységekben dolgozik
+    }
+}
 
-        // Kis várakozás a ráhangolódáshoz (stabilizálódás)
-        delay(5); // 5ms várakozás
+/**
+ * @brief Frekvencia beállítása a sweep állapotgépből - várakozás nélkül
+ * @details A settle időt az állapotgép Settle fázisa kezeli minimális határidővel és STC pollinggal (startScan() kikapcsolja a library várakozását).
+ */
+void ScanScreen::tuneFrequency(uint32_t freq) {
+    currentScanFreq = freq;
+    if (pSi4735Manager) {
+        pSi4735Manager->getSi4735().setFrequency(freq / 10); // Si4735 10kHz egységekben dolgozik
     }
 }
 
@@ -1226,63 +1790,8 @@ void ScanScreen::handleZoom(float newZoomLevel) {
     }
     if (canReuseData) {
 
-        // BIZTONSÁGOS MEGKÖZELÍTÉS: In-place adatmozgatás batch-enként
-        // Először létrehozunk egy "mapping" tömböt, ami megmondja, melyik régi index melyik új indexre kerül        // Határozunk fel egy kis buffer-t (csak 10 elem)
-        const int BUFFER_SIZE = 10;
-        uint8_t bufferRSSI[BUFFER_SIZE];
-        uint8_t bufferSNR[BUFFER_SIZE];
-        bool bufferMark[BUFFER_SIZE];
-        bool bufferValid[BUFFER_SIZE]; // Új buffer az érvényességi adatoknak
-
-        // Először jelöljük meg, mely pozíciók tartalmazzanak érvényes adatokat
-        // és végezzük el a másolást batch-enként
-
-        for (int targetStart = 0; targetStart < SCAN_RESOLUTION; targetStart += BUFFER_SIZE) {
-            int targetEnd = min(targetStart + BUFFER_SIZE, SCAN_RESOLUTION);
-
-            // Buffer feltöltése az új pozíciókra szánt adatokkal
-            for (int t = targetStart; t < targetEnd; t++) {
-                int bufferIndex = t - targetStart;
-                uint32_t targetFreq = scanStartFreq + (uint32_t)(t * scanStep); // Alapértelmezett értékek
-                bufferRSSI[bufferIndex] = SCAN_AREA_Y + SCAN_AREA_HEIGHT;
-                bufferSNR[bufferIndex] = 0;
-                bufferMark[bufferIndex] = false;
-                bufferValid[bufferIndex] = false; // Alapból nincs érvényes adat                // Keressük meg a régi pozíciót
-                if (targetFreq >= oldScanStartFreq && targetFreq <= oldScanEndFreq) {
-                    // Pontosabb mapping: nem csak kerekítünk, hanem ellenőrizzük a frekvencia távolságokat is
-                    float oldPosFloat = (float)(targetFreq - oldScanStartFreq) / oldScanStep;
-                    int oldPos = (int)(oldPosFloat + 0.5f); // Kerekítés
-
-                    // Dupla ellenőrzés: az oldPos pozíció frekvenciája közel van-e a target frekvenciához?
-                    if (oldPos >= 0 && oldPos < SCAN_RESOLUTION) {
-                        uint32_t oldPosFreq = oldScanStartFreq + (uint32_t)(oldPos * oldScanStep);
-                        uint32_t freqDiff = (targetFreq > oldPosFreq) ? (targetFreq - oldPosFreq) : (oldPosFreq - targetFreq);
-
-                        // Csak akkor másoljuk, ha a frekvencia különbség kisebb mint a régi lépésköz fele
-                        // Ez megakadályozza a "szellem adók" kialakulását
-                        if (freqDiff <= (oldScanStep / 2)) {
-                            bufferRSSI[bufferIndex] = scanValueRSSI[oldPos];
-                            bufferSNR[bufferIndex] = scanValueSNR[oldPos];
-                            bufferMark[bufferIndex] = scanMark[oldPos];
-                            bufferValid[bufferIndex] =
-                                scanDataValid[oldPos]; // Érvényességi adat másolása                            // Csak első néhány elemhez logolunk optimalizálás céljából
-                            if (t < 5) {
-                            }
-                        } else { // Túl nagy a frekvencia eltérés - szellem adó elkerülése
-                            if (t < 5) {
-                            }
-                        }
-                    }
-                }
-            } // Buffer tartalom visszamásolása
-            for (int t = targetStart; t < targetEnd; t++) {
-                int bufferIndex = t - targetStart;
-                scanValueRSSI[t] = bufferRSSI[bufferIndex];
-                scanValueSNR[t] = bufferSNR[bufferIndex];
-                scanMark[t] = bufferMark[bufferIndex];
-                scanDataValid[t] = bufferValid[bufferIndex]; // Érvényességi adat visszamásolása
-            }
-        }
+        // Helyben végzett, monoton leképezésű újramintavételezés (segédtömb nélkül)
+        scanData.resampleInPlace(oldScanStartFreq, oldScanStep, scanStartFreq, scanStep);
         scanEmpty = false;
         zoomGeneration++; // Növeljük a generáció számot
 
@@ -1291,17 +1800,19 @@ void ScanScreen::handleZoom(float newZoomLevel) {
 
         // Közös inicializálás
         currentScanPos = 0;
+        resetSweepStateMachine();
 
         // Skála vonalak újraszámítása (mindig szükséges zoom után)
-        for (int i = 0; i < SCAN_RESOLUTION; i++) {
-            scanScaleLine[i] = 0;
-        }
+        updateScaleLines();
 
         // Sáv határok újraszámítása
         scanBeginBand = -1;
         scanEndBand = SCAN_RESOLUTION;
 
         // CSAK a meglévő adatok újrarajzolása - NE töröljük a spektrumot!
+        rebuildSpectrumColumns();
+        waterfall.restartLine(scanStartFreq, scanEndFreq); // Az előzmény sorok a saját tartományukkal leképezve maradnak
+        waterfallFillX = 0;
         drawSpectrum(); // Ez a meglévő adatokat rajzolja ki
         drawScale();
         drawFrequencyLabels();
@@ -1314,29 +1825,26 @@ void ScanScreen::handleZoom(float newZoomLevel) {
         // Ha nem lehet újrafelhasználni, törölni kell az adatokat
 
         scanEmpty = true;
-        for (int i = 0; i < SCAN_RESOLUTION; i++) {
-            scanValueRSSI[i] = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Spektrum alján kezdjük (nincs látható jel)
-            scanValueSNR[i] = 0;
-            scanMark[i] = false;
-            scanDataValid[i] = false; // Nincs érvényes adat zoom out után
-        }
+        scanData.clear(); // Nincs érvényes adat zoom out után
 
         // Zoom generáció nullázása - friss adatok
         zoomGeneration = 0;
 
         // Közös inicializálás
         currentScanPos = 0;
+        resetSweepStateMachine();
 
         // Skála vonalak újraszámítása (mindig szükséges zoom után)
-        for (int i = 0; i < SCAN_RESOLUTION; i++) {
-            scanScaleLine[i] = 0;
-        }
+        updateScaleLines();
 
         // Sáv határok újraszámítása
         scanBeginBand = -1;
         scanEndBand = SCAN_RESOLUTION;
 
         // Spektrum és címkék frissítése (üres spektrum)
+        rebuildSpectrumColumns();
+        waterfall.restartLine(scanStartFreq, scanEndFreq); // Az előzmény sorok a saját tartományukkal leképezve maradnak
+        waterfallFillX = 0;
         drawSpectrum();
         drawScale();
         drawFrequencyLabels();
@@ -1345,6 +1853,27 @@ void ScanScreen::handleZoom(float newZoomLevel) {
     }
 }
 
+/**
+ * @brief Scan frekvencia igazítása a sáv csatorna rácsára
+ * @details A rács a lépésköz többszörösei (pl. MW: 9 kHz, 531..1602; FM: 100 kHz). A sáv minimumFreq-je nem mindig
+ * esik a rácsra (MW: 514), ezért nem onnan számolunk; a kézi hangolás (a currFreq-ről lépve) ugyanezt a rácsot adja.
+ * A rács a sáv határain belül marad.
+ * @param scanFreq Frekvencia scan egységben (sáv egység * 10)
+ * @return Csatorna frekvencia sáv egységben
+ */
+uint16_t ScanScreen::snapToChannel(uint32_t scanFreq) {
+    const BandTable &currentBand = pSi4735Manager->getCurrentBand();
+    uint32_t step = currentBand.currStep > 0 ? currentBand.currStep : 1;
+
+    uint32_t channel = ((scanFreq + step * 5) / (step * 10)) * step; // Legközelebbi rácspont
+    if (channel < currentBand.minimumFreq) {
+        channel += step;
+    } else if (channel > currentBand.maximumFreq) {
+        channel -= step;
+    }
+    return (uint16_t)channel;
+}
+
 uint32_t ScanScreen::positionToFreq(uint16_t dataPos) {
     if (dataPos >= SCAN_RESOLUTION)
         return scanEndFreq;
@@ -1377,5 +1906,5 @@ bool ScanScreen::isDataValid(uint16_t scanPos) const {
     }
 
     // Ellenőrizzük, hogy a pozícióban van-e érvényes mérési adat
-    return scanDataValid[scanPos];
+    return scanData.isValid(scanPos);
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file ScanSnapshotStore.cpp
+ * @brief Spektrum scan snapshot tárolók implementáció
+ */
+
+#include "ScanSnapshotStore.h"
+
+// Globális példányok definíciója
+ScanSnapshotCache scanSnapshotCache;
+#ifdef SCAN_SNAPSHOT_PERSIST
+ScanSnapshotStore scanSnapshotStore;
+#endif
+
+// ===================================================================
+// ScanSnapshotCache
+// ===================================================================
+
+/**
+ * @brief Konstruktor - minden slot üres
+ */
+ScanSnapshotCache::ScanSnapshotCache() : useCounter(0) {
+    for (uint8_t i = 0; i < SCAN_SNAPSHOT_SLOTS; i++) {
+        slots[i].used = false;
+    }
+}
+
+/**
+ * @brief A sávhoz tartozó foglalt slot keresése
+ */
+ScanSnapshot *ScanSnapshotCache::findSlot(uint8_t bandIndex) {
+    for (uint8_t i = 0; i < SCAN_SNAPSHOT_SLOTS; i++) {
+        if (slots[i].used && slots[i].data.bandIndex == bandIndex) {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Slot foglalása: a sáv meglévő slotja, egy üres slot, vagy a legrégebben használt
+ */
+ScanSnapshot *ScanSnapshotCache::allocateSlot(uint8_t bandIndex) {
+    ScanSnapshot *slot = findSlot(bandIndex);
+    if (slot) {
+        return slot;
+    }
+
+    slot = &slots[0];
+    for (uint8_t i = 0; i < SCAN_SNAPSHOT_SLOTS; i++) {
+        if (!slots[i].used) {
+            return &slots[i];
+        }
+        if (slots[i].lastUsed < slot->lastUsed) {
+            slot = &slots[i];
+        }
+    }
+    DEBUG("ScanSnapshotCache: band %u snapshot felülírva\n", slot->data.bandIndex);
+    return slot;
+}
+
+/**
+ * @brief Snapshot mentése
+ */
+void ScanSnapshotCache::store(uint8_t bandIndex, uint32_t startFreq, uint32_t endFreq, float zoomLevel, uint8_t zoomGeneration, const ScanBuffer &data) {
+    ScanSnapshot *slot = allocateSlot(bandIndex);
+    slot->used = true;
+    slot->lastUsed = ++useCounter;
+    slot->data.bandIndex = bandIndex;
+    slot->data.zoomGeneration = zoomGeneration;
+    slot->data.startFreq = startFreq;
+    slot->data.endFreq = endFreq;
+    slot->data.zoomLevel = zoomLevel;
+    pack(data, slot->data);
+}
+
+/**
+ * @brief A sáv snapshot-ja
+ */
+const ScanSnapshot *ScanSnapshotCache::find(uint8_t bandIndex) {
+    ScanSnapshot *slot = findSlot(bandIndex);
+
+#ifdef SCAN_SNAPSHOT_PERSIST
+    // Újraindítás után a RAM még üres: az EEPROM-ból töltjük
+    if (!slot && scanSnapshotStore.matches(bandIndex)) {
+        slot = allocateSlot(bandIndex);
+        slot->used = true;
+        slot->data = scanSnapshotStore.data;
+        DEBUG("ScanSnapshotCache: band %u snapshot visszaállítva az EEPROM-ból\n", bandIndex);
+    }
+#endif
+
+    if (slot) {
+        slot->lastUsed = ++useCounter;
+    }
+    return slot;
+}
+
+/**
+ * @brief A sáv snapshot-jának átadása az EEPROM store-nak
+ */
+void ScanSnapshotCache::persist(uint8_t bandIndex) {
+#ifdef SCAN_SNAPSHOT_PERSIST
+    ScanSnapshot *slot = findSlot(bandIndex);
+    if (slot) {
+        scanSnapshotStore.data = slot->data;
+    }
+#else
+    (void)bandIndex;
+#endif
+}
+
+/**
+ * @brief A sáv snapshot-jának törlése
+ */
+void ScanSnapshotCache::invalidate(uint8_t bandIndex) {
+    ScanSnapshot *slot = findSlot(bandIndex);
+    if (slot) {
+        slot->used = false;
+    }
+#ifdef SCAN_SNAPSHOT_PERSIST
+    scanSnapshotStore.invalidate(bandIndex);
+#endif
+}
+
+/**
+ * @brief Scan adatok tömörítése
+ * @details Két szomszédos pontból az érvényes és erősebb marad meg (a csúcsok nem vesznek el).
+ */
+void ScanSnapshotCache::pack(const ScanBuffer &src, ScanSnapshotData_t &dst) {
+    for (uint16_t i = 0; i < SCAN_SNAPSHOT_POINTS; i++) {
+        uint16_t pos = i * 2;
+        if (!src.isValid(pos) || (src.isValid(pos + 1) && src.getRssi(pos + 1) > src.getRssi(pos))) {
+            pos++;
+        }
+
+        if (!src.isValid(pos)) {
+            dst.rssi[i] = 0;
+            dst.snr[i] = SCAN_SNAPSHOT_INVALID_SNR;
+            continue;
+        }
+
+        uint8_t rssi = src.getRssi(pos) & ~SCAN_SNAPSHOT_MARK_BIT;
+        bool mark = src.isMarked(i * 2) || src.isMarked(i * 2 + 1);
+        dst.rssi[i] = rssi | (mark ? SCAN_SNAPSHOT_MARK_BIT : 0);
+        dst.snr[i] = src.getSnr(pos) < SCAN_SNAPSHOT_INVALID_SNR ? src.getSnr(pos) : SCAN_SNAPSHOT_INVALID_SNR - 1;
+    }
+}
+
+/**
+ * @brief Tömörített adatok kibontása
+ */
+void ScanSnapshotCache::unpack(const ScanSnapshotData_t &src, ScanBuffer &dst) {
+    dst.clear();
+    for (uint16_t i = 0; i < SCAN_SNAPSHOT_POINTS; i++) {
+        if (src.snr[i] == SCAN_SNAPSHOT_INVALID_SNR) {
+            continue;
+        }
+        uint8_t rssi = src.rssi[i] & ~SCAN_SNAPSHOT_MARK_BIT;
+        bool mark = src.rssi[i] & SCAN_SNAPSHOT_MARK_BIT;
+        for (uint16_t pos = i * 2; pos < i * 2 + 2; pos++) {
+            dst.set(pos, rssi, src.snr[i]);
+            dst.setMark(pos, mark);
+        }
+    }
+}
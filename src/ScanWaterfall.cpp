@@ -0,0 +1,121 @@
+/**
+ * @file ScanWaterfall.cpp
+ * @brief Spektrum scan waterfall előzmény gyűrűpuffer implementáció
+ */
+
+#include "ScanWaterfall.h"
+#include "defines.h"
+
+#include <new>
+
+namespace {
+// Szint -> RGB565 színtábla (fekete -> kék -> cián -> zöld -> sárga -> piros)
+const uint16_t WATERFALL_PALETTE[ScanWaterfall::LEVELS] = {
+    0x0000, 0x0006, 0x000C, 0x0013, 0x001F, 0x03FF, 0x05FF, 0x07FF, //
+    0x07F0, 0x07E0, 0x5FE0, 0xBFE0, 0xFFE0, 0xFD20, 0xFA00, 0xF800  //
+};
+} // namespace
+
+/**
+ * @brief Konstruktor - a memória keretből kiszámolja a tárolható sorok számát
+ */
+ScanWaterfall::ScanWaterfall(uint16_t width, uint16_t maxLines, size_t memoryBudget)
+    : width(width), bytesPerLine((width + 1) / 2), lineCount(0), headLine(0), data(nullptr), lineInfo(nullptr) {
+
+    size_t lines = memoryBudget / (bytesPerLine + sizeof(LineInfo));
+    if (lines > maxLines) {
+        lines = maxLines;
+    }
+    if (lines < 2) {
+        DEBUG("ScanWaterfall: túl kicsi memória keret (%u bájt)\n", memoryBudget);
+        return;
+    }
+
+    data = new (std::nothrow) uint8_t[lines * bytesPerLine];
+    lineInfo = new (std::nothrow) LineInfo[lines];
+    if (!data || !lineInfo) {
+        DEBUG("ScanWaterfall: memória foglalás sikertelen (%u sor)\n", lines);
+        delete[] data;
+        delete[] lineInfo;
+        data = nullptr;
+        lineInfo = nullptr;
+        return;
+    }
+
+    lineCount = lines;
+    clear();
+}
+
+/**
+ * @brief Destruktor
+ */
+ScanWaterfall::~ScanWaterfall() {
+    delete[] data;
+    delete[] lineInfo;
+}
+
+/**
+ * @brief Egy sor törlése (adat és tartomány)
+ */
+void ScanWaterfall::clearLine(uint16_t line) {
+    memset(data + line * bytesPerLine, 0, bytesPerLine);
+    lineInfo[line].startFreq = 0;
+    lineInfo[line].endFreq = 0;
+}
+
+/**
+ * @brief Az összes előzmény törlése
+ */
+void ScanWaterfall::clear() {
+    if (!isAvailable()) {
+        return;
+    }
+    for (uint16_t line = 0; line < lineCount; line++) {
+        clearLine(line);
+    }
+    headLine = 0;
+}
+
+/**
+ * @brief Az aktuális sor újrakezdése új tartománnyal (pl. zoom után)
+ */
+void ScanWaterfall::restartLine(uint32_t startFreq, uint32_t endFreq) {
+    if (!isAvailable()) {
+        return;
+    }
+    clearLine(headLine);
+    lineInfo[headLine].startFreq = startFreq;
+    lineInfo[headLine].endFreq = endFreq;
+}
+
+/**
+ * @brief Egy oszlop beírása az aktuális sorba
+ */
+void ScanWaterfall::setColumn(uint16_t x, uint8_t rssi) {
+    if (!isAvailable() || x >= width) {
+        return;
+    }
+    uint8_t level = rssiToLevel(rssi);
+    uint8_t &packed = data[headLine * bytesPerLine + (x >> 1)];
+    if (x & 1) {
+        packed = (packed & 0x0F) | (level << 4);
+    } else {
+        packed = (packed & 0xF0) | level;
+    }
+}
+
+/**
+ * @brief A kész sor lezárása és a head léptetése
+ */
+void ScanWaterfall::commitLine(uint32_t startFreq, uint32_t endFreq) {
+    if (!isAvailable()) {
+        return;
+    }
+    headLine = (headLine + 1) % lineCount;
+    restartLine(startFreq, endFreq);
+}
+
+/**
+ * @brief Szint színe
+ */
+uint16_t ScanWaterfall::levelToColor(uint8_t level) { return WATERFALL_PALETTE[level < LEVELS ? level : LEVELS - 1]; }
@@ -1,5 +1,6 @@
 #include "ScreenManager.h"
 #include "AMScreen.h"
+#include "AnalyzerScreen.h"
 #include "Band.h"
 #include "Config.h"
 #include "EmptyScreen.h"
@@ -22,6 +23,7 @@ void ScreenManager::registerDefaultScreenFactories() {
     registerScreenFactory(SCREEN_NAME_AM, [](TFT_eSPI &tft_param) { return std::make_shared<AMScreen>(tft_param, *si4735Manager); });
     registerScreenFactory(SCREEN_NAME_MEMORY, [](TFT_eSPI &tft_param) { return std::make_shared<MemoryScreen>(tft_param, *si4735Manager); });
     registerScreenFactory(SCREEN_NAME_SCAN, [](TFT_eSPI &tft_param) { return std::make_shared<ScanScreen>(tft_param, si4735Manager); });
+    registerScreenFactory(SCREEN_NAME_ANALYZER, [](TFT_eSPI &tft_param) { return std::make_shared<AnalyzerScreen>(tft_param, si4735Manager); });
     registerScreenFactory(SCREEN_NAME_SCREENSAVER,
                           [](TFT_eSPI &tft_param) { return std::make_shared<ScreenSaverScreen>(tft_param, *si4735Manager); }); // setup képernyők regisztrálása
     registerScreenFactory(SCREEN_NAME_SETUP, [](TFT_eSPI &tft_param) { return std::make_shared<SetupScreen>(tft_param); });
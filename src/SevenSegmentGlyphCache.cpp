@@ -0,0 +1,281 @@
+/**
+ * @file SevenSegmentGlyphCache.cpp
+ * @brief 7-szegmenses glyph atlasz implementáció
+ */
+
+#include "SevenSegmentGlyphCache.h"
+
+#include <algorithm>
+
+#include "TftDma.h"
+#include "defines.h"
+
+namespace {
+/**
+ * @brief Oszlop tartomány a területen belül ([from, to))
+ */
+struct ColumnSpan {
+    int16_t from;
+    int16_t to;
+};
+
+/**
+ * @brief RGB565 szín a sprite pufferek bájtsorrendjében (a pushImage() bájtcsere nélkül tolja ki)
+ */
+inline uint16_t toBufferColor(uint16_t color) { return (color >> 8) | (color << 8); }
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+SevenSegmentGlyphCache::SevenSegmentGlyphCache(const GFXfont &font) : font(font), built(false), usable(false), descent(0), pushedPixels(0), fullDraws(0), partialDraws(0) {}
+
+/**
+ * @brief Az atlasz felépítése a font bitképéből
+ * @details A GFX bitkép soronként folytonos, MSB először: a (sor, oszlop) pixel a sor * width + oszlop. bit.
+ * Az alapvonal alatti rész (descent) a TFT_eSPI setFreeFont() számításával egyezik (a font összes glyph-jére),
+ * így az alapvonal ugyanoda kerül, mint a BR_DATUM-os drawString()-nél.
+ */
+void SevenSegmentGlyphCache::build() {
+    built = true;
+    usable = true;
+
+    descent = 0;
+    for (uint16_t c = 0; c < font.last - font.first; c++) {
+        const GFXglyph &glyph = font.glyph[c];
+        int16_t below = glyph.height + glyph.yOffset;
+        if (below > descent) {
+            descent = below;
+        }
+    }
+
+    for (uint8_t i = 0; i < MAX_GLYPHS; i++) {
+        char c = CHARSET[i];
+        Glyph &entry = glyphs[i];
+        memset(&entry, 0, sizeof(entry));
+
+        if (c < font.first || c > font.last) {
+            DEBUG("SevenSegmentGlyphCache: a '%c' karakter hiányzik a fontból\n", c);
+            usable = false;
+            continue;
+        }
+        const GFXglyph &glyph = font.glyph[c - font.first];
+        if (glyph.width > CHUNK_WIDTH || glyph.height > MAX_HEIGHT) {
+            DEBUG("SevenSegmentGlyphCache: a '%c' glyph túl nagy (%dx%d)\n", c, glyph.width, glyph.height);
+            usable = false;
+            continue;
+        }
+
+        entry.left = glyph.xOffset;
+        entry.width = glyph.width;
+        entry.top = glyph.yOffset;
+        entry.height = glyph.height;
+        entry.advance = glyph.xAdvance;
+
+        uint32_t bit = 0;
+        for (uint8_t row = 0; row < glyph.height; row++) {
+            uint32_t mask = 0;
+            for (uint8_t col = 0; col < glyph.width; col++, bit++) {
+                if (font.bitmap[glyph.bitmapOffset + (bit >> 3)] & (0x80 >> (bit & 7))) {
+                    mask |= 1UL << col;
+                }
+            }
+            entry.rows[row] = mask;
+        }
+    }
+}
+
+/**
+ * @brief A karakter indexe az atlaszban (-1: nincs benne)
+ */
+int8_t SevenSegmentGlyphCache::findGlyph(char c) {
+    for (uint8_t i = 0; i < MAX_GLYPHS; i++) {
+        if (CHARSET[i] == c) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Szöveg szélessége a TFT_eSPI textWidth() szabálya szerint (az utolsó karakternél a bitkép jobb széle)
+ */
+uint16_t SevenSegmentGlyphCache::textWidth(const char *text) const {
+    int16_t width = 0;
+    for (const char *p = text; *p; p++) {
+        const Glyph &glyph = glyphs[findGlyph(*p)];
+        width += p[1] ? glyph.advance : glyph.left + glyph.width;
+    }
+    return width;
+}
+
+/**
+ * @brief Jobbra igazított elrendezés: a glyph-ek bal széle a terület bal széléhez képest
+ * @return Az elhelyezések száma (= strlen(text))
+ */
+uint8_t SevenSegmentGlyphCache::layout(const char *text, uint16_t areaWidth, Placement *placements) const {
+    int16_t cursor = areaWidth - textWidth(text);
+    uint8_t count = 0;
+    for (const char *p = text; *p; p++) {
+        uint8_t index = findGlyph(*p);
+        placements[count].x = cursor + glyphs[index].left;
+        placements[count].glyph = index;
+        count++;
+        cursor += glyphs[index].advance;
+    }
+    return count;
+}
+
+/**
+ * @brief Egy réteg (maszk vagy szöveg) pixeleinek összegyűjtése egy oszlopcsíkba
+ * @param layerRows Soronkénti bitek (0. bit = chunkX oszlop); a hívó nullázza
+ */
+void SevenSegmentGlyphCache::composeLayer(uint32_t *layerRows, const Placement *placements, uint8_t count, int16_t chunkX, uint8_t chunkWidth, int16_t baseline) const {
+    for (uint8_t i = 0; i < count; i++) {
+        const Glyph &glyph = glyphs[placements[i].glyph];
+        int16_t shift = placements[i].x - chunkX;
+        if (shift >= chunkWidth || shift + glyph.width <= 0) {
+            continue;
+        }
+
+        for (uint8_t row = 0; row < glyph.height; row++) {
+            int16_t y = baseline + glyph.top + row;
+            if (y < 0 || y >= MAX_HEIGHT) {
+                continue;
+            }
+            layerRows[y] |= shift >= 0 ? glyph.rows[row] << shift : glyph.rows[row] >> -shift;
+        }
+    }
+}
+
+/**
+ * @brief A terület [from, to) oszlopainak összeállítása és kitolása legfeljebb CHUNK_WIDTH széles csíkokban
+ * @details A csíkok a TftDma váltakozó staging puffereibe állnak össze: a következő csík összeállítása alatt
+ * az előző már a DMA-val megy ki.
+ */
+void SevenSegmentGlyphCache::pushColumns(const Frame &frame, const Placement *maskPlacements, uint8_t maskCount, const Placement *textPlacements, uint8_t textCount,
+                                         int16_t from, int16_t to) {
+    const int16_t baseline = frame.height - descent;
+    const uint16_t background = toBufferColor(frame.colors.background);
+    const uint16_t inactive = toBufferColor(frame.colors.inactive);
+    const uint16_t active = toBufferColor(frame.colors.active);
+
+    for (int16_t chunkX = from; chunkX < to; chunkX += CHUNK_WIDTH) {
+        uint8_t chunkWidth = std::min<int16_t>(CHUNK_WIDTH, to - chunkX);
+
+        uint32_t maskRows[MAX_HEIGHT] = {0};
+        uint32_t textRows[MAX_HEIGHT] = {0};
+        if (frame.showMask) {
+            composeLayer(maskRows, maskPlacements, maskCount, chunkX, chunkWidth, baseline);
+        }
+        composeLayer(textRows, textPlacements, textCount, chunkX, chunkWidth, baseline);
+
+        uint16_t *pixel = tftDma.acquireBuffer();
+        for (uint8_t y = 0; y < frame.height; y++) {
+            for (uint8_t col = 0; col < chunkWidth; col++) {
+                *pixel++ = (textRows[y] >> col) & 1 ? active : ((maskRows[y] >> col) & 1 ? inactive : background);
+            }
+        }
+
+        tftDma.pushBuffer(frame.x + chunkX, frame.y, chunkWidth, frame.height);
+        pushedPixels += static_cast<uint32_t>(chunkWidth) * frame.height;
+    }
+}
+
+/**
+ * @brief Kirajzolás: teljes, vagy csak a megváltozott glyph-ek oszlopai
+ * @details Részleges rajzolás akkor lehet, ha a terület, a színek és a maszk az előző rajzolás óta nem változott.
+ * Ilyenkor azok a glyph-ek számítanak változásnak, amelyek (karakter és hely szerint) csak az egyik szövegben
+ * vannak meg; ezek oszlopai (az átlógó glyph-ek, pl. a '.' miatt a szomszédokkal együtt) újra összeállnak
+ * az összes érintett glyph-ből, így a kép pixelre ugyanaz, mint teljes rajzolásnál.
+ */
+bool SevenSegmentGlyphCache::draw(Frame &frame, int16_t x, int16_t y, uint16_t width, uint16_t height, const char *mask, const char *text, const Colors &colors,
+                                  bool showMask) {
+    if (!built) {
+        build();
+    }
+
+    size_t maskLength = strlen(mask);
+    size_t textLength = strlen(text);
+    bool supported = usable && height <= MAX_HEIGHT && maskLength <= MAX_TEXT_LENGTH && textLength <= MAX_TEXT_LENGTH;
+    for (const char *p = mask; supported && *p; p++) {
+        supported = findGlyph(*p) >= 0;
+    }
+    for (const char *p = text; supported && *p; p++) {
+        supported = findGlyph(*p) >= 0;
+    }
+    if (!supported) {
+        frame.invalidate();
+        return false;
+    }
+
+    bool partial = frame.valid && frame.x == x && frame.y == y && frame.width == width && frame.height == height && frame.showMask == showMask &&
+                   frame.colors.background == colors.background && frame.colors.inactive == colors.inactive && frame.colors.active == colors.active &&
+                   strcmp(frame.mask, mask) == 0;
+
+    Placement oldPlacements[MAX_TEXT_LENGTH];
+    uint8_t oldCount = partial ? layout(frame.text, width, oldPlacements) : 0;
+
+    frame.valid = true;
+    frame.x = x;
+    frame.y = y;
+    frame.width = width;
+    frame.height = height;
+    frame.colors = colors;
+    frame.showMask = showMask;
+    strcpy(frame.mask, mask);
+    strcpy(frame.text, text);
+
+    Placement maskPlacements[MAX_TEXT_LENGTH];
+    Placement textPlacements[MAX_TEXT_LENGTH];
+    uint8_t maskCount = layout(mask, width, maskPlacements);
+    uint8_t textCount = layout(text, width, textPlacements);
+
+    if (!partial) {
+        pushColumns(frame, maskPlacements, maskCount, textPlacements, textCount, 0, width);
+        fullDraws++;
+        return true;
+    }
+
+    // Változott glyph-ek oszlopai: ami csak a régi vagy csak az új szövegben van meg
+    ColumnSpan spans[MAX_TEXT_LENGTH * 2];
+    uint8_t spanCount = 0;
+    auto collect = [&](const Placement *placements, uint8_t count, const Placement *others, uint8_t otherCount) {
+        for (uint8_t i = 0; i < count; i++) {
+            bool found = false;
+            for (uint8_t j = 0; j < otherCount && !found; j++) {
+                found = others[j].x == placements[i].x && others[j].glyph == placements[i].glyph;
+            }
+            if (!found) {
+                spans[spanCount].from = std::max<int16_t>(placements[i].x, 0);
+                spans[spanCount].to = std::min<int16_t>(placements[i].x + glyphs[placements[i].glyph].width, width);
+                if (spans[spanCount].from < spans[spanCount].to) {
+                    spanCount++;
+                }
+            }
+        }
+    };
+    collect(oldPlacements, oldCount, textPlacements, textCount);
+    collect(textPlacements, textCount, oldPlacements, oldCount);
+
+    // Rendezés kezdőoszlop szerint, majd az átfedő/érintkező tartományok összevonása
+    for (uint8_t i = 1; i < spanCount; i++) {
+        ColumnSpan span = spans[i];
+        uint8_t j = i;
+        for (; j > 0 && spans[j - 1].from > span.from; j--) {
+            spans[j] = spans[j - 1];
+        }
+        spans[j] = span;
+    }
+    for (uint8_t i = 0; i < spanCount;) {
+        int16_t from = spans[i].from;
+        int16_t to = spans[i].to;
+        for (i++; i < spanCount && spans[i].from <= to; i++) {
+            to = std::max(to, spans[i].to);
+        }
+        pushColumns(frame, maskPlacements, maskCount, textPlacements, textCount, from, to);
+    }
+
+    partialDraws++;
+    return true;
+}
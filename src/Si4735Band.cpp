@@ -411,6 +411,20 @@ void Si4735Band::tuneMemoryStation(uint8_t bandIndex, uint16_t frequency, uint8_
     si4735.setVolume(config.data.currVolume);
 }
 
+/**
+ * @brief Az aktuális demodulációs módhoz tartozó sávszélesség index
+ * @return A config bwIdxFM/bwIdxAM/bwIdxSSB értéke, ugyanazzal a leképezéssel, ahogy a tuneMemoryStation() visszaállítja
+ */
+uint8_t Si4735Band::getCurrentBandwidthIndex() {
+    uint8_t demod = getCurrentBand().currDemod;
+    if (demod == FM_DEMOD_TYPE) {
+        return config.data.bwIdxFM;
+    } else if (demod == AM_DEMOD_TYPE) {
+        return config.data.bwIdxAM;
+    }
+    return config.data.bwIdxSSB; // LSB, USB, CW
+}
+
 /**
  * @brief A frekvencia léptetése a rotary encoder értéke alapján
  * @param rotaryValue A rotary encoder értéke (növelés/csökkentés)
@@ -1,5 +1,7 @@
 #include "Si4735Manager.h"
 
+#include "UIProfiler.h"
+
 /**
  * @brief Konstruktor, amely inicializálja a Si4735 eszközt.
  * @param config A konfigurációs objektum, amely tartalmazza a beállításokat.
@@ -36,6 +38,7 @@ void Si4735Manager::init(bool systemStart) {
  * Ez a függvény folyamatosan figyeli a squelch állapotát és kezeli a hardver némítást.
  */
 void Si4735Manager::loop() {
+    UI_PROFILE_SCOPE(Si4735Loop);
 
     // Squelch kezelése
     manageSquelch();
@@ -45,4 +48,88 @@ void Si4735Manager::loop() {
 
     // Signal quality cache frissítése, ha szükséges
     updateSignalCacheIfNeeded();
-}
\ No newline at end of file
+}
+// ===================================================================
+// Nem blokkoló seek
+// ===================================================================
+
+/**
+ * @brief Nem blokkoló seek indítása
+ */
+bool Si4735Manager::startSeek(bool seekUp) {
+    // A seek parancs SSB módban nem működik
+    if (seekActive || isCurrentDemodSSBorCW()) {
+        return false;
+    }
+
+    si4735.seekStation(seekUp ? SEEK_UP : SEEK_DOWN, 0); // Sávhatárnál megáll (nincs körbefordulás)
+
+    seekActive = true;
+    seekStartTime = millis();
+    lastSeekPoll = seekStartTime;
+    seekFrequency = si4735.getCurrentFrequency();
+
+    DEBUG("Si4735Manager::startSeek(%s) from %u\n", seekUp ? "up" : "down", seekFrequency);
+    return true;
+}
+
+/**
+ * @brief Az aktív seek állapotának lekérdezése
+ */
+Si4735Manager::SeekEvent Si4735Manager::pollSeek() {
+    if (!seekActive) {
+        return SeekEvent::None;
+    }
+
+    uint32_t now = millis();
+    if (now - lastSeekPoll < SEEK_POLL_INTERVAL_MS) {
+        return SeekEvent::None;
+    }
+    lastSeekPoll = now;
+
+    // Egyetlen tune status olvasás (INTACK és CANCEL nélkül, a seek fut tovább): frekvencia és STC/VALID/BLTF bitek
+    si4735.getStatus(0, 0);
+    uint16_t frequency = si4735.getStatusFrequency();
+
+    if (si4735.getTuneCompleteTriggered()) {
+        bool found = si4735.getStatusValid() && !si4735.getBandLimit();
+        si4735.getStatus(1, 0); // STC interrupt nyugtázása
+        finishSeek(frequency);
+        DEBUG("Si4735Manager::pollSeek() %s at %u (%lu ms)\n", found ? "found" : "band limit", frequency, now - seekStartTime);
+        return found ? SeekEvent::Found : SeekEvent::BandLimit;
+    }
+
+    if (now - seekStartTime >= SEEK_TIMEOUT_MS) {
+        si4735.getStatus(1, 1); // Seek megszakítása
+        finishSeek(si4735.getStatusFrequency());
+        DEBUG("Si4735Manager::pollSeek() timeout at %u\n", seekFrequency);
+        return SeekEvent::Timeout;
+    }
+
+    if (frequency != seekFrequency) {
+        seekFrequency = frequency;
+        return SeekEvent::Progress;
+    }
+    return SeekEvent::None;
+}
+
+/**
+ * @brief Az aktív seek megszakítása
+ */
+void Si4735Manager::cancelSeek() {
+    if (!seekActive) {
+        return;
+    }
+    si4735.getStatus(1, 1); // CANCEL + STC nyugtázás
+    finishSeek(si4735.getStatusFrequency());
+    DEBUG("Si4735Manager::cancelSeek() at %u\n", seekFrequency);
+}
+
+/**
+ * @brief Seek lezárása
+ */
+void Si4735Manager::finishSeek(uint16_t frequency) {
+    seekActive = false;
+    seekFrequency = frequency;
+    getCurrentBand().currFreq = frequency;
+}
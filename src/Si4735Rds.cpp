@@ -1,4 +1,7 @@
 #include "Si4735Rds.h"
+
+#include <algorithm>
+
 #include "Config.h"
 #include "StationData.h"
 
@@ -32,257 +35,237 @@
 // }
 
 /**
- * @brief Lekérdezi az RDS állomásnevet (Program Service)
- * @return String Az RDS állomásnév, vagy üres string ha nem elérhető
+ * @brief Ellenőrzi, hogy elérhető-e RDS adat
+ * @return true ha az utolsó lekérdezéskor szinkronizált RDS vétel volt
  */
-String Si4735Rds::getRdsStationName() {
+bool Si4735Rds::isRdsAvailable() {
 
     // Ellenőrizzük, hogy FM módban vagyunk-e
     if (!isCurrentBandFM()) {
-        return "";
-    }
-
-    // RDS státusz frissítése
-    si4735.getRdsStatus();
-
-    char *rdsStationName = si4735.getRdsText0A();
-    if (rdsStationName != nullptr && strlen(rdsStationName) > 0) {
-        char tempName[32];
-        strncpy(tempName, rdsStationName, sizeof(tempName) - 1);
-        tempName[sizeof(tempName) - 1] = '\0';
-        Utils::trimSpaces(tempName);
-        String result = String(tempName);
-        return result;
+        return false;
     }
 
-    return "";
+    return rdsSync;
 }
 
+// ===================================================================
+// RDS dekódolás és cache
+// ===================================================================
+
 /**
- * @brief Lekérdezi az RDS program típus kódot (PTY)
- * @return uint8_t Az RDS program típus kódja (0-31), vagy 255 ha nincs RDS
+ * @brief A Si4735 RDS FIFO ürítése a csoport gyűrűpufferbe
  */
-uint8_t Si4735Rds::getRdsProgramTypeCode() {
+void Si4735Rds::drainRdsFifo() {
 
     // Ellenőrizzük, hogy FM módban vagyunk-e
     if (!isCurrentBandFM()) {
-        return 255; // Nincs RDS
+        rdsSync = false;
+        return;
     }
 
-    // RDS státusz frissítése
-    si4735.getRdsStatus();
-
-    return si4735.getRdsProgramType();
+    uint32_t currentTime = millis();
+    if (currentTime - lastRdsFifoPoll < RDS_FIFO_POLL_INTERVAL_MS) {
+        return;
+    }
+    lastRdsFifoPoll = currentTime;
+    updateGroupRate(currentTime);
+
+    // Állapot lekérdezés (STATUSONLY) a megszakítás nyugtázásával: a FIFO-ból nem vesz ki, csak a telítettségét adja.
+    // Üres FIFO-nál a csoport olvasás az utolsó csoportot adná vissza újra, ezért csak annyit olvasunk, amennyi bent van.
+    si4735.getRdsStatus(1, 0, 1);
+    rdsSync = si4735.getRdsSync();
+    if (!rdsSync) {
+        return;
+    }
+    if (si4735.getGroupLost()) {
+        chipGroupsLost++;
+    }
+    uint8_t groupsQueued = std::min<uint8_t>(si4735.getNumRdsFifoUsed(), RDS_MAX_GROUPS_PER_DRAIN);
+
+    // Csoportonként egyetlen FM_RDS_STATUS tranzakció: a legrégebbi csoport blokkjai és hibaszintjei (kivéve a FIFO-ból)
+    for (uint8_t i = 0; i < groupsQueued; i++) {
+        si4735.getRdsStatus(1, 0, 0);
+
+        const si47x_rds_status &response = si4735.getRdsResponse();
+        RdsRawGroup group = {
+            {
+                static_cast<uint16_t>((response.resp.BLOCKAH << 8) | response.resp.BLOCKAL), //
+                static_cast<uint16_t>((response.resp.BLOCKBH << 8) | response.resp.BLOCKBL), //
+                static_cast<uint16_t>((response.resp.BLOCKCH << 8) | response.resp.BLOCKCL), //
+                static_cast<uint16_t>((response.resp.BLOCKDH << 8) | response.resp.BLOCKDL)  //
+            },
+            {response.resp.BLEA, response.resp.BLEB, response.resp.BLEC, response.resp.BLED} //
+        };
+        rdsGroupRing.push(group);
+        groupWindowCount++;
+    }
 }
 
 /**
- * @brief Lekérdezi az RDS radio text üzenetet
- * @return String Az RDS radio text, vagy üres string ha nem elérhető
+ * @brief Csoport/perc statisztika ablakának léptetése
  */
-String Si4735Rds::getRdsRadioText() {
-
-    // Ellenőrizzük, hogy FM módban vagyunk-e
-    if (!isCurrentBandFM()) {
-        return "";
+void Si4735Rds::updateGroupRate(uint32_t currentTime) {
+    uint32_t elapsed = currentTime - groupWindowStart;
+    if (elapsed < RDS_GROUP_RATE_WINDOW_MS) {
+        return;
     }
-
-    // RDS státusz frissítése
-    si4735.getRdsStatus();
-
-    char *rdsText = si4735.getRdsText2A();
-    if (rdsText != nullptr && strlen(rdsText) > 0) {
-        char tempText[128];
-        strncpy(tempText, rdsText, sizeof(tempText) - 1);
-        tempText[sizeof(tempText) - 1] = '\0';
-        Utils::trimSpaces(tempText);
-        String result = String(tempText);
-        return result;
+    groupsPerMinute = static_cast<uint16_t>(static_cast<uint32_t>(groupWindowCount) * RDS_GROUP_RATE_WINDOW_MS / elapsed);
+    if (groupWindowCount > 0) {
+        DEBUG("RDS: %u groups/min, lost: %lu\n", groupsPerMinute, getRdsLostGroups());
     }
-
-    return "";
+    groupWindowStart = currentTime;
+    groupWindowCount = 0;
 }
 
 /**
- * @brief Lekérdezi az RDS dátum és idő információt
- * @param year Referencia a év tárolásához
- * @param month Referencia a hónap tárolásához
- * @param day Referencia a nap tárolásához
- * @param hour Referencia az óra tárolásához
- * @param minute Referencia a perc tárolásához
- * @return true ha sikerült lekérdezni a dátum/idő adatokat
+ * @brief A gyűrűpufferben várakozó csoportok dekódolása, a cache frissítése
+ * @return true ha változtak a megjelenítendő adatok
  */
-bool Si4735Rds::getRdsDateTime(uint16_t &year, uint16_t &month, uint16_t &day, uint16_t &hour, uint16_t &minute) {
+bool Si4735Rds::updateRdsDataWithCache() {
 
     // Ellenőrizzük, hogy FM módban vagyunk-e
     if (!isCurrentBandFM()) {
         return false;
     }
 
-    // RDS státusz frissítése
-    si4735.getRdsStatus();
+    uint32_t currentTime = millis();
+    uint8_t decoderChanges = 0;
+    bool groupReceived = false;
 
-    return si4735.getRdsDateTime(&year, &month, &day, &hour, &minute);
-}
+    RdsRawGroup group;
+    while (rdsGroupRing.pop(group)) {
+        decoderChanges |= rdsDecoder.decodeGroup(group.blocks, group.errors);
+        groupReceived = true;
+    }
 
-/**
- * @brief Ellenőrzi, hogy elérhető-e RDS adat
- * @return true ha van érvényes RDS vétel
- */
-bool Si4735Rds::isRdsAvailable() {
+    bool dataChanged = updateCachedText(decoderChanges);
 
-    // Ellenőrizzük, hogy FM módban vagyunk-e
-    if (!isCurrentBandFM()) {
-        return false;
+    if (groupReceived) {
+        lastValidRdsData = currentTime;
     }
 
-    // RDS státusz lekérdezése
-    si4735.getRdsStatus();
+    // Hangolástól az első állomásnévig eltelt idő
+    if (timeToFirstPsMs == 0 && cachedStationName[0] != '\0') {
+        timeToFirstPsMs = currentTime - rdsCacheClearTime;
+        if (timeToFirstPsMs == 0) {
+            timeToFirstPsMs = 1;
+        }
+        DEBUG("RDS: first PS '%s' after %lu ms\n", cachedStationName, timeToFirstPsMs);
+    }
 
-    if (!si4735.getRdsReceived() or !si4735.getRdsSync() or !si4735.getRdsSyncFound()) {
-        return false;
+    // Timeout ellenőrzés - hosszú ideig nem érkezett csoport, a cache elavult
+    if (currentTime - lastValidRdsData > RDS_DATA_TIMEOUT && cachedStationName[0] != '\0') {
+        rdsDecoder.reset();
+        clearCachedText();
+        dataChanged = true;
     }
-    return true;
-}
 
-// ===================================================================
-// Adaptív cache és időzítési funkcionalitás
-// ===================================================================
+    return dataChanged;
+}
 
 /**
- * @brief RDS adatok frissítése adaptív időzítéssel és cache-eléssel
- * @return true ha változtak az adatok
+ * @brief A dekóder által publikált adatok átvétele a cache-be
+ * @param decoderChanges RdsDecoder::CHANGED_* jelzők
+ * @return true ha a cache tartalma változott
  */
-bool Si4735Rds::updateRdsDataWithCache() {
-    uint32_t currentTime = millis();
-
-    // Adaptív frissítési időköz:
-    // - Ha nincs RDS adat -> 1 másodperc (gyors keresés)
-    // - Ha van stabil RDS adat -> 3 másodperc (takarékos)
-    uint32_t adaptiveInterval = RDS_UPDATE_INTERVAL_SLOW;
-    if (cachedStationName.isEmpty() || cachedStationName.length() < VALID_STATION_NAME_MIN_LENGHT) {
-        adaptiveInterval = RDS_UPDATE_INTERVAL_FAST;
-    }
-
-    // Időzített frissítés
-    if (currentTime - lastRdsUpdate < adaptiveInterval || !isRdsAvailable()) {
-        return false; // Túl korai a frissítés vagy nincs RDS adat
+bool Si4735Rds::updateCachedText(uint8_t decoderChanges) {
+    if (decoderChanges == 0) {
+        return false;
     }
-    lastRdsUpdate = currentTime;
 
     bool dataChanged = false;
-    bool hasValidData = false;
 
-    // --- Állomásnév frissítése -------------------------------------------------------------
-    String newStationName = getRdsStationName();
-    // Csak akkor frissíti a cache-t, ha tényleg változott az adat
-    if (!newStationName.isEmpty() && newStationName.length() >= VALID_STATION_NAME_MIN_LENGHT && newStationName != cachedStationName) {
-        cachedStationName = newStationName;
+    // Állomásváltás (új PI): minden korábbi adat érvénytelen
+    if (decoderChanges & RdsDecoder::CHANGED_PI) {
+        clearCachedText();
         dataChanged = true;
-        hasValidData = true;
-    }
-    // Akkor is jelzünk az érvényes adatot, ha nem változott, de van adat
-    if (!newStationName.isEmpty()) {
-        hasValidData = true;
     }
 
-    // --- Program típus frissítése - PTY kód alapján -----------------------------------------
-    uint8_t newPtyCode = getRdsProgramTypeCode();
-    if (newPtyCode != 255) { // 255 = nincs RDS
-        String newProgramType = convertPtyCodeToString(newPtyCode);
-        if (!newProgramType.isEmpty() && newProgramType != cachedProgramType) {
-            cachedProgramType = newProgramType;
+    // --- Állomásnév --------------------------------------------------------------------------
+    if (decoderChanges & RdsDecoder::CHANGED_PS) {
+        char name[RdsDecoder::PS_LENGTH + 1];
+        strcpy(name, rdsDecoder.getProgramService());
+        Utils::trimSpaces(name);
+        if (strlen(name) >= VALID_STATION_NAME_MIN_LENGHT && strcmp(name, cachedStationName) != 0) {
+            strcpy(cachedStationName, name);
             dataChanged = true;
-            hasValidData = true;
-        }
-        if (!newProgramType.isEmpty()) {
-            hasValidData = true;
         }
     }
 
-    // --- Radio text frissítése -------------------------------------------------------------
-    String newRadioText = getRdsRadioText();
-    if (!newRadioText.isEmpty() && newRadioText != cachedRadioText) {
-        cachedRadioText = newRadioText;
-        dataChanged = true;
-        hasValidData = true;
-    }
-    if (!newRadioText.isEmpty()) {
-        hasValidData = true;
-    }
-
-    // -- Dátum/idő frissítése -------------------------------------------------------------
-    uint16_t year, month, day, hour, minute;
-    if (getRdsDateTime(year, month, day, hour, minute)) {
-        // Dátum formázása: "2025.06.14"
-        String newDate = String(year) + "." + (month < 10 ? "0" : "") + String(month) + "." + (day < 10 ? "0" : "") + String(day);
-
-        // Dátum ellenőrzése és frissítése
-        if (newDate != cachedDate) {
-            cachedDate = newDate;
+    // --- Program típus - PTY kód alapján -----------------------------------------------------
+    if (decoderChanges & RdsDecoder::CHANGED_PTY) {
+        uint8_t ptyCode = rdsDecoder.getProgramType();
+        const char *programType = ptyCode == RdsDecoder::PTY_NONE ? "" : convertPtyCodeToString(ptyCode);
+        if (programType != cachedProgramType) {
+            cachedProgramType = programType;
             dataChanged = true;
-            hasValidData = true;
         }
+    }
 
-        // Idő formázása: "15:30"
-        String newTime = (hour < 10 ? "0" : "") + String(hour) + ":" + (minute < 10 ? "0" : "") + String(minute);
-
-        // Idő ellenőrzése és frissítése
-        if (newTime != cachedTime) {
-            cachedTime = newTime;
+    // --- Radio text --------------------------------------------------------------------------
+    if (decoderChanges & RdsDecoder::CHANGED_RT) {
+        char text[RdsDecoder::RT_LENGTH + 1];
+        strcpy(text, rdsDecoder.getRadioText());
+        Utils::trimSpaces(text);
+        if (text[0] != '\0' && strcmp(text, cachedRadioText) != 0) {
+            strcpy(cachedRadioText, text);
             dataChanged = true;
-            hasValidData = true;
         }
     }
 
-    // Ha volt valid adat, frissítsük az időzítőt
-    if (hasValidData) {
-        lastValidRdsData = currentTime;
-
-        if (dataChanged) {
-            DEBUG("--- RDS data dataChanged --- \n");
-            DEBUG("cachedStationName: '%s'\n", cachedStationName.c_str());
-            DEBUG("cachedProgramType: '%s'\n", cachedProgramType.c_str());
-            DEBUG("cachedRadioText: '%s'\n", cachedRadioText.c_str());
-            DEBUG("cachedDate: '%s'\n", cachedDate.c_str());
-            DEBUG("cachedTime: '%s'\n", cachedTime.c_str());
-            DEBUG("---------------------------- \n");
-        }
+    // -- Dátum/idő ----------------------------------------------------------------------------
+    uint16_t year, month, day, hour, minute;
+    if ((decoderChanges & RdsDecoder::CHANGED_CT) && rdsDecoder.getDateTime(year, month, day, hour, minute)) {
+        snprintf(cachedDate, sizeof(cachedDate), "%04u.%02u.%02u", year, month, day); // "2025.06.14"
+        snprintf(cachedTime, sizeof(cachedTime), "%02u:%02u", hour, minute);         // "15:30"
+        snprintf(cachedDateTime, sizeof(cachedDateTime), "%s %s", cachedDate, cachedTime);
+        dataChanged = true;
     }
 
-    // Timeout ellenőrzés - különböző időzítés a különböző RDS adatokhoz
-    if (currentTime - lastValidRdsData > RDS_DATA_TIMEOUT) { // Hosszú timeout után ha nincs érvényes állomásnév, akkor töröljük a cache-t
-        if (!cachedStationName.isEmpty()) {
-            cachedStationName = "";
-            cachedProgramType = "";
-            cachedRadioText = "";
-            cachedDate = "";
-            cachedTime = "";
-            dataChanged = true;
-        }
+    if (dataChanged) {
+        DEBUG("--- RDS data dataChanged --- \n");
+        DEBUG("PI: %04X\n", rdsDecoder.getPi());
+        DEBUG("cachedStationName: '%s'\n", cachedStationName);
+        DEBUG("cachedProgramType: '%s'\n", cachedProgramType);
+        DEBUG("cachedRadioText: '%s'\n", cachedRadioText);
+        DEBUG("cachedDateTime: '%s'\n", cachedDateTime);
+        DEBUG("---------------------------- \n");
     }
 
     return dataChanged;
 }
 
 /**
- * @brief Cache törlése (pl. állomásváltáskor)
+ * @brief A cache-elt szövegek törlése
  */
-void Si4735Rds::clearRdsCache() {
-    cachedStationName = "";
+void Si4735Rds::clearCachedText() {
+    cachedStationName[0] = '\0';
     cachedProgramType = "";
-    cachedRadioText = "";
-    cachedDate = "";
-    cachedTime = "";
-    lastRdsUpdate = 0; // Azonnal frissítsen
+    cachedRadioText[0] = '\0';
+    cachedDate[0] = '\0';
+    cachedTime[0] = '\0';
+    cachedDateTime[0] = '\0';
+}
+
+/**
+ * @brief Cache és dekóder törlése (pl. állomásváltáskor)
+ */
+void Si4735Rds::clearRdsCache() {
+    clearCachedText();
+    rdsDecoder.reset();
+    rdsGroupRing.flush(); // A korábbi frekvencián vett, még fel nem dolgozott csoportok eldobása
+    rdsSync = false;
     lastValidRdsData = 0;
+    rdsCacheClearTime = millis();
+    timeToFirstPsMs = 0;
 }
 
 /**
  * @brief PTY kód szöveges leírássá alakítása
  * @param ptyCode A PTY kód (0-31)
- * @return String A PTY szöveges leírása
+ * @return A PTY szöveges leírása
  */
-String Si4735Rds::convertPtyCodeToString(uint8_t ptyCode) {
+const char *Si4735Rds::convertPtyCodeToString(uint8_t ptyCode) {
     // PTY kódok RDS szabvány szerint (0-31)
     static const char *ptyTable[] = {
         "No programme",          // 0
@@ -320,7 +303,7 @@ String Si4735Rds::convertPtyCodeToString(uint8_t ptyCode) {
     };
 
     if (ptyCode <= 31) {
-        return String(ptyTable[ptyCode]);
+        return ptyTable[ptyCode];
     }
     return "Unknown";
 }
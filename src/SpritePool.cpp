@@ -0,0 +1,149 @@
+/**
+ * @file SpritePool.cpp
+ * @brief Tartós sprite pool implementáció
+ */
+
+#include "SpritePool.h"
+
+#include <new>
+
+#include "defines.h"
+
+/**
+ * @brief Konstruktor
+ */
+SpritePool::SpritePool(TFT_eSPI &tft) : tft(tft), slots{}, useCounter(0), leaseCount(0), allocationCount(0), failureCount(0) {}
+
+/**
+ * @brief Sprite kölcsönkérése
+ * @details Elsőként pontosan egyező, szabad sprite-ot keres (ez a gyakori eset, foglalás nélkül). Ha nincs,
+ * egy üres helyre, vagy a legrégebben visszaadott szabad sprite helyére foglal; memória hiányában a többi
+ * szabad sprite pufferét is felszabadítja, és még egyszer megpróbálja.
+ */
+TFT_eSprite *SpritePool::lease(uint16_t width, uint16_t height, uint8_t colorDepth) {
+    leaseCount++;
+
+    for (Slot &slot : slots) {
+        if (slot.created && !slot.leased && slot.width == width && slot.height == height && slot.colorDepth == colorDepth) {
+            slot.leased = true;
+            return slot.sprite;
+        }
+    }
+
+    Slot *victim = nullptr;
+    for (Slot &slot : slots) {
+        if (slot.leased) {
+            continue;
+        }
+        if (!slot.created) {
+            victim = &slot;
+            break;
+        }
+        if (victim == nullptr || slot.lastUsed < victim->lastUsed) {
+            victim = &slot;
+        }
+    }
+    if (victim == nullptr) {
+        failureCount++;
+        DEBUG("SpritePool: all %u sprites leased (%ux%u/%u)\n", MAX_SPRITES, width, height, colorDepth);
+        return nullptr;
+    }
+
+    if (!allocate(*victim, width, height, colorDepth)) {
+        for (Slot &slot : slots) {
+            if (&slot != victim && !slot.leased) {
+                freeSlot(slot);
+            }
+        }
+        if (!allocate(*victim, width, height, colorDepth)) {
+            failureCount++;
+            DEBUG("SpritePool: out of memory (%ux%u/%u)\n", width, height, colorDepth);
+            return nullptr;
+        }
+    }
+
+    victim->leased = true;
+    return victim->sprite;
+}
+
+/**
+ * @brief Sprite visszaadása
+ */
+void SpritePool::release(TFT_eSprite *sprite) {
+    if (sprite == nullptr) {
+        return;
+    }
+    for (Slot &slot : slots) {
+        if (slot.sprite == sprite && slot.leased) {
+            slot.leased = false;
+            slot.lastUsed = ++useCounter;
+            return;
+        }
+    }
+    DEBUG("SpritePool: release of unknown sprite\n");
+}
+
+/**
+ * @brief A pool által tartott sprite pufferek összmérete
+ */
+uint32_t SpritePool::getAllocatedBytes() const {
+    uint32_t bytes = 0;
+    for (const Slot &slot : slots) {
+        if (slot.created) {
+            bytes += getBufferSize(slot.width, slot.height, slot.colorDepth);
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief A hely sprite pufferének (újra)foglalása a kért mérettel
+ */
+bool SpritePool::allocate(Slot &slot, uint16_t width, uint16_t height, uint8_t colorDepth) {
+    freeSlot(slot);
+    if (slot.sprite == nullptr) {
+        slot.sprite = new (std::nothrow) TFT_eSprite(&tft);
+        if (slot.sprite == nullptr) {
+            return false;
+        }
+    }
+
+    slot.sprite->setColorDepth(colorDepth);
+    if (slot.sprite->createSprite(width, height) == nullptr) {
+        return false;
+    }
+
+    slot.width = width;
+    slot.height = height;
+    slot.colorDepth = colorDepth;
+    slot.created = true;
+    allocationCount++;
+    DEBUG("SpritePool: allocated %ux%u/%u bit, total %lu bytes\n", width, height, colorDepth, getAllocatedBytes());
+    return true;
+}
+
+/**
+ * @brief A hely sprite pufferének felszabadítása (a sprite objektum megmarad)
+ */
+void SpritePool::freeSlot(Slot &slot) {
+    if (slot.created) {
+        slot.sprite->deleteSprite();
+        slot.created = false;
+    }
+}
+
+/**
+ * @brief A sprite puffer mérete (a 4 és 1 bites sorok byte határra kerekítve)
+ */
+uint32_t SpritePool::getBufferSize(uint16_t width, uint16_t height, uint8_t colorDepth) {
+    switch (colorDepth) {
+        case 1:
+            return static_cast<uint32_t>((width + 7) / 8) * height;
+        case 4:
+            return static_cast<uint32_t>((width + 1) / 2) * height;
+        case 8:
+            return static_cast<uint32_t>(width) * height;
+        default:
+            return static_cast<uint32_t>(width) * height * 2;
+    }
+}
@@ -123,7 +123,7 @@ String SystemInfoDialog::formatMemoryInfo() {
     PicoMemoryInfo::MemoryStatus_t memStatus = PicoMemoryInfo::getMemoryStatus();
 
     // EEPROM használat számítása
-    uint32_t eepromUsed = EEPROM_AM_STATIONS_ADDR + AM_STATIONS_REQUIRED_SIZE;
+    uint32_t eepromUsed = EEPROM_TOTAL_USED;
     uint32_t eepromFree = EEPROM_SIZE - eepromUsed;
     float eepromUsedPercent = (eepromUsed * 100.0f) / EEPROM_SIZE;
 
@@ -0,0 +1,233 @@
+/**
+ * @file TftDma.cpp
+ * @brief DMA-s TFT kitolás implementáció
+ */
+
+#include "TftDma.h"
+
+#include <algorithm>
+
+#include "defines.h"
+
+namespace {
+/**
+ * @brief RGB565 szín a sprite pufferek bájtsorrendjében (a kitolás bájtcsere nélkül történik)
+ */
+inline uint16_t toBufferColor(uint16_t color) { return (color >> 8) | (color << 8); }
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+TftDma::TftDma(TFT_eSPI &tft)
+    : tft(tft), enabled(false), transferActive(false), nextBuffer(0), inFlight(nullptr), frameActive(false), frameHasInput(false), inputPending(false), frameStartMicros(0),
+      inputMicros(0), lastFrameMicros(0), averageFrameMicros(0), maxFrameMicros(0), lastFrameCpuMicros(0), lastInputLatencyMicros(0), maxInputLatencyMicros(0),
+      fenceWaitMicros(0), asyncPushCount(0), syncPushCount(0) {
+
+    for (uint16_t color = 0; color < 256; color++) {
+        rgb332Colors[color] = toBufferColor(tft.color8to16(color));
+    }
+}
+
+/**
+ * @brief A DMA csatorna lefoglalása
+ * @details Ha nincs szabad DMA csatorna (pl. az audio mintavételezés mellett), a kitolás szinkron marad.
+ */
+void TftDma::begin() {
+#ifdef RP2040_DMA
+    enabled = tft.initDMA();
+#endif
+    if (!enabled) {
+        DEBUG("TftDma: DMA not available, pushes stay synchronous\n");
+    }
+}
+
+/**
+ * @brief A következő staging puffer
+ */
+uint16_t *TftDma::acquireBuffer() {
+    uint16_t *buffer = buffers[nextBuffer];
+    if (buffer == inFlight) {
+        fence(); // Az újrahasználat előtt a kitolásnak be kell fejeződnie
+    }
+    return buffer;
+}
+
+/**
+ * @brief Az aktuális staging puffer kitolása
+ * @details A pushImageDMA() az indítás előtt megvárja az előző kitolást, így egyszerre legfeljebb egy puffer van
+ * úton, és a váltakozás miatt az acquireBuffer() által adott puffer kitolása ilyenkor már befejeződött.
+ */
+void TftDma::pushBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height) {
+    uint16_t *buffer = buffers[nextBuffer];
+    nextBuffer ^= 1;
+
+    bool oldSwapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(false);
+
+    if (enabled) {
+        if (!transferActive) {
+            tft.startWrite(); // A DMA kitolás alatt a tranzakció (CS) nyitva marad
+            transferActive = true;
+        }
+        tft.pushImageDMA(x, y, width, height, buffer);
+        inFlight = buffer;
+        asyncPushCount++;
+    } else {
+        tft.pushImage(x, y, width, height, buffer);
+        syncPushCount++;
+    }
+
+    tft.setSwapBytes(oldSwapBytes);
+}
+
+/**
+ * @brief Sprite kitolása csíkokban
+ * @details A csík a sprite teljes szélessége, annyi sorral, amennyi egy staging pufferbe fér. A 16 bites sprite
+ * sorai másolódnak, a 8 bitesek (RGB332) és a 4 bitesek (paletta) itt konvertálódnak RGB565-re.
+ */
+void TftDma::pushSprite(TFT_eSprite &sprite, int16_t x, int16_t y) {
+    const uint8_t colorDepth = sprite.getColorDepth();
+    const int16_t width = sprite.width();
+    const int16_t height = sprite.height();
+    const void *pixels = sprite.getPointer();
+
+    // A 4 bites sprite páratlan szélességnél nem soronként bájthatáros: ilyenkor (és 1 biten) a sprite maga tolja ki
+    if (pixels == nullptr || width <= 0 || width > BUFFER_PIXELS || colorDepth == 1 || (colorDepth == 4 && (width & 1))) {
+        fence();
+        sprite.pushSprite(x, y);
+        syncPushCount++;
+        return;
+    }
+
+    uint16_t palette[16];
+    if (colorDepth == 4) {
+        for (uint8_t i = 0; i < 16; i++) {
+            palette[i] = toBufferColor(sprite.getPaletteColor(i));
+        }
+    }
+
+    const int16_t stripRows = BUFFER_PIXELS / width;
+    for (int16_t row = 0; row < height; row += stripRows) {
+        uint16_t rows = std::min<int16_t>(stripRows, height - row);
+        uint32_t first = static_cast<uint32_t>(row) * width;
+        uint32_t count = static_cast<uint32_t>(rows) * width;
+        uint16_t *buffer = acquireBuffer();
+
+        if (colorDepth == 16) {
+            memcpy(buffer, static_cast<const uint16_t *>(pixels) + first, count * sizeof(uint16_t));
+        } else if (colorDepth == 8) {
+            const uint8_t *source = static_cast<const uint8_t *>(pixels) + first;
+            for (uint32_t i = 0; i < count; i++) {
+                buffer[i] = rgb332Colors[source[i]];
+            }
+        } else {
+            const uint8_t *source = static_cast<const uint8_t *>(pixels) + first / 2; // A páros x a felső 4 bit
+            for (uint32_t i = 0; i < count; i += 2) {
+                uint8_t pair = *source++;
+                buffer[i] = palette[pair >> 4];
+                buffer[i + 1] = palette[pair & 0x0F];
+            }
+        }
+
+        pushBuffer(x, y + row, width, rows);
+    }
+}
+
+/**
+ * @brief A folyamatban lévő kitolás megvárása
+ */
+void TftDma::fence() {
+    if (!transferActive) {
+        return;
+    }
+
+    uint32_t start = micros();
+#ifdef RP2040_DMA
+    tft.dmaWait();
+#endif
+    fenceWaitMicros += micros() - start;
+    completeTransfer();
+}
+
+/**
+ * @brief A kitolás befejezésének észlelése várakozás nélkül
+ */
+void TftDma::poll() {
+#ifdef RP2040_DMA
+    if (transferActive && !tft.dmaBusy()) {
+        completeTransfer();
+    }
+#endif
+}
+
+/**
+ * @brief A befejezett kitolás tranzakciójának lezárása
+ */
+void TftDma::completeTransfer() {
+    tft.endWrite();
+    transferActive = false;
+    inFlight = nullptr;
+    completeFrame();
+}
+
+/**
+ * @brief Képkocka kezdete (a ScreenManager::draw() a fence() után hívja)
+ */
+void TftDma::beginFrame() {
+    frameStartMicros = micros();
+    frameActive = true;
+    frameHasInput = inputPending;
+}
+
+/**
+ * @brief A képkocka rajzolása (CPU oldal) véget ért; ha nincs úton kitolás, a képkocka is kész
+ */
+void TftDma::endFrame() {
+    lastFrameCpuMicros = micros() - frameStartMicros;
+    if (!transferActive) {
+        completeFrame();
+    }
+}
+
+/**
+ * @brief Input esemény (touch, rotary) érkezett: az első még meg nem jelenített esemény ideje számít
+ */
+void TftDma::noteInput() {
+    if (!inputPending) {
+        inputPending = true;
+        inputMicros = micros();
+    }
+}
+
+/**
+ * @brief A képkocka összes pixele kint van: képkocka idő és input késleltetés rögzítése
+ */
+void TftDma::completeFrame() {
+    if (!frameActive) {
+        return;
+    }
+    frameActive = false;
+
+    uint32_t now = micros();
+    lastFrameMicros = now - frameStartMicros;
+    averageFrameMicros = averageFrameMicros == 0 ? lastFrameMicros : (averageFrameMicros * 7 + lastFrameMicros) / 8;
+    maxFrameMicros = std::max(maxFrameMicros, lastFrameMicros);
+
+    if (frameHasInput) {
+        frameHasInput = false;
+        inputPending = false;
+        lastInputLatencyMicros = now - inputMicros;
+        maxInputLatencyMicros = std::max(maxInputLatencyMicros, lastInputLatencyMicros);
+    }
+}
+
+/**
+ * @brief A mért értékek kiírása
+ */
+void TftDma::debugMetrics() {
+    DEBUG("TftDma: frame %lu us (avg %lu, max %lu, cpu %lu), input-to-photon %lu us (max %lu), fence wait %lu us, pushes %lu async / %lu sync\n", lastFrameMicros,
+          averageFrameMicros, maxFrameMicros, lastFrameCpuMicros, lastInputLatencyMicros, maxInputLatencyMicros, fenceWaitMicros, asyncPushCount, syncPushCount);
+    maxFrameMicros = 0;
+    maxInputLatencyMicros = 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file UIDamageRegion.cpp
+ * @brief Sérült képernyő területek gyűjtője - implementáció
+ */
+
+#include "UIDamageRegion.h"
+
+namespace {
+/**
+ * @brief Érdemes-e összevonni: átfednek vagy érintkeznek, és a befoglaló téglalap nem nagyobb a kettő összterületénél
+ */
+bool shouldMerge(const Rect &a, const Rect &b) {
+    Rect grownA(a.x - 1, a.y - 1, a.width + 2, a.height + 2); // Az érintkező téglalapok is összevonhatók
+    return grownA.intersects(b) && a.united(b).area() <= a.area() + b.area();
+}
+} // namespace
+
+/**
+ * @brief Téglalap hozzáadása összevonással
+ */
+void UIDamageRegion::add(const Rect &rect) {
+    Rect merged = rect.intersected(Rect(0, 0, UIComponent::SCREEN_W, UIComponent::SCREEN_H));
+    if (merged.isEmpty()) {
+        return;
+    }
+
+    // Az összevonás nőhet, ezért addig ismételjük, amíg van összevonható
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint8_t i = 0; i < count; i++) {
+            if (rects[i].contains(merged)) {
+                return; // Már sérültként szerepel
+            }
+            if (shouldMerge(rects[i], merged)) {
+                merged = rects[i].united(merged);
+                removeAt(i);
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    // Betelt lista: a legkisebb területnövekedéssel járó összevonás
+    while (count == MAX_RECTS) {
+        uint8_t best = 0;
+        uint32_t bestGrowth = UINT32_MAX;
+        for (uint8_t i = 0; i < count; i++) {
+            uint32_t growth = rects[i].united(merged).area() - rects[i].area();
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                best = i;
+            }
+        }
+        merged = rects[best].united(merged);
+        removeAt(best);
+    }
+
+    rects[count++] = merged;
+}
+
+/**
+ * @brief Van-e közös része a téglalappal valamelyik sérült területnek
+ */
+bool UIDamageRegion::intersects(const Rect &rect) const {
+    for (uint8_t i = 0; i < count; i++) {
+        if (rects[i].intersects(rect)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Téglalap eltávolítása (a sorrend nem számít: az utolsó kerül a helyére)
+ */
+void UIDamageRegion::removeAt(uint8_t index) { rects[index] = rects[--count]; }
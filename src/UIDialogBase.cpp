@@ -74,7 +74,7 @@ void UIDialogBase::close(DialogResult result) {
 void UIDialogBase::draw() {
 
     if (!veilDrawn) {
-        drawVeil();
+        drawVeil(Rect(0, 0, UIComponent::SCREEN_W, UIComponent::SCREEN_H));
         veilDrawn = true;
     }
 
@@ -88,9 +88,8 @@ void UIDialogBase::draw() {
  */
 void UIDialogBase::drawSelf() {
     // Árnyék effekt rajzolása (eltolva jobbra és lefelé)
-    const int shadowOffset = 4;
     const uint16_t shadowColor = TFT_COLOR(64, 64, 64); // Sötétszürke árnyék
-    tft.fillRect(bounds.x + shadowOffset, bounds.y + shadowOffset, bounds.width, bounds.height, shadowColor);
+    tft.fillRect(bounds.x + SHADOW_OFFSET, bounds.y + SHADOW_OFFSET, bounds.width, bounds.height, shadowColor);
 
     // Dialógus háttér rajzolása (az árnyék fölé)
     tft.fillRect(bounds.x, bounds.y, bounds.width, bounds.height, colors.background); // Vastagabb, világosabb keret több rétegben
@@ -194,15 +193,20 @@ void UIDialogBase::markForRedraw(bool markChildren) {
 
 /**
  * @brief Fátyolt kirajzolása a dialógus körül.
+ * @param area A kirajzolandó terület (a teljes képernyő, vagy egy helyreállítandó sérült terület)
  * @details A fátyol csak a dialógus területén kívül rajzolódik ki, hogy a dialógus kiemelkedjen.
- * A fátyol pixel mérete 3, és a színe a UIColorPalette::DIALOG_VEIL_COLOR.
+ * A fátyol pixel mérete 3, és a színe a UIColorPalette::DIALOG_VEIL_COLOR. A fátyol pontjai a képernyőhöz
+ * rögzített rácson vannak, így minden dialógus fátyla ugyanazokra a pixelekre esik, és egy részterület
+ * kirajzolása pontosan ugyanazt adja, mint a teljes fátyol abban a részben.
  */
-void UIDialogBase::drawVeil() {            // CSAK a dialógus területén KÍVÜL rajzoljuk a fátyolt!
-    constexpr uint8_t VEIL_PIXEL_SIZE = 3; // Fátyol pixel mérete
-    for (int16_t y = 0; y < UIComponent::SCREEN_H; y += VEIL_PIXEL_SIZE) {
+void UIDialogBase::drawVeil(const Rect &area) { // CSAK a dialógus területén KÍVÜL rajzoljuk a fátyolt!
+    constexpr uint8_t VEIL_PIXEL_SIZE = 3;      // Fátyol pixel mérete
+    int16_t firstY = (area.y + VEIL_PIXEL_SIZE - 1) / VEIL_PIXEL_SIZE * VEIL_PIXEL_SIZE;
+    int16_t firstX = (area.x + VEIL_PIXEL_SIZE - 1) / VEIL_PIXEL_SIZE * VEIL_PIXEL_SIZE;
+    for (int16_t y = firstY; y < area.y + area.height; y += VEIL_PIXEL_SIZE) {
 
         // Ne rajzoljunk fátyolt a dialógus területére!
-        for (int16_t x = (y % VEIL_PIXEL_SIZE); x < UIComponent::SCREEN_W; x += VEIL_PIXEL_SIZE) {
+        for (int16_t x = firstX + (y % VEIL_PIXEL_SIZE); x < area.x + area.width; x += VEIL_PIXEL_SIZE) {
             if (!bounds.contains(x, y)) {
                 tft.drawPixel(x, y, UIColorPalette::DIALOG_VEIL_COLOR);
             }
@@ -210,6 +214,27 @@ void UIDialogBase::drawVeil() {            // CSAK a dialógus területén KÍV
     }
 }
 
+/**
+ * @brief A dialógus helyreállítása egy sérült területen
+ */
+void UIDialogBase::repairArea(const Rect &area) {
+    if (!veilDrawn) {
+        return; // A következő draw() a teljes fátyolt és a dialógust is kirajzolja
+    }
+
+    drawVeil(area);
+    if (!getFootprint().intersects(area)) {
+        return;
+    }
+
+    // Ha már vár újrarajzolásra, a következő draw() teljesen (vágás nélkül) rajzolja ki
+    bool pending = isRedrawNeeded();
+    markForRedraw(true);
+    if (!pending) {
+        draw();
+    }
+}
+
 void UIDialogBase::createCloseButton() {
     // Bezáró gomb mérete és pozíciója
     constexpr int16_t CLOSE_BTN_SIZE = 20;
@@ -0,0 +1,227 @@
+/**
+ * @file UIProfiler.cpp
+ * @brief Futásidő profilozó implementáció
+ */
+
+#include "UIProfiler.h"
+
+#ifdef UI_PROFILER
+
+#include <algorithm>
+
+UIProfiler uiProfiler;
+
+namespace {
+/**
+ * @brief Fél oktávos vödör: [2^m, 1.5 * 2^m) -> 2m, [1.5 * 2^m, 2^(m+1)) -> 2m + 1 (0 és 1 us a 0. vödörbe)
+ */
+uint8_t bucketOf(uint32_t micros) {
+    if (micros < 2) {
+        return 0;
+    }
+    uint8_t msb = 31 - __builtin_clz(micros);
+    uint8_t bucket = msb * 2 + ((micros >> (msb - 1)) & 1);
+    return std::min<uint8_t>(bucket, UIProfileStats::BUCKETS - 1);
+}
+
+/**
+ * @brief A vödör felső határa (us)
+ */
+uint32_t bucketUpperBound(uint8_t bucket) {
+    if (bucket < 2) {
+        return 1;
+    }
+    uint8_t msb = bucket / 2;
+    uint32_t half = 1UL << (msb - 1);
+    return (1UL << msb) + (bucket & 1) * half + half - 1;
+}
+} // namespace
+
+/**
+ * @brief Statisztika nullázása
+ */
+void UIProfileStats::reset() {
+    count = 0;
+    totalMicros = 0;
+    minMicros = UINT32_MAX;
+    maxMicros = 0;
+    memset(buckets, 0, sizeof(buckets));
+}
+
+/**
+ * @brief Egy mérés hozzáadása
+ */
+void UIProfileStats::add(uint32_t micros) {
+    count++;
+    totalMicros += micros;
+    minMicros = std::min(minMicros, micros);
+    maxMicros = std::max(maxMicros, micros);
+    buckets[bucketOf(micros)]++;
+}
+
+/**
+ * @brief Percentilis becslése
+ */
+uint32_t UIProfileStats::getPercentile(uint8_t percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t target = (static_cast<uint64_t>(count) * percent + 99) / 100; // Felfelé kerekítve
+    uint32_t cumulative = 0;
+    for (uint8_t bucket = 0; bucket < BUCKETS; bucket++) {
+        cumulative += buckets[bucket];
+        if (cumulative >= target) {
+            return bucket == BUCKETS - 1 ? maxMicros : std::min(bucketUpperBound(bucket), maxMicros); // Az utolsó vödör felülről nyitott
+        }
+    }
+    return maxMicros;
+}
+
+/**
+ * @brief Konstruktor
+ */
+UIProfiler::UIProfiler() { reset(); }
+
+/**
+ * @brief Új mérési ablak
+ */
+void UIProfiler::reset() {
+    for (UIProfileStats &stats : points) {
+        stats.reset();
+    }
+    componentCount = 0;
+    droppedComponentSamples = 0;
+    windowStartMillis = millis();
+}
+
+/**
+ * @brief Összesített mérőpont rögzítése
+ */
+void UIProfiler::record(Point point, uint32_t micros) { points[static_cast<uint8_t>(point)].add(micros); }
+
+/**
+ * @brief Komponens rajzolásának rögzítése
+ */
+void UIProfiler::recordComponent(const UIComponent *component, uint32_t micros) {
+    ComponentSlot *slot = nullptr;
+    for (uint8_t i = 0; i < componentCount; i++) {
+        if (components[i].component == component) {
+            slot = &components[i];
+            break;
+        }
+    }
+    if (slot == nullptr) {
+        if (componentCount == MAX_COMPONENTS) {
+            droppedComponentSamples++;
+            return;
+        }
+        slot = &components[componentCount++];
+        slot->component = component;
+        slot->stats.reset();
+    }
+
+    slot->bounds = component->getBounds();
+    slot->stats.add(micros);
+}
+
+/**
+ * @brief Mérőpont neve a kiíráshoz
+ */
+const char *UIProfiler::getPointName(Point point) {
+    switch (point) {
+        case Point::Frame:
+            return "frame";
+        case Point::LoopIteration:
+            return "loop";
+        case Point::OwnLoop:
+            return "ownLoop";
+        case Point::Si4735Loop:
+            return "si4735";
+        case Point::TouchDispatch:
+            return "touch";
+        case Point::RotaryDispatch:
+            return "rotary";
+        case Point::ScanSpectrum:
+            return "spectrum";
+        default:
+            return "?";
+    }
+}
+
+/**
+ * @brief Kiírás a soros portra
+ */
+void UIProfiler::dump() {
+    DEBUG("UIProfiler: %lu ms window (us: n / min / avg / p99 / max)\n", millis() - windowStartMillis);
+    for (uint8_t i = 0; i < static_cast<uint8_t>(Point::Count); i++) {
+        const UIProfileStats &stats = points[i];
+        if (stats.count == 0) {
+            continue;
+        }
+        DEBUG("  %-8s %6lu / %6lu / %6lu / %6lu / %6lu\n", getPointName(static_cast<Point>(i)), stats.count, stats.minMicros, stats.getAverage(), stats.getPercentile(99),
+              stats.maxMicros);
+    }
+
+    // Komponensek a legdrágább (átlag) rajzolással kezdve
+    uint8_t order[MAX_COMPONENTS];
+    for (uint8_t i = 0; i < componentCount; i++) {
+        order[i] = i;
+    }
+    std::sort(order, order + componentCount, [this](uint8_t a, uint8_t b) { return components[a].stats.getAverage() > components[b].stats.getAverage(); });
+
+    for (uint8_t i = 0; i < componentCount; i++) {
+        const ComponentSlot &slot = components[order[i]];
+        DEBUG("  draw %3d,%3d %3ux%-3u %6lu / %6lu / %6lu / %6lu / %6lu\n", slot.bounds.x, slot.bounds.y, slot.bounds.width, slot.bounds.height, slot.stats.count,
+              slot.stats.minMicros, slot.stats.getAverage(), slot.stats.getPercentile(99), slot.stats.maxMicros);
+    }
+    if (droppedComponentSamples) {
+        DEBUG("  %lu component draws not recorded (table full)\n", droppedComponentSamples);
+    }
+}
+
+/**
+ * @brief Összesítés a képernyőn: képkocka, loop és a legdrágább komponens
+ */
+void UIProfiler::drawOverlay(TFT_eSPI &tft) {
+    constexpr int16_t OVERLAY_X = 0;
+    constexpr int16_t OVERLAY_Y = 0;
+    constexpr int16_t OVERLAY_W = 200;
+    constexpr int16_t LINE_HEIGHT = 8;
+
+    const UIProfileStats &frame = points[static_cast<uint8_t>(Point::Frame)];
+    const UIProfileStats &loop = points[static_cast<uint8_t>(Point::LoopIteration)];
+
+    const ComponentSlot *slowest = nullptr;
+    for (uint8_t i = 0; i < componentCount; i++) {
+        if (slowest == nullptr || components[i].stats.getAverage() > slowest->stats.getAverage()) {
+            slowest = &components[i];
+        }
+    }
+
+    char lines[3][40];
+    snprintf(lines[0], sizeof(lines[0]), "frame %lu/%lu/%lu us", frame.getAverage(), frame.getPercentile(99), frame.maxMicros);
+    snprintf(lines[1], sizeof(lines[1]), "loop  %lu/%lu/%lu us", loop.getAverage(), loop.getPercentile(99), loop.maxMicros);
+    if (slowest) {
+        snprintf(lines[2], sizeof(lines[2]), "max @%d,%d %lu/%lu us", slowest->bounds.x, slowest->bounds.y, slowest->stats.getAverage(), slowest->stats.getPercentile(99));
+    } else {
+        lines[2][0] = '\0';
+    }
+
+    tft.fillRect(OVERLAY_X, OVERLAY_Y, OVERLAY_W, LINE_HEIGHT * 3, TFT_BLACK);
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_GREENYELLOW, TFT_BLACK);
+    for (uint8_t i = 0; i < 3; i++) {
+        tft.drawString(lines[i], OVERLAY_X + 1, OVERLAY_Y + i * LINE_HEIGHT);
+    }
+}
+
+/**
+ * @brief Időzítők: a hatókör végén rögzítenek
+ */
+UIProfileScope::~UIProfileScope() { uiProfiler.record(point, micros() - start); }
+
+UIProfileComponentScope::~UIProfileComponentScope() { uiProfiler.recordComponent(component, micros() - start); }
+
+#endif // UI_PROFILER
@@ -1,5 +1,7 @@
 #include "UIScreen.h"
 
+#include "UIProfiler.h"
+
 // ================================
 // Konstruktorok és inicializálás
 // ================================
@@ -22,18 +24,24 @@ UIScreen::UIScreen(TFT_eSPI &tft, const char *name, Si4735Manager *pSi4735Manage
  * @return true ha újrarajzolás szükséges, false egyébként
  *
  * A metódus kompozit ellenőrzést végez:
- * 1. Szülő UIContainerComponent újrarajzolási igényének ellenőrzése
+ * 1. A képernyő saját, a feltárt területek és a látható gyerek komponensek újrarajzolási igénye
  * 2. Aktív dialógus újrarajzolási igényének ellenőrzése (ha van)
  *
- * Ez biztosítja, hogy mind az alapképernyő, mind a dialógusok
- * változásai megfelelően detektálódjanak.
+ * A dialógus alatt teljesen takarásban lévő gyerek igénye függőben marad, de most esedékesnek nem számít:
+ * a dialógus bezárásakor a feltárt terület (vagy a takarás megszűnése) hozza elő. Így nyitott dialógus
+ * mellett nem fut üres képkocka minden ciklusban.
  */
 bool UIScreen::isRedrawNeeded() const {
 
     // Alapképernyő újrarajzolási igény ellenőrzése
-    if (UIContainerComponent::isRedrawNeeded()) {
+    if (UIComponent::isRedrawNeeded() || !exposedRegion.isEmpty()) {
         return true;
     }
+    for (const auto &child : children) {
+        if (child->isRedrawNeeded() && !isOccludedByDialog(child->getBounds())) {
+            return true;
+        }
+    }
 
     // Aktív dialógus újrarajzolási igény ellenőrzése
     if (isDialogActive()) {
@@ -75,8 +83,13 @@ void UIScreen::drawSelf() {
  * A draw metódus implementálja a layered dialog rendszer vizuális megjelenítését.
  *
  * Rajzolási sorrend (alulról felfelé):
- * 1. **Alapképernyő komponensek**: UIContainerComponent::draw() - gombok, szövegek, stb.
- * 2. **Rétegzett dialógusok**: Összes aktív dialógus a stack sorrendjében
+ * 1. **Feltárt területek**: háttér + képernyő tartalom vágással, az érintett komponensek megjelölése
+ * 2. **Alapképernyő komponensek**: gombok, szövegek, stb. - ami egy dialógus alatt teljesen takarásban van,
+ *    az kimarad (újrarajzolási igénye függőben marad, az isRedrawNeeded() nem jelzi; a dialógus bezárásakor
+ *    a feltárt területtel pótlódik)
+ * 3. **Felülírt dialógus területek**: ha egy komponens dialógus alatt rajzolt, a fátyol és a dialógusok
+ *    csak az ő területén rajzolódnak újra (vágással)
+ * 4. **Rétegzett dialógusok**: Összes aktív dialógus a stack sorrendjében
  *
  * A rétegzési logika:
  * - A stack első eleme (index 0) = legalsó réteg
@@ -86,26 +99,118 @@ void UIScreen::drawSelf() {
  */
 void UIScreen::draw() {
 
+    // A közvetlen rajzolás előtt az előző DMA kitolásnak be kell fejeződnie (a komponensek között is)
+    tftDma.fence();
+
     // ===============================
-    // 1. Alapképernyő komponensek rajzolása (alsó réteg)
+    // 1. Feltárt területek helyreállítása
     // ===============================
-    UIContainerComponent::draw(); // Gombok, szövegek, egyéb UI elemek
+    repairExposedRegion();
 
     // ===============================
-    // 2. Rétegzett dialógusok rajzolása (felső rétegek)
+    // 2. Alapképernyő komponensek rajzolása (alsó réteg)
     // ===============================
-    if (!dialogStack.empty()) {
+    if (UIComponent::isRedrawNeeded()) {
+        drawSelf();
+        UIComponent::needsRedraw = false;
+    }
+    for (auto &child : children) {
+        if (!child->isRedrawNeeded()) {
+            continue;
+        }
 
-        // Összes látható dialógus kirajzolása stack sorrendjében (alulról felfelé)
-        int dialogCount = 0;
+        const Rect &childBounds = child->getBounds();
+        if (isOccludedByDialog(childBounds)) {
+            continue; // Nem látszana: a dialógus bezárásakor rajzolódik ki
+        }
+
+        tftDma.fence();
+        {
+            UI_PROFILE_COMPONENT(child.get());
+            child->draw();
+        }
+        if (isDialogActive()) {
+            overlayRegion.add(childBounds); // A fátyol (és az átfedő dialógus) felülíródott
+        }
+    }
+
+    // ===============================
+    // 3-4. Rétegzett dialógusok rajzolása (felső rétegek)
+    // ===============================
+    tftDma.fence();
+    repairDialogOverlays();
+    for (auto &weakDialog : dialogStack) {
+        auto dialog = weakDialog.lock();
+        if (dialog) {
+            tftDma.fence();
+            UI_PROFILE_COMPONENT(dialog.get());
+            dialog->draw();
+        }
+    }
+}
+
+/**
+ * @brief Képernyő terület érvénytelenítése
+ */
+void UIScreen::invalidateRect(const Rect &area) { exposedRegion.add(area); }
+
+/**
+ * @brief Teljesen letakarja-e valamelyik dialógus (az árnyékával együtt) a területet
+ */
+bool UIScreen::isOccludedByDialog(const Rect &area) const {
+    for (const auto &weakDialog : dialogStack) {
+        auto dialog = weakDialog.lock();
+        if (dialog && dialog->getFootprint().contains(area)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief A feltárt területek helyreállítása
+ * @details A háttér törlése és a képernyő saját tartalma (drawContent()) a területre vágva rajzolódik. Az érintett
+ * komponensek teljesen újrarajzolódnak (a 2. lépésben), mert a belső állapotuk (pl. a FreqDisplay glyph cache-e)
+ * a teljes területükre vonatkozik. Aktív dialógus mellett a terület a fátyol és a dialógusok helyreállítására is kerül.
+ */
+void UIScreen::repairExposedRegion() {
+    for (uint8_t i = 0; i < exposedRegion.getCount(); i++) {
+        const Rect &area = exposedRegion.getRect(i);
+
+        tft.setViewport(area.x, area.y, area.width, area.height, false);
+        tft.fillRect(area.x, area.y, area.width, area.height, TFT_BLACK);
+        drawContent();
+        tft.resetViewport();
+
+        for (auto &child : children) {
+            if (child && child->getBounds().intersects(area)) {
+                child->markForRedraw();
+            }
+        }
+        if (isDialogActive()) {
+            overlayRegion.add(area);
+        }
+    }
+    exposedRegion.clear();
+}
+
+/**
+ * @brief A felülírt területeken a fátyol és a dialógusok újrarajzolása, stack sorrendben, a területre vágva
+ */
+void UIScreen::repairDialogOverlays() {
+    for (uint8_t i = 0; i < overlayRegion.getCount(); i++) {
+        const Rect &area = overlayRegion.getRect(i);
+
+        tft.setViewport(area.x, area.y, area.width, area.height, false);
         for (auto &weakDialog : dialogStack) {
             auto dialog = weakDialog.lock();
             if (dialog) {
-                dialog->draw();
-                dialogCount++;
+                dialog->repairArea(area);
             }
         }
+        tft.resetViewport();
     }
+    overlayRegion.clear();
 }
 
 /**
@@ -259,7 +364,8 @@ void UIScreen::showDialog(std::shared_ptr<UIDialogBase> dialog) {
  * 1. **Dialog Stack Cleanup**: A bezárt dialógus eltávolítása mindkét stack-ből
  * 2. **Navigation Logic**: Visszatérés az előző dialógushoz vagy a főképernyőhöz
  * 3. **Memory Management**: Automatikus shared_ptr cleanup
- * 4. **Visual Refresh**: Teljes képernyő újrarajzolás a tiszta megjelenéshez
+ * 4. **Visual Refresh**: A feltárt terület érvénytelenítése - a következő draw() csak azt rajzolja újra
+ *    (az utolsó dialógus fátyla után a teljes képernyőt, egymásra nyitott dialógusoknál a bezárt helyét)
  *
  * Navigation logika:
  * - Ha ez volt az utolsó dialógus → visszatérés a főképernyőhöz
@@ -269,6 +375,9 @@ void UIScreen::showDialog(std::shared_ptr<UIDialogBase> dialog) {
  */
 void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
 
+    // A dialógus a stack-ből törléskor felszabadulhat, ezért a területét előre eltesszük
+    Rect closedFootprint = closedDialog ? closedDialog->getFootprint() : Rect(0, 0, UIComponent::SCREEN_W, UIComponent::SCREEN_H);
+
     // ===============================
     // 1. Aktuális dialógus referencia cleanup
     // ===============================
@@ -321,22 +430,9 @@ void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
         // 4A. UTOLSÓ DIALÓGUS BEZÁRVA - Visszatérés főképernyőhöz
         // ===========================================
 
-        // Teljes képernyő törlése - tiszta újrakezdés
-        tft.fillScreen(TFT_BLACK);
-
-        // Saját újrarajzolási flag beállítása
-        markForRedraw();
-
-        // Összes gyerek komponens újrarajzolási flag beállítása
-        for (auto &child : children) {
-            if (child) {
-                auto uiComponent = std::static_pointer_cast<UIComponent>(child);
-                uiComponent->markForRedraw();
-            }
-        }
-
-        // Azonnali teljes újrarajzolás
-        draw();
+        // A fátyol a teljes képernyőt lefedte: minden feltárul (a következő draw() törli és rajzolja újra,
+        // az addig kért további frissítésekkel - pl. gombsor - együtt)
+        invalidateRect(Rect(0, 0, UIComponent::SCREEN_W, UIComponent::SCREEN_H));
 
     } else {
         // ===========================================
@@ -345,34 +441,20 @@ void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
         auto topDialog = dialogStack.back().lock();
         if (topDialog) {
 
-            // Teljes képernyő törlése - tiszta rétegzett újrakezdés
-            tft.fillScreen(TFT_BLACK);
-
             // Előző dialógus reaktiválása
             topDialog->setTopDialog(true);
-            topDialog->resetVeilDrawnFlag(); // Fátyol újrarajzolásának engedélyezése
-            topDialog->markForRedraw();
             currentDialog = topDialog;
 
-            // Alapképernyő komponenseinek újrarajzolási flag beállítása
-            markForRedraw();
-            for (auto &child : children) {
-                if (child) {
-                    auto uiComponent = std::static_pointer_cast<UIComponent>(child);
-                    uiComponent->markForRedraw();
-                }
-            }
-
-            // Összes maradék dialógus újrarajzolási flag beállítása
+            // A fátyol minden dialógusnál ugyanazokra a pixelekre esik, így a maradó dialógusokon kívül csak a
+            // bezárt dialógus helye változott: ott feltárul a képernyő, a maradó dialógusokon pedig a bezárt
+            // dialógus fátyla látszik (ha alatta voltak), ezért azok újrarajzolódnak
+            invalidateRect(closedFootprint);
             for (auto &weakDialog : dialogStack) {
                 auto dialog = weakDialog.lock();
                 if (dialog) {
-                    dialog->markForRedraw();
+                    overlayRegion.add(dialog->getFootprint());
                 }
             }
-
-            // Teljes rétegzett újrarajzolás - alap képernyő + összes dialógus
-            draw(); // Ez rajzolja az alap képernyőt + összes dialógust
         } else {
             DEBUG("UIScreen::onDialogClosed() - ERROR: Previous dialog pointer is null!\n");
         }
@@ -382,8 +464,8 @@ void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
 /**
  * @brief Dialógus cleanup végrehajtása rajzolás nélkül
  * @param closedDialog A bezárt dialógus pointer
- * @details Lemásolja az onDialogClosed logikáját, de kihagyja a draw() hívásokat.
- * Hasznos olyan esetekben, amikor a leszármazott osztály egyedi rajzolási logikát szeretne.
+ * @details Lemásolja az onDialogClosed logikáját, de a maradó dialógusoktól függetlenül a teljes képernyőt
+ * érvényteleníti. Hasznos olyan esetekben, amikor a leszármazott osztály egyedi rajzolási logikát szeretne.
  */
 void UIScreen::performDialogCleanupWithoutDraw(UIDialogBase *closedDialog) {
 
@@ -434,19 +516,8 @@ void UIScreen::performDialogCleanupWithoutDraw(UIDialogBase *closedDialog) {
     // 4. Screen cleanup - készítjük elő a rajzoláshoz
     // ===============================
 
-    // Teljes képernyő törlése - tiszta újrakezdés
-    tft.fillScreen(TFT_BLACK);
-
-    // Saját újrarajzolási flag beállítása
-    markForRedraw();
-
-    // Összes gyerek komponens újrarajzolási flag beállítása
-    for (auto &child : children) {
-        if (child) {
-            auto uiComponent = std::static_pointer_cast<UIComponent>(child);
-            uiComponent->markForRedraw();
-        }
-    }
+    // Teljes képernyő érvénytelenítése - tiszta újrakezdés a következő draw()-ban
+    invalidateRect(Rect(0, 0, UIComponent::SCREEN_W, UIComponent::SCREEN_H));
 
     // FONTOS: Itt NEM hívjuk a draw()-t, azt a hívó osztály fogja megtenni
 }
\ No newline at end of file
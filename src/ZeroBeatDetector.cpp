@@ -0,0 +1,217 @@
+/**
+ * @file ZeroBeatDetector.cpp
+ * @brief Zero-beat detektor implementáció
+ */
+
+#include "ZeroBeatDetector.h"
+
+#include <algorithm>
+#include <new>
+
+/**
+ * @brief Konstruktor - a pufferek lefoglalása (a mintavételezőre az attach() csatlakoztat)
+ */
+ZeroBeatDetector::ZeroBeatDetector()
+    : fft(FFT_SIZE), window(FFT_SIZE), frames(FFT_SIZE), fftInput(nullptr), magnitudes(nullptr), targetFrequencyHz(0), sampleRate(0), toneFrequencyHz(0.0f),
+      lastToneTime(0), lastSequence(0), blockConsumer(AudioCapture::INVALID_CONSUMER), lastReportedTone(false), lastReportedOffset(0) {
+
+    fftInput = new (std::nothrow) int16_t[FFT_SIZE];
+    magnitudes = new (std::nothrow) uint16_t[FFT_SIZE / 2];
+    if (!isAvailable()) {
+        DEBUG("ZeroBeatDetector: memória foglalás sikertelen\n");
+        return;
+    }
+    window.configure(AudioWindow::Type::Hann, FFT_SIZE);
+}
+
+/**
+ * @brief Destruktor
+ */
+ZeroBeatDetector::~ZeroBeatDetector() {
+    detach();
+    delete[] fftInput;
+    delete[] magnitudes;
+}
+
+/**
+ * @brief Sikerült-e minden puffer lefoglalása
+ */
+bool ZeroBeatDetector::isAvailable() const { return fft.isAvailable() && window.isAvailable() && frames.isAvailable() && fftInput && magnitudes; }
+
+/**
+ * @brief A célhang beállítása
+ */
+void ZeroBeatDetector::setTargetFrequency(uint16_t frequencyHz) {
+    if (frequencyHz != targetFrequencyHz) {
+        targetFrequencyHz = frequencyHz;
+        reset();
+    }
+}
+
+/**
+ * @brief A becslés és a keretező törlése
+ */
+void ZeroBeatDetector::reset() {
+    frames.reset();
+    toneFrequencyHz = 0.0f;
+}
+
+/**
+ * @brief Csatlakozás a mintavételezőre blokk fogyasztóként
+ */
+bool ZeroBeatDetector::attach() {
+    if (isAttached()) {
+        return true;
+    }
+    if (!isAvailable()) {
+        return false;
+    }
+    blockConsumer = audioCapture.registerConsumer();
+    if (blockConsumer == AudioCapture::INVALID_CONSUMER) {
+        DEBUG("ZeroBeatDetector: nincs szabad blokk fogyasztó hely\n");
+        return false;
+    }
+    reset();
+    return true;
+}
+
+/**
+ * @brief Leválás a mintavételezőről (az író átvételét az unregisterConsumer() megvárja)
+ */
+void ZeroBeatDetector::detach() {
+    if (!isAttached()) {
+        return;
+    }
+    audioCapture.unregisterConsumer(blockConsumer);
+    blockConsumer = AudioCapture::INVALID_CONSUMER;
+    reset();
+}
+
+/**
+ * @brief A várakozó blokkok feldolgozása
+ */
+bool ZeroBeatDetector::update() {
+    if (!isAttached()) {
+        return false;
+    }
+
+    const AudioBlock *block;
+    while ((block = audioCapture.peekBlock(blockConsumer)) != nullptr) {
+
+        // Kimaradt blokk után a keret már nem folytonos (a becslés megmarad)
+        if (block->sequence != lastSequence + 1) {
+            frames.reset();
+        }
+        lastSequence = block->sequence;
+
+        processSamples(block->samples, AUDIO_CAPTURE_BLOCK_SIZE, block->sampleRate);
+        audioCapture.releaseBlock(blockConsumer);
+    }
+
+    bool tone = hasTone();
+    int16_t offset = tone ? getOffsetHz() : 0;
+    if (tone == lastReportedTone && offset == lastReportedOffset) {
+        return false;
+    }
+    lastReportedTone = tone;
+    lastReportedOffset = offset;
+    return true;
+}
+
+/**
+ * @brief Minták feldolgozása: keretezés, és minden kész keretnél csúcs becslés és simítás
+ * @details A minták legfeljebb fél keretenként kerülnek a keretezőbe, így hosszabb bemenetnél sem marad ki keret.
+ */
+void ZeroBeatDetector::processSamples(const int16_t *samples, uint16_t count, uint32_t newSampleRate) {
+    if (!isAvailable() || newSampleRate == 0) {
+        return;
+    }
+    if (newSampleRate != sampleRate) {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    const float binHz = static_cast<float>(sampleRate) / FFT_SIZE;
+    uint16_t offset = 0;
+    while (offset < count) {
+        uint16_t chunk = std::min<uint16_t>(count - offset, FFT_SIZE / 2);
+        frames.write(samples + offset, chunk);
+        offset += chunk;
+
+        if (!frames.isFrameReady()) {
+            continue;
+        }
+
+        float peakFrequencyHz;
+        if (!analyzeFrame(peakFrequencyHz)) {
+            continue;
+        }
+
+        // Nagy ugrásnál (új állomás, átállított BFO) nem simítunk, hogy az új hangot azonnal kövessük
+        if (toneFrequencyHz == 0.0f || fabsf(peakFrequencyHz - toneFrequencyHz) > MAX_TRACKING_STEP_BINS * binHz) {
+            toneFrequencyHz = peakFrequencyHz;
+        } else {
+            toneFrequencyHz += (peakFrequencyHz - toneFrequencyHz) / (1 << SMOOTHING_SHIFT);
+        }
+        lastToneTime = millis();
+    }
+}
+
+/**
+ * @brief Egy kész keret elemzése
+ * @param peakFrequencyHz A domináns hang frekvenciája (csak true visszatérésnél)
+ * @return true, ha a keresési tartományban elég erős csúcs van
+ * @details A Hann ablakos szinusz főhurka közel Gauss alakú, ezért a log magnitúdókra illesztett parabola
+ * csúcsa (delta = (ln a - ln c) / (2 * (ln a - 2 ln b + ln c))) a bin rács közötti helyet is jól közelíti.
+ */
+bool ZeroBeatDetector::analyzeFrame(float &peakFrequencyHz) {
+    window.apply(frames.getFrame(), fftInput);
+    frames.consumeFrame();
+    if (!fft.computeMagnitudes(fftInput, FFT_SIZE, magnitudes)) {
+        return false;
+    }
+
+    const float binHz = static_cast<float>(sampleRate) / FFT_SIZE;
+    int32_t firstBin = static_cast<int32_t>((static_cast<int32_t>(targetFrequencyHz) - SEARCH_SPAN_HZ) / binHz);
+    int32_t lastBin = static_cast<int32_t>((static_cast<int32_t>(targetFrequencyHz) + SEARCH_SPAN_HZ) / binHz) + 1;
+    firstBin = std::max<int32_t>(firstBin, 2); // Az egyenáramú komponens és a szomszédja kimarad
+    lastBin = std::min<int32_t>(lastBin, FFT_SIZE / 2 - 2);
+    if (lastBin <= firstBin) {
+        return false;
+    }
+
+    uint16_t peakBin = firstBin;
+    uint32_t sum = 0;
+    for (int32_t k = firstBin; k <= lastBin; k++) {
+        sum += magnitudes[k];
+        if (magnitudes[k] > magnitudes[peakBin]) {
+            peakBin = k;
+        }
+    }
+
+    uint32_t peak = magnitudes[peakBin];
+    uint32_t average = sum / (lastBin - firstBin + 1);
+    if (peak < MIN_PEAK_MAGNITUDE || peak < average * PEAK_TO_AVERAGE_RATIO) {
+        return false;
+    }
+
+    float a = logf(std::max<uint16_t>(magnitudes[peakBin - 1], 1));
+    float b = logf(peak);
+    float c = logf(std::max<uint16_t>(magnitudes[peakBin + 1], 1));
+    float curvature = a - 2.0f * b + c;
+    float delta = curvature < 0.0f ? 0.5f * (a - c) / curvature : 0.0f;
+    delta = constrain(delta, -0.5f, 0.5f);
+
+    peakFrequencyHz = (peakBin + delta) * binHz;
+    return true;
+}
+
+/**
+ * @brief Van-e érvényes (nem elavult) hang becslés
+ */
+bool ZeroBeatDetector::hasTone() const { return toneFrequencyHz > 0.0f && millis() - lastToneTime < HOLD_MS; }
+
+/**
+ * @brief A hang eltérése a célhangtól
+ */
+int16_t ZeroBeatDetector::getOffsetHz() const { return static_cast<int16_t>(lroundf(toneFrequencyHz - targetFrequencyHz)); }
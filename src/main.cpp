@@ -6,11 +6,13 @@
 
 #include <Arduino.h>
 
+#include "AudioCapture.h"
 #include "PicoMemoryInfo.h"
 #include "PicoSensorUtils.h"
 #include "ScreenManager.h"
 #include "SplashScreen.h"
 #include "UIComponent.h"
+#include "UIProfiler.h"
 #include "defines.h"
 #include "pins.h"
 #include "utils.h"
@@ -19,6 +21,7 @@
 #include "BandStore.h"
 #include "Config.h"
 #include "EepromLayout.h"
+#include "ScanSnapshotStore.h"
 #include "StationStore.h"
 #include "StoreEepromBase.h"
 extern Config config;
@@ -30,6 +33,12 @@ extern BandStore bandStore;
 #include <TFT_eSPI.h>
 TFT_eSPI tft;
 
+#include "SpritePool.h"
+SpritePool spritePool(tft); // Tartós sprite pool a komponensek rajzolásához
+
+#include "TftDma.h"
+TftDma tftDma(tft); // DMA-s sprite/téglalap kitolás, képkocka és input-to-photon mérés
+
 //-------------------- Screens
 // Globális képernyőkezelő pointer - inicializálás a setup()-ban történik
 ScreenManager *screenManager = nullptr;
@@ -74,6 +83,7 @@ void setup() {
     tft.init();
     tft.setRotation(1);
     tft.fillScreen(TFT_BLACK); // Fekete háttér a splash screen-hez
+    tftDma.begin();
 
     // UI komponensek számára képernyő méretek inicializálása
     UIComponent::initScreenDimensions(tft);
@@ -123,6 +133,9 @@ void setup() {
             fmStationStore.loadDefaults();
             amStationStore.loadDefaults();
             bandStore.loadDefaults();
+#ifdef SCAN_SNAPSHOT_PERSIST
+            scanSnapshotStore.loadDefaults();
+#endif
 
             DEBUG("Save default settings...\n");
             Utils::beepTick();
@@ -130,6 +143,9 @@ void setup() {
             bandStore.checkSave(); // Band adatok mentése
             fmStationStore.checkSave();
             amStationStore.checkSave();
+#ifdef SCAN_SNAPSHOT_PERSIST
+            scanSnapshotStore.checkSave();
+#endif
 
             Utils::beepTick();
             DEBUG("Default settings resored!\n");
@@ -158,6 +174,9 @@ void setup() {
     bandStore.load(); // Band adatok betöltése
     fmStationStore.load();
     amStationStore.load();
+#ifdef SCAN_SNAPSHOT_PERSIST
+    scanSnapshotStore.load();
+#endif
 
     // Splash screen megjelenítése inicializálás közben
     // Most átváltunk a teljes splash screen-re az SI4735 infókkal
@@ -249,6 +268,25 @@ void setup() {
  * @details Ez a függvény folyamatosan fut, és kezeli a program fő logikáját.
  */
 void loop() {
+//------------------- Profilozó: kiírás és overlay (a mért loop menetén kívül)
+#ifdef UI_PROFILER
+    static uint32_t lastProfilerDump = 0;
+    if (millis() - lastProfilerDump >= UI_PROFILER_DUMP_INTERVAL) {
+        uiProfiler.dump();
+        uiProfiler.reset();
+        lastProfilerDump = millis();
+    }
+#ifdef UI_PROFILER_OVERLAY
+    static uint32_t lastProfilerOverlay = 0;
+    if (millis() - lastProfilerOverlay >= UI_PROFILER_OVERLAY_INTERVAL) {
+        tftDma.fence();
+        uiProfiler.drawOverlay(tft);
+        lastProfilerOverlay = millis();
+    }
+#endif
+#endif
+    UI_PROFILE_SCOPE(LoopIteration);
+
     //------------------- EEPROM mentés figyelése
 #define EEPROM_SAVE_CHECK_INTERVAL 1000 * 60 * 5 // 5 perc
     static uint32_t lastEepromSaveCheck = 0;
@@ -257,6 +295,9 @@ void loop() {
         bandStore.checkSave(); // Band adatok mentése
         fmStationStore.checkSave();
         amStationStore.checkSave();
+#ifdef SCAN_SNAPSHOT_PERSIST
+        scanSnapshotStore.checkSave(); // Legutóbbi scan snapshot (CRC változás esetén)
+#endif
         lastEepromSaveCheck = millis();
     }
 //------------------- Memória információk megjelenítése
@@ -267,9 +308,17 @@ void loop() {
         lasDebugMemoryInfo = millis();
     }
 #endif
+#ifdef SHOW_RENDER_METRICS
+    static uint32_t lastRenderMetrics = 0;
+    if (millis() - lastRenderMetrics >= RENDER_METRICS_INTERVAL) {
+        tftDma.debugMetrics();
+        lastRenderMetrics = millis();
+    }
+#endif
 
     //------------------- Touch esemény kezelése
     uint16_t touchX, touchY;
+    tftDma.fence(); // A touch vezérlő ugyanazon az SPI buszon van
     bool touchedRaw = tft.getTouch(&touchX, &touchY);
     bool validCoordinates = true;
     if (touchedRaw) {
@@ -350,8 +399,23 @@ void loop() {
         lastDrawTime = millis();
     }
 
-    // SI4735 loop hívása, squelch és hardver némítás kezelése
+    // SI4735 loop hívása, squelch és hardver némítás kezelése (a képkocka utolsó DMA kitolása alatt)
     if (si4735Manager) {
         si4735Manager->loop();
     }
+
+    // A kitolás befejezésének észlelése (képkocka idő, input-to-photon mérés)
+    tftDma.poll();
 }
+
+/**
+ * @brief Core1 inicializálás
+ * @details A core1 az audio mintavételezés ADC/DMA kezelését végzi, a DMA megszakítás is itt fut.
+ */
+void setup1() { audioCapture.setupCore1(); }
+
+/**
+ * @brief Core1 loop függvény
+ * @details A core0 felől érkező indítás/leállítás kérések alkalmazása, mintavételi statisztika.
+ */
+void loop1() { audioCapture.loopCore1(); }
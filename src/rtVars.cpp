@@ -44,4 +44,7 @@ bool SEEK = false;
 // CW shift
 bool CWShift = false;
 
+// RTTY dekóder
+uint8_t rttyDecoderMode = 0; // Kikapcsolva
+
 } // namespace rtv
\ No newline at end of file